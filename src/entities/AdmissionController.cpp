@@ -0,0 +1,116 @@
+#include "entities/AdmissionController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace entities {
+
+namespace {
+
+// Weight of a new service time in its moving average, as 1/2^SHIFT
+constexpr int SERVICE_TIME_SHIFT = 3;
+
+}  // namespace
+
+std::chrono::nanoseconds AdmissionController::predictedLatency(
+    std::size_t pending, std::size_t threads) const {
+  auto service = serviceNanos.load(std::memory_order_relaxed);
+  auto queued = pending / std::max<std::size_t>(threads, 1);
+  return std::chrono::nanoseconds{static_cast<std::int64_t>(queued + 1) *
+                                  service};
+}
+
+bool AdmissionController::admit(std::size_t pending, std::size_t threads) {
+  if (pending == 0) {
+    if (dropping.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      dropping.store(false, std::memory_order_relaxed);
+      firstAboveTime = {};
+    }
+    admittedCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  if (dropping.load(std::memory_order_relaxed) or
+      predictedLatency(pending, threads) > settings.latencyObjective) {
+    rejectedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  admittedCount.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+AdmissionController::clock_t::time_point AdmissionController::controlLaw(
+    clock_t::time_point t, std::uint32_t drops) const {
+  auto spacing = settings.interval.count() / std::sqrt(double(drops));
+  return t + std::chrono::nanoseconds{static_cast<std::int64_t>(spacing)};
+}
+
+// RFC 8289 dequeue, where dropping a packet is shedding a task
+bool AdmissionController::onDequeue(std::chrono::nanoseconds queueDelay,
+                                    clock_t::time_point now) {
+  queueDelayNanos.store(queueDelay.count(), std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(mutex);
+  bool okToDrop = false;
+  if (queueDelay < settings.target) {
+    firstAboveTime = {};
+  } else if (firstAboveTime == clock_t::time_point{}) {
+    firstAboveTime = now + settings.interval;
+  } else if (now >= firstAboveTime) {
+    okToDrop = true;
+  }
+
+  bool shed = false;
+  if (dropping.load(std::memory_order_relaxed)) {
+    if (not okToDrop) {
+      dropping.store(false, std::memory_order_relaxed);
+    } else if (now >= dropNext) {
+      shed = true;
+      ++count;
+      dropNext = controlLaw(dropNext, count);
+    }
+  } else if (okToDrop) {
+    shed = true;
+    dropping.store(true, std::memory_order_relaxed);
+    // Shedding resumes at the rate it had, when it stopped shortly ago
+    auto delta = count - lastCount;
+    count = delta > 1 and now - dropNext < 16 * settings.interval ? delta : 1;
+    dropNext = controlLaw(now, count);
+    lastCount = count;
+  }
+  if (shed) {
+    shedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  return shed;
+}
+
+void AdmissionController::onComplete(std::chrono::nanoseconds serviceTime) {
+  auto average = serviceNanos.load(std::memory_order_relaxed);
+  if (average == 0) {
+    average = serviceTime.count();
+  } else {
+    average += (serviceTime.count() - average) >> SERVICE_TIME_SHIFT;
+  }
+  serviceNanos.store(average, std::memory_order_relaxed);
+}
+
+std::chrono::seconds AdmissionController::retryAfter(
+    std::size_t pending, std::size_t threads) const {
+  auto drain = std::chrono::ceil<std::chrono::seconds>(
+      predictedLatency(pending, threads));
+  return std::max(drain, std::chrono::seconds{1});
+}
+
+AdmissionState AdmissionController::state() const {
+  AdmissionState state;
+  state.dropping = dropping.load(std::memory_order_relaxed);
+  state.admitted = admittedCount.load(std::memory_order_relaxed);
+  state.rejected = rejectedCount.load(std::memory_order_relaxed);
+  state.shed = shedCount.load(std::memory_order_relaxed);
+  state.queueDelay = std::chrono::nanoseconds{
+      queueDelayNanos.load(std::memory_order_relaxed)};
+  state.serviceTime =
+      std::chrono::nanoseconds{serviceNanos.load(std::memory_order_relaxed)};
+  return state;
+}
+
+}  // namespace entities
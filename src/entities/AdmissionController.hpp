@@ -0,0 +1,95 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_ADMISSION__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_ADMISSION__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace entities {
+
+struct AdmissionSettings {
+  // Time in queue CoDel lets a standing queue have
+  std::chrono::nanoseconds target{std::chrono::milliseconds{5}};
+  // Time the queue may stay above target before tasks are shed, and base of
+  // the spacing between two sheds
+  std::chrono::nanoseconds interval{std::chrono::milliseconds{100}};
+  // Latency a request must not be predicted to exceed to be admitted
+  std::chrono::nanoseconds latencyObjective{std::chrono::milliseconds{200}};
+};
+
+struct AdmissionState {
+  bool dropping{false};
+  std::uint64_t admitted{0};
+  std::uint64_t rejected{0};
+  std::uint64_t shed{0};
+  // Of the last task that left the queue
+  std::chrono::nanoseconds queueDelay{0};
+  // Moving average of the time a task runs on a worker
+  std::chrono::nanoseconds serviceTime{0};
+};
+
+// Overload control on the worker queue, driven by the time tasks wait in it
+// rather than by CPU usage. Tasks leaving the queue are shed as CoDel drops
+// packets (RFC 8289): once their time in queue has stayed above target for
+// a whole interval, one is shed, then others at intervals shrinking with
+// the square root of the sheds, until a task waits less than target. New
+// requests are rejected while tasks are shed, or when the tasks already
+// queued and the average time of a task predict a latency above the
+// objective, so they are answered before the objective is breached.
+// A request finding the queue empty is always admitted, and ends the
+// shedding: with nothing queued there is no task left to end it, and
+// nothing to predict a latency from but the request itself
+class AdmissionController final {
+ public:
+  using clock_t = std::chrono::steady_clock;
+
+  explicit AdmissionController(const AdmissionSettings &settings)
+      : settings{settings} {}
+  AdmissionController(const AdmissionController &) = delete;
+  ~AdmissionController() = default;
+
+  // I/O thread, for each request before it is queued
+  bool admit(std::size_t pending, std::size_t threads);
+  // Worker, for each task leaving the queue. Returns whether it is shed
+  // instead of run
+  bool onDequeue(std::chrono::nanoseconds queueDelay, clock_t::time_point);
+  // Worker, once a task has run. The average is kept by task, as the queue
+  // the latency is predicted from holds tasks, whatever changes they carry
+  void onComplete(std::chrono::nanoseconds serviceTime);
+
+  // Time the queue is expected to take to drain, one second at least
+  std::chrono::seconds retryAfter(std::size_t pending,
+                                  std::size_t threads) const;
+
+  AdmissionState state() const;
+  inline const AdmissionSettings &getSettings() const { return settings; }
+
+ private:
+  std::chrono::nanoseconds predictedLatency(std::size_t pending,
+                                            std::size_t threads) const;
+  clock_t::time_point controlLaw(clock_t::time_point, std::uint32_t) const;
+
+  const AdmissionSettings settings;
+
+  // CoDel state, updated by the workers one at a time
+  std::mutex mutex;
+  // When the queue delay will have been above target for an interval. The
+  // epoch when it is below target
+  clock_t::time_point firstAboveTime{};
+  clock_t::time_point dropNext{};
+  std::uint32_t count{0};
+  std::uint32_t lastCount{0};
+
+  std::atomic<bool> dropping{false};
+  std::atomic<std::int64_t> queueDelayNanos{0};
+  std::atomic<std::int64_t> serviceNanos{0};
+  std::atomic<std::uint64_t> admittedCount{0};
+  std::atomic<std::uint64_t> rejectedCount{0};
+  std::atomic<std::uint64_t> shedCount{0};
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_ADMISSION__
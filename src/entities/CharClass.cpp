@@ -0,0 +1,122 @@
+#include "entities/CharClass.hpp"
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace entities {
+namespace charclass {
+
+namespace {
+
+inline bool isDigit(char c) {
+  return static_cast<unsigned char>(c - '0') < 10;
+}
+
+inline bool isHexDigit(char c) {
+  return isDigit(c) or static_cast<unsigned char>((c | 0x20) - 'a') < 6;
+}
+
+// Bytes over 0x7f are negative as signed chars, so they fall out of every
+// range below: no ASCII range check needs an unsigned compare. Letters are
+// folded to lower case by setting bit 0x20, which maps no other byte into
+// 'a'-'f'
+#if defined(__SSE2__)
+inline __m128i inRange(__m128i c, char lo, char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(lo - 1)),
+                       _mm_cmplt_epi8(c, _mm_set1_epi8(hi + 1)));
+}
+
+inline __m128i digitMask(__m128i c) { return inRange(c, '0', '9'); }
+
+inline __m128i hexMask(__m128i c) {
+  return _mm_or_si128(digitMask(c),
+                      inRange(_mm_or_si128(c, _mm_set1_epi8(0x20)), 'a', 'f'));
+}
+#endif
+
+#if defined(__AVX2__)
+inline __m256i inRange(__m256i c, char lo, char hi) {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8(lo - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), c));
+}
+
+inline __m256i digitMask(__m256i c) { return inRange(c, '0', '9'); }
+
+inline __m256i hexMask(__m256i c) {
+  return _mm256_or_si256(
+      digitMask(c),
+      inRange(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), 'a', 'f'));
+}
+#endif
+
+template <bool HEX>
+bool allOf(std::string_view str) {
+  const char* data = str.data();
+  std::size_t size = str.size();
+  std::size_t i = 0;
+
+#if defined(__AVX2__)
+  for (; i + sizeof(__m256i) <= size; i += sizeof(__m256i)) {
+    auto c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    if (_mm256_movemask_epi8(HEX ? hexMask(c) : digitMask(c)) != -1) {
+      return false;
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + sizeof(__m128i) <= size; i += sizeof(__m128i)) {
+    auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    if (_mm_movemask_epi8(HEX ? hexMask(c) : digitMask(c)) != 0xFFFF) {
+      return false;
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    if (not(HEX ? isHexDigit(data[i]) : isDigit(data[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool isHex(std::string_view str) { return allOf<true>(str); }
+
+bool isDigits(std::string_view str) { return allOf<false>(str); }
+
+std::optional<int> toBoundedInt(std::string_view str, int min, int max) {
+  if (str.empty()) {
+    return std::nullopt;
+  }
+  // Once over max, the value is not accumulated anymore, so it never
+  // overflows; the digits are still checked up to the end
+  std::int64_t value = 0;
+  for (auto c : str) {
+    if (not isDigit(c)) {
+      return std::nullopt;
+    }
+    if (value <= max) {
+      value = value * 10 + (c - '0');
+    }
+  }
+  if (value < min or value > max) {
+    return std::nullopt;
+  }
+  return static_cast<int>(value);
+}
+
+std::optional<int> toCanonicalInt(std::string_view str, int min, int max) {
+  if (str.size() > 1 and str.front() == '0') {
+    return std::nullopt;
+  }
+  return toBoundedInt(str, min, max);
+}
+
+}  // namespace charclass
+}  // namespace entities
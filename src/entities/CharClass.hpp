@@ -0,0 +1,38 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_CHAR_CLASS__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_CHAR_CLASS__
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace entities {
+namespace charclass {
+
+// Character class checks of the static data fields, in place of a full match
+// of the patterns declared in ValidationData.hpp. Strings are checked 32
+// (AVX2) or 16 (SSE2) bytes at a time when the build targets it, and byte by
+// byte otherwise. Any byte outside the class, a null one included, fails.
+
+// ^[A-Fa-f0-9]*$
+bool isHex(std::string_view);
+
+// ^[A-Fa-f0-9]{length}$
+inline bool isHex(std::string_view str, std::size_t length) {
+  return str.size() == length and isHex(str);
+}
+
+// ^[0-9]*$
+bool isDigits(std::string_view);
+
+// ^[0-9]+$ with a value in [min, max], parsed in the same pass. Leading zeros
+// are allowed, as std::stoi does, and any number of digits may be given:
+// values that do not fit in an int are just out of range. min is not negative
+std::optional<int> toBoundedInt(std::string_view, int min, int max);
+
+// Same, without leading zeros: "0" and "5" but not "00" or "05"
+std::optional<int> toCanonicalInt(std::string_view, int min, int max);
+
+}  // namespace charclass
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_CHAR_CLASS__
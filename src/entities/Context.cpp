@@ -1,14 +1,9 @@
 #include "Context.hpp"
 
-#include <boost/algorithm/string.hpp>
-#include <unordered_set>
+#include <algorithm>
 
 namespace entities {
 
-const std::unordered_set<std::string> TRACING_KEYS = {
-    "x-request-id", "x-b3-traceid", "x-b3-spanid",      "x-b3-parentspanid",
-    "x-b3-sampled", "x-b3-flags",   "x-ot-span-context"};
-
 void Context::update(const std::string& key, const std::string& value) {
   auto it = mTracingHeaders.find(key);
   if (it != mTracingHeaders.end()) {
@@ -22,18 +17,50 @@ const Context::contextdata_t& Context::getTracingHeaders() const {
   return mTracingHeaders;
 }
 
-bool Context::isTracingHeader(const std::string& headerKey) const {
-  return (TRACING_KEYS.find(boost::algorithm::to_lower_copy(headerKey)) !=
-          TRACING_KEYS.end());
+void Context::copyTracingHeaders(const Context::contextdata_t& headers) {
+  copyTracingHeaders(headers, [](const auto&, const auto&) {});
 }
 
-void Context::copyTracingHeaders(const Context::contextdata_t& headers) {
-  for (const auto& [key, value] : headers) {
-    if (isTracingHeader(key)) {
-      update(key, value);
+void Context::updateSpanContext() {
+  mSpanContext.reset();
+  std::optional<SpanContext> spanContext;
+  std::optional<std::uint64_t> parentSpanId;
+  bool sampled = true;
+  for (const auto& [key, value] : mTracingHeaders) {
+    switch (tracingKeyOf(key).value()) {
+      case TracingKey::TRACE_ID:
+        spanContext = traceIdOf(value);
+        break;
+      case TracingKey::SPAN_ID:
+        parentSpanId = spanIdOf(value);
+        break;
+      case TracingKey::SAMPLED:
+        sampled = value != "0" and value != "false";
+        break;
+      default:
+        break;
     }
   }
-  return;
+  if (spanContext and sampled) {
+    spanContext->parentSpanId = parentSpanId.value_or(0);
+    mSpanContext = spanContext;
+  }
+}
+
+void Context::recordSpan(Stage stage, std::chrono::nanoseconds elapsed) const {
+  if (not isTraced()) {
+    return;
+  }
+  auto end = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch());
+  auto duration = std::max(elapsed.count(), std::int64_t{0});
+  Span span;
+  span.context = *mSpanContext;
+  span.spanId = newSpanId();
+  span.startUnixNanos = static_cast<std::uint64_t>(end.count() - duration);
+  span.durationNanos = static_cast<std::uint64_t>(duration);
+  span.stage = stage;
+  mSpans->record(std::move(span));
 }
 
 }  // namespace entities
@@ -1,11 +1,90 @@
 #ifndef __AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_CONTEXT__
 #define __AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_CONTEXT__
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
+#include "entities/Tracing.hpp"
+
 namespace entities {
 
+// Headers kept in the context, in the order of TRACING_KEYS
+enum class TracingKey : std::uint8_t {
+  REQUEST_ID,
+  TRACE_ID,
+  SPAN_ID,
+  PARENT_SPAN_ID,
+  SAMPLED,
+  FLAGS,
+  OT_SPAN_CONTEXT
+};
+
+inline constexpr std::array<std::string_view, 7> TRACING_KEYS{
+    "x-request-id", "x-b3-traceid", "x-b3-spanid",      "x-b3-parentspanid",
+    "x-b3-sampled", "x-b3-flags",   "x-ot-span-context"};
+
+inline constexpr char toLowerAscii(char c) {
+  return c >= 'A' and c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Perfect hash of the tracing keys, from their size and their character at
+// TRACING_KEY_HASHED, so a header name is matched with one probe and one
+// comparison, whatever its case, and with no string built
+inline constexpr std::size_t TRACING_KEY_SLOTS = 8;
+inline constexpr std::size_t TRACING_KEY_HASHED = 8;
+inline constexpr std::size_t TRACING_KEY_MIN_SIZE = 10;
+inline constexpr std::size_t TRACING_KEY_MAX_SIZE = 17;
+
+inline constexpr std::size_t tracingKeySlot(std::string_view name) {
+  auto hashed = toLowerAscii(name[TRACING_KEY_HASHED]);
+  return (name.size() * 5 + static_cast<unsigned char>(hashed)) %
+         TRACING_KEY_SLOTS;
+}
+
+// Index in TRACING_KEYS of the key in each slot, TRACING_KEYS.size() when
+// the slot is empty. Keys sharing a slot do not compile
+inline constexpr auto TRACING_KEY_TABLE = [] {
+  std::array<std::size_t, TRACING_KEY_SLOTS> table{};
+  for (auto &slot : table) {
+    slot = TRACING_KEYS.size();
+  }
+  for (std::size_t i = 0; i < TRACING_KEYS.size(); ++i) {
+    auto &slot = table[tracingKeySlot(TRACING_KEYS[i])];
+    if (slot != TRACING_KEYS.size()) {
+      throw "tracing keys collide";
+    }
+    slot = i;
+  }
+  return table;
+}();
+
+inline std::optional<TracingKey> tracingKeyOf(std::string_view name) {
+  if (name.size() < TRACING_KEY_MIN_SIZE or
+      name.size() > TRACING_KEY_MAX_SIZE) {
+    return std::nullopt;
+  }
+  auto index = TRACING_KEY_TABLE[tracingKeySlot(name)];
+  if (index == TRACING_KEYS.size()) {
+    return std::nullopt;
+  }
+  auto key = TRACING_KEYS[index];
+  if (key.size() != name.size()) {
+    return std::nullopt;
+  }
+  for (std::size_t i = 0; i < key.size(); ++i) {
+    if (toLowerAscii(name[i]) != key[i]) {
+      return std::nullopt;
+    }
+  }
+  return static_cast<TracingKey>(index);
+}
+
 class Context final {
  public:
   using contextdata_t = std::unordered_multimap<std::string, std::string>;
@@ -14,12 +93,36 @@ class Context final {
   ~Context() = default;
 
   void copyTracingHeaders(const contextdata_t &);
+  // Same, handing every header over to each on the way, so that headers
+  // needed elsewhere are read in the same pass
+  template <typename Headers, typename Each>
+  void copyTracingHeaders(const Headers &headers, Each &&each) {
+    for (const auto &[key, value] : headers) {
+      each(key, value);
+      if (tracingKeyOf(key)) {
+        update(key, value);
+      }
+    }
+    updateSpanContext();
+  }
   const contextdata_t &getTracingHeaders() const;
 
+  // Spans of the request stages go to the ring, when the request carries a
+  // valid x-b3-traceid and is not unsampled (x-b3-sampled: 0)
+  inline void traceInto(SpanRing *spans) { mSpans = spans; }
+  inline bool isTraced() const { return mSpans and mSpanContext; }
+  inline const std::optional<SpanContext> &getSpanContext() const {
+    return mSpanContext;
+  }
+  // The stage is taken to have ended now
+  void recordSpan(Stage, std::chrono::nanoseconds elapsed) const;
+
  private:
-  bool isTracingHeader(const std::string &) const;
   void update(const std::string &, const std::string &);
+  void updateSpanContext();
   contextdata_t mTracingHeaders;
+  std::optional<SpanContext> mSpanContext;
+  SpanRing *mSpans{nullptr};
 };
 
 }  // namespace entities
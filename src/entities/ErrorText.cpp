@@ -0,0 +1,89 @@
+#include "entities/ErrorText.hpp"
+
+#include "entities/PathRoute.hpp"
+
+namespace entities {
+
+namespace {
+
+void appendField(std::string &out, std::string_view field,
+                 std::string_view text) {
+  out.append("Field:[").append(field).append(text);
+}
+
+}  // namespace
+
+void appendErrorDescription(const Error &error, std::string &out) {
+  switch (error.kind) {
+    case ErrorKind::TEXT:
+      out.append(error.field);
+      break;
+    case ErrorKind::OWNED_TEXT:
+      out.append(error.text);
+      break;
+    case ErrorKind::MANDATORY_FIELD_NOT_FOUND:
+      out.append("Mandatory field:[").append(error.field).append("] not found");
+      break;
+    case ErrorKind::MANDATORY_FIELD_NOT_FOUND_IN:
+      out.append("Mandatory field:[")
+          .append(error.field)
+          .append("] not found as child of:[")
+          .append(error.other)
+          .append("]");
+      break;
+    case ErrorKind::NOT_OBJECT_FIELD:
+      appendField(out, error.field, "] is not an object");
+      break;
+    case ErrorKind::NOT_STRING_FIELD:
+      appendField(out, error.field, "] is not string");
+      break;
+    case ErrorKind::NOT_EQUAL_TO_LEGACY:
+      out.append(QUOTE)
+          .append(error.field)
+          .append("\" is not equal to \"")
+          .append(error.other)
+          .append("\" attribute of 4G legacy subscription");
+      break;
+    case ErrorKind::CANNOT_BE_MODIFIED:
+      out.append(QUOTE)
+          .append(error.field)
+          .append(IN_QUOTE)
+          .append(JSON_AUTH_SUBSCRIPTION_STATIC_DATA)
+          .append("\" cannot be modified");
+      break;
+    case ErrorKind::NO_RELATED_RESOURCE: {
+      std::string_view path{error.resourcePath};
+      out.append("There is no associated relatedResource: ")
+          .append(path.substr(0, path.find_last_of('/')));
+      break;
+    }
+    case ErrorKind::PROV_JOURNAL_NOT_INCLUDED:
+      out.append("provJournal for subscriber mscId=")
+          .append(PathRoute{error.resourcePath}.mscId())
+          .append(
+              " not included. Needed to check if user is defined in AuC when "
+              "attribute \"")
+          .append(JSON_AKA_ALGORITHM_IND)
+          .append("\" is present");
+      break;
+  }
+}
+
+void appendErrorType(const Error &error, std::string &out) {
+  switch (error.kind) {
+    case ErrorKind::NO_RELATED_RESOURCE:
+      out.append("There is no associated relatedResource");
+      break;
+    case ErrorKind::PROV_JOURNAL_NOT_INCLUDED:
+      out.append("provJournal for subscriber not included. Needed to check "
+                 "if user is defined in AuC when attribute \"")
+          .append(JSON_AKA_ALGORITHM_IND)
+          .append("\" is present");
+      break;
+    default:
+      appendErrorDescription(error, out);
+      break;
+  }
+}
+
+}  // namespace entities
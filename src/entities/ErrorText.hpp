@@ -0,0 +1,117 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_ERROR_TEXT__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_ERROR_TEXT__
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "entities/types.hpp"
+#include "ports/json/JsonConstants.hpp"
+
+namespace entities {
+
+// Null terminated concatenation of the parts, made at compile time
+template <const auto &...PARTS>
+inline constexpr auto JOINED = [] {
+  std::array<char, (std::string_view{PARTS}.size() + ...) + 1> joined{};
+  std::size_t pos = 0;
+  for (std::string_view part : {std::string_view{PARTS}...}) {
+    for (auto c : part) {
+      joined[pos++] = c;
+    }
+  }
+  return joined;
+}();
+
+inline constexpr auto ERROR_CONSTRAINT_VIOLATION = "Constraint Violation";
+inline constexpr auto ERROR_UNPROCESSABLE_ENTITY = "Unprocessable entity";
+
+inline constexpr auto QUOTE = "\"";
+inline constexpr auto IN_QUOTE = "\" in \"";
+inline constexpr auto HAS_NOT_THE_VALID_FORMAT = "\" has not the valid format";
+inline constexpr auto CAN_NOT_BE_CREATED_OR_UPDATED =
+    "\" can not be created or updated";
+inline constexpr auto NOT_ALLOWED_WITH =
+    "It is not allowed to create or update a subscriber with \"";
+inline constexpr auto IF_NOT_DEFINED_IN_AUC = "\" if not defined in AuC";
+inline constexpr auto FOR_LEGACY_IS_NOT_DEFINED =
+    "\" for 4G legacy subscription is not defined";
+inline constexpr auto FOR_LEGACY_HAS_AN_INVALID_VALUE =
+    "\" for 4G legacy subscription has an invalid value";
+inline constexpr auto KEY_NOT_STRING_IN = "key not string in \"";
+inline constexpr auto VALUE_NOT_INTEGER_IN = "value not integer in \"";
+
+// Descriptions of the errors that are constants
+inline constexpr const char *INVALID_IMSI =
+    JOINED<QUOTE, JSON_IMSI, IN_QUOTE, JSON_RESOURCE_PATH,
+           HAS_NOT_THE_VALID_FORMAT>
+        .data();
+inline constexpr const char *DYNAMIC_DATA_NOT_WRITABLE =
+    JOINED<QUOTE, JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA,
+           CAN_NOT_BE_CREATED_OR_UPDATED>
+        .data();
+inline constexpr const char *VALIDATION_NOT_PERFORMED =
+    "Validation could not be performed on the specified resource_path";
+inline constexpr const char *INVALID_AUTHENTICATION_METHOD =
+    JOINED<QUOTE, JSON_AUTHENTICATION_METHOD, IN_QUOTE,
+           JSON_AUTH_SUBSCRIPTION_STATIC_DATA, HAS_NOT_THE_VALID_FORMAT>
+        .data();
+inline constexpr const char *AKA_ALGORITHM_IND_NOT_IN_AUC =
+    JOINED<NOT_ALLOWED_WITH, JSON_AKA_ALGORITHM_IND, IN_QUOTE,
+           JSON_AUTH_SUBSCRIPTION_STATIC_DATA, IF_NOT_DEFINED_IN_AUC>
+        .data();
+inline constexpr const char *LEGACY_AKA_TYPE_NOT_DEFINED =
+    JOINED<QUOTE, JSON_AKA_TYPE, FOR_LEGACY_IS_NOT_DEFINED>.data();
+inline constexpr const char *LEGACY_AKA_TYPE_INVALID =
+    JOINED<QUOTE, JSON_AKA_TYPE, FOR_LEGACY_HAS_AN_INVALID_VALUE>.data();
+inline constexpr const char *LAST_INDEXES_KEY_NOT_STRING =
+    JOINED<KEY_NOT_STRING_IN, JSON_LAST_INDEXES_LIST, QUOTE>.data();
+inline constexpr const char *LAST_INDEXES_VALUE_NOT_INTEGER =
+    JOINED<VALUE_NOT_INTEGER_IN, JSON_LAST_INDEXES_LIST, QUOTE>.data();
+
+// Error about the change at resourcePath, with a constant description
+inline Error constraintViolation(const std::string &resourcePath,
+                                 std::string_view description) {
+  return {ERROR_CONSTRAINT_VIOLATION, ErrorKind::TEXT, description, {},
+          resourcePath, {}};
+}
+
+inline Error constraintViolation(const std::string &resourcePath,
+                                 ErrorKind kind, std::string_view field,
+                                 std::string_view other = {}) {
+  return {ERROR_CONSTRAINT_VIOLATION, kind, field, other, resourcePath, {}};
+}
+
+inline Error unprocessableEntity(const std::string &resourcePath,
+                                 std::string_view description) {
+  return {ERROR_UNPROCESSABLE_ENTITY, ErrorKind::TEXT, description, {},
+          resourcePath, {}};
+}
+
+inline Error unprocessableEntity(const std::string &resourcePath,
+                                 ErrorKind kind) {
+  return {ERROR_UNPROCESSABLE_ENTITY, kind, {}, {}, resourcePath, {}};
+}
+
+// Error that is not about a change, with a description of its own
+inline Error requestError(std::string_view message, std::string description) {
+  return {message, ErrorKind::OWNED_TEXT, {}, {}, {}, std::move(description)};
+}
+
+// Appends the description of the error to out
+void appendErrorDescription(const Error &, std::string &out);
+
+inline std::string errorDescription(const Error &error) {
+  std::string description;
+  appendErrorDescription(error, description);
+  return description;
+}
+
+// Appends the description of the type of the error to out: its description
+// without the parts taken from the resource path
+void appendErrorType(const Error &, std::string &out);
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_ERROR_TEXT__
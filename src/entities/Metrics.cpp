@@ -0,0 +1,119 @@
+#include "entities/Metrics.hpp"
+
+#include <functional>
+
+#include "entities/ErrorText.hpp"
+
+namespace entities {
+
+namespace {
+
+std::atomic<std::uint64_t> nextMetricsId{1};
+
+inline std::size_t hashOf(const Error &error) {
+  std::hash<const void *> hash;
+  auto h = hash(error.message.data());
+  for (const void *part : {static_cast<const void *>(error.field.data()),
+                           static_cast<const void *>(error.other.data())}) {
+    h = h * 31 + hash(part);
+  }
+  return h * 31 + static_cast<std::size_t>(error.kind);
+}
+
+}  // namespace
+
+void LatencyHistogram::mergeInto(buckets_t &merged,
+                                 std::uint64_t &mergedSum) const {
+  for (std::size_t i = 0; i < BUCKETS; ++i) {
+    merged[i] += buckets[i].get();
+  }
+  mergedSum += sum.get();
+}
+
+Metrics::Metrics() : id{nextMetricsId.fetch_add(1)} {}
+
+Metrics::~Metrics() = default;
+
+Metrics::Shard &Metrics::registerThread() {
+  auto thread = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock{mutex};
+  for (auto &[owner, shard] : shards) {
+    if (owner == thread) {
+      return *shard;
+    }
+  }
+  shards.emplace_back(thread, std::make_unique<Shard>());
+  return *shards.back().second;
+}
+
+// Slots are taken by their thread only, and never given back: the type is
+// written before the slot is marked used, so a snapshot reads it whole
+void Metrics::recordViolations(const errors_t &errors) {
+  auto &shard = local();
+  for (const auto &error : errors) {
+    if (error.kind == ErrorKind::OWNED_TEXT) {
+      continue;
+    }
+    auto start = hashOf(error);
+    bool counted = false;
+    for (std::size_t n = 0; n < VIOLATION_TYPES and not counted; ++n) {
+      auto &slot = shard.violations[(start + n) % VIOLATION_TYPES];
+      if (not slot.used.load(std::memory_order_relaxed)) {
+        slot.message = error.message;
+        slot.kind = error.kind;
+        slot.field = error.field;
+        slot.other = error.other;
+        slot.used.store(true, std::memory_order_release);
+      } else if (slot.kind != error.kind or
+                 slot.message.data() != error.message.data() or
+                 slot.field.data() != error.field.data() or
+                 slot.field.size() != error.field.size() or
+                 slot.other.data() != error.other.data() or
+                 slot.other.size() != error.other.size()) {
+        continue;
+      }
+      slot.count.add(1);
+      counted = true;
+    }
+    if (not counted) {
+      shard.otherViolations.add(1);
+    }
+  }
+}
+
+// The same type may have been recorded from constants at different
+// addresses, so the types are merged by their description
+MetricsSnapshot Metrics::snapshot() const {
+  MetricsSnapshot snapshot;
+  std::lock_guard<std::mutex> lock{mutex};
+  for (const auto &[owner, shard] : shards) {
+    for (std::size_t stage = 0; stage < STAGE_NAMES.size(); ++stage) {
+      shard->stages[stage].mergeInto(snapshot.stages[stage].buckets,
+                                     snapshot.stages[stage].sumNanos);
+    }
+    for (std::size_t outcome = 0; outcome < OUTCOMES; ++outcome) {
+      snapshot.outcomes[outcome] += shard->outcomes[outcome].get();
+    }
+    for (const auto &slot : shard->violations) {
+      if (not slot.used.load(std::memory_order_acquire)) {
+        continue;
+      }
+      Error error{slot.message, slot.kind, slot.field, slot.other, {}, {}};
+      std::string type;
+      appendErrorType(error, type);
+      snapshot.violations[{std::string{slot.message}, std::move(type)}] +=
+          slot.count.get();
+    }
+    if (auto others = shard->otherViolations.get()) {
+      snapshot.violations[{std::string{}, OTHER_VIOLATION}] += others;
+    }
+  }
+  for (auto &stage : snapshot.stages) {
+    for (auto count : stage.buckets) {
+      stage.count += count;
+    }
+  }
+  return snapshot;
+}
+
+}  // namespace entities
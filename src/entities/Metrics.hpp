@@ -0,0 +1,192 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_METRICS__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_METRICS__
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "entities/types.hpp"
+
+namespace entities {
+
+// Stages of the validation of a document, as they are measured
+enum class Stage : std::uint8_t {
+  OAI_REQUEST,
+  PARSE,
+  RULES,
+  ENCODE,
+  OAI_RESPONSE
+};
+
+inline constexpr std::array<std::string_view, 5> STAGE_NAMES{
+    "oai_request", "parse", "rules", "encode", "oai_response"};
+
+// Status codes of the documents counted one by one. Any other is counted as
+// the last one
+inline constexpr std::array<std::uint32_t, 7> OUTCOME_CODES{
+    200, 400, 409, 413, 422, 500, 503};
+inline constexpr std::size_t OUTCOMES = OUTCOME_CODES.size() + 1;
+
+// Counter with a single writer, the thread owning it, so an increment is a
+// plain load and store. Readers on other threads see a value at most a few
+// increments old
+class ShardCounter final {
+ public:
+  inline void add(std::uint64_t n) {
+    value.store(value.load(std::memory_order_relaxed) + n,
+                std::memory_order_relaxed);
+  }
+  inline std::uint64_t get() const {
+    return value.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<std::uint64_t> value{0};
+};
+
+// Log-linear latency histogram in nanoseconds, as HDR histograms are: values
+// under SUB_BUCKETS have a bucket each, every power of two above is split in
+// SUB_BUCKETS buckets, so a value is known within 1/SUB_BUCKETS of itself.
+// Values from 2^MAX_EXPONENT ns (about 18 minutes) on share the last bucket
+class LatencyHistogram final {
+ public:
+  static constexpr unsigned SUB_BITS = 3;
+  static constexpr std::uint64_t SUB_BUCKETS = 1 << SUB_BITS;
+  static constexpr unsigned MAX_EXPONENT = 40;
+  static constexpr std::size_t BUCKETS =
+      (MAX_EXPONENT - SUB_BITS + 1) * SUB_BUCKETS;
+
+  using buckets_t = std::array<std::uint64_t, BUCKETS>;
+
+  static inline std::size_t bucketOf(std::uint64_t nanos) {
+    if (nanos < SUB_BUCKETS) {
+      return nanos;
+    }
+    auto exponent = 63 - __builtin_clzll(nanos);
+    if (exponent >= static_cast<int>(MAX_EXPONENT)) {
+      return BUCKETS - 1;
+    }
+    auto shift = exponent - SUB_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((nanos >> shift) & (SUB_BUCKETS - 1));
+  }
+
+  // Smallest value of the bucket
+  static inline std::uint64_t lowerBound(std::size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+      return bucket;
+    }
+    auto shift = bucket / SUB_BUCKETS - 1;
+    return (SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+  }
+
+  inline void record(std::uint64_t nanos) {
+    buckets[bucketOf(nanos)].add(1);
+    sum.add(nanos);
+  }
+
+  // Adds the counts to the merged buckets and sum
+  void mergeInto(buckets_t &merged, std::uint64_t &mergedSum) const;
+
+ private:
+  std::array<ShardCounter, BUCKETS> buckets;
+  ShardCounter sum;
+};
+
+// Everything counted so far, merged from every thread
+struct MetricsSnapshot {
+  struct StageLatency {
+    LatencyHistogram::buckets_t buckets{};
+    std::uint64_t count{0};
+    std::uint64_t sumNanos{0};
+  };
+  std::array<StageLatency, STAGE_NAMES.size()> stages;
+  std::array<std::uint64_t, OUTCOMES> outcomes{};
+  // By error message, then description of the type of the error
+  std::map<std::pair<std::string, std::string>, std::uint64_t> violations;
+};
+
+// Latency of each stage, status of each document and errors found, counted
+// by each thread in a shard of its own, so recording takes no lock and
+// shares no cache line with another thread. Shards are merged when a
+// snapshot is taken. They are kept for the life of the metrics, a thread
+// reusing the shard it had the first time
+class Metrics final {
+ public:
+  // Distinct error types counted by a thread. Any other goes to the
+  // "other" description
+  static constexpr std::size_t VIOLATION_TYPES = 128;
+  static constexpr auto OTHER_VIOLATION = "other";
+
+  Metrics();
+  Metrics(const Metrics &) = delete;
+  Metrics &operator=(const Metrics &) = delete;
+  ~Metrics();
+
+  inline void recordStage(Stage stage, std::chrono::nanoseconds elapsed) {
+    auto nanos = elapsed.count();
+    local().stages[static_cast<std::size_t>(stage)].record(
+        nanos > 0 ? static_cast<std::uint64_t>(nanos) : 0);
+  }
+
+  inline void recordOutcome(std::uint32_t status) {
+    std::size_t outcome = 0;
+    while (outcome < OUTCOME_CODES.size() and
+           OUTCOME_CODES[outcome] != status) {
+      ++outcome;
+    }
+    local().outcomes[outcome].add(1);
+  }
+
+  // Errors of a validation response. Errors that are not about a change
+  // are not counted
+  void recordViolations(const errors_t &);
+
+  MetricsSnapshot snapshot() const;
+
+ private:
+  // Error type, from the constants the error refers to
+  struct ViolationSlot {
+    std::atomic<bool> used{false};
+    std::string_view message;
+    ErrorKind kind{ErrorKind::TEXT};
+    std::string_view field;
+    std::string_view other;
+    ShardCounter count;
+  };
+
+  struct alignas(64) Shard {
+    std::array<LatencyHistogram, STAGE_NAMES.size()> stages;
+    std::array<ShardCounter, OUTCOMES> outcomes;
+    std::array<ViolationSlot, VIOLATION_TYPES> violations;
+    ShardCounter otherViolations;
+  };
+
+  // The shard of the calling thread, found through a cache of its own
+  inline Shard &local() {
+    thread_local std::pair<std::uint64_t, Shard *> cached{0, nullptr};
+    if (cached.first != id) {
+      cached = {id, &registerThread()};
+    }
+    return *cached.second;
+  }
+  Shard &registerThread();
+
+  // Tells these metrics from ones built before at the same address
+  const std::uint64_t id;
+  mutable std::mutex mutex;
+  std::vector<std::pair<std::thread::id, std::unique_ptr<Shard>>> shards;
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_METRICS__
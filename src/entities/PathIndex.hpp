@@ -0,0 +1,173 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_PATH_INDEX__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_PATH_INDEX__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace entities {
+
+// Values indexed by path, in a flat open addressing table with linear
+// probing. A path is looked up as a view, or as the parts it is made of
+// (find("/legacy/serv=Auth/IMSI=", imsi)), so no path is built to look it
+// up, and lookups hand out the stored value. Values are kept, and iterated,
+// in insertion order. As with std::map::insert, the first value inserted for
+// a path is kept.
+template <typename T>
+class PathIndex final {
+ public:
+  using value_type = std::pair<std::string, T>;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  PathIndex() = default;
+  PathIndex(std::initializer_list<value_type> values) {
+    for (const auto &value : values) {
+      insert(value_type{value});
+    }
+  }
+  ~PathIndex() = default;
+
+  // False when the path was already there
+  bool insert(value_type &&value) {
+    std::string_view path{value.first};
+    auto hash = hashOf(&path, 1);
+    if (lookup(hash, &path, 1) != nullptr) {
+      return false;
+    }
+    if ((entries.size() + 1) * 2 > slots.size()) {
+      rehash(std::max(MIN_SLOTS, slots.size() * 2));
+    }
+    entries.push_back(std::move(value));
+    place(hash, static_cast<std::uint32_t>(entries.size()));
+    return true;
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(value_type{*first});
+    }
+  }
+
+  // Value stored for the path made of the parts, or null
+  template <typename... Parts>
+  const T *find(const Parts &...parts) const {
+    std::array<std::string_view, sizeof...(Parts)> views{
+        std::string_view{parts}...};
+    return lookup(hashOf(views.data(), views.size()), views.data(),
+                  views.size());
+  }
+
+  // Alternative R of the value stored for the path, or null when there is
+  // none or it holds another one
+  template <typename R, typename... Parts>
+  const R *findAs(const Parts &...parts) const {
+    auto value = find(parts...);
+    return value ? std::get_if<R>(value) : nullptr;
+  }
+
+  inline bool contains(std::string_view path) const {
+    return find(path) != nullptr;
+  }
+
+  const T &at(std::string_view path) const {
+    if (auto value = find(path)) {
+      return *value;
+    }
+    throw std::out_of_range{"PathIndex::at"};
+  }
+
+  inline std::size_t size() const { return entries.size(); }
+  inline bool empty() const { return entries.empty(); }
+  inline const_iterator begin() const { return entries.begin(); }
+  inline const_iterator end() const { return entries.end(); }
+
+  void clear() {
+    entries.clear();
+    slots.clear();
+  }
+
+ private:
+  static constexpr std::size_t MIN_SLOTS = 16;
+  static constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+  static constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+  // entry is the position of the value in entries plus one, 0 when empty
+  struct Slot {
+    std::uint64_t hash;
+    std::uint32_t entry;
+  };
+
+  // FNV-1a over the parts, as over the path they make
+  static std::uint64_t hashOf(const std::string_view *parts, std::size_t n) {
+    auto hash = FNV_OFFSET;
+    for (std::size_t i = 0; i < n; ++i) {
+      for (auto c : parts[i]) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= FNV_PRIME;
+      }
+    }
+    return hash;
+  }
+
+  static bool isPath(std::string_view path, const std::string_view *parts,
+                     std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (path.substr(0, parts[i].size()) != parts[i]) {
+        return false;
+      }
+      path.remove_prefix(parts[i].size());
+    }
+    return path.empty();
+  }
+
+  const T *lookup(std::uint64_t hash, const std::string_view *parts,
+                  std::size_t n) const {
+    if (slots.empty()) {
+      return nullptr;
+    }
+    auto mask = slots.size() - 1;
+    for (auto i = hash & mask; slots[i].entry != 0; i = (i + 1) & mask) {
+      const auto &entry = entries[slots[i].entry - 1];
+      if (slots[i].hash == hash and isPath(entry.first, parts, n)) {
+        return &entry.second;
+      }
+    }
+    return nullptr;
+  }
+
+  void place(std::uint64_t hash, std::uint32_t entry) {
+    auto mask = slots.size() - 1;
+    auto i = hash & mask;
+    while (slots[i].entry != 0) {
+      i = (i + 1) & mask;
+    }
+    slots[i] = {hash, entry};
+  }
+
+  void rehash(std::size_t size) {
+    auto old = std::move(slots);
+    slots.assign(size, Slot{0, 0});
+    for (const auto &slot : old) {
+      if (slot.entry != 0) {
+        place(slot.hash, slot.entry);
+      }
+    }
+  }
+
+  std::vector<value_type> entries;
+  // Size is 0 or a power of 2, at least twice the number of entries
+  std::vector<Slot> slots;
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_PATH_INDEX__
@@ -0,0 +1,98 @@
+#include "entities/PathRoute.hpp"
+
+namespace entities {
+
+namespace {
+
+constexpr std::string_view SUBSCRIBERS_PREFIX{"/subscribers/"};
+constexpr std::string_view AUTH_SUBSCRIPTION_SUFFIX{"/authSubscription"};
+constexpr std::string_view AUTH_SUBSCRIPTION_SEGMENT{"/authSubscription/"};
+constexpr std::string_view STATIC_DATA_SUFFIX{"/authSubscriptionStaticData"};
+constexpr std::string_view IMSI_SEGMENT{"/authSubscription/imsi-"};
+constexpr std::string_view LEGACY_PREFIX{"/legacy/serv=Auth/"};
+constexpr std::size_t MIN_IMSI_DIGITS = 5;
+constexpr std::size_t MAX_IMSI_DIGITS = 15;
+
+inline bool isDigit(char c) { return c >= '0' and c <= '9'; }
+
+// ^/subscribers/(.*?)/authSubscription$
+bool matchAuthSubscription(std::string_view path) {
+  return path.size() >= SUBSCRIBERS_PREFIX.size() +
+                            AUTH_SUBSCRIPTION_SUFFIX.size() and
+         path.starts_with(SUBSCRIBERS_PREFIX) and
+         path.ends_with(AUTH_SUBSCRIPTION_SUFFIX);
+}
+
+// ^/subscribers/(.*?)/authSubscription/imsi-([0-9]{5,15}) ending at "end".
+// Returns the digits or an empty view when there is no match.
+std::string_view matchImsiEndingAt(std::string_view path, std::size_t end) {
+  auto begin = end;
+  while (begin > 0 and isDigit(path[begin - 1])) {
+    --begin;
+  }
+  auto digits = end - begin;
+  if (digits < MIN_IMSI_DIGITS or digits > MAX_IMSI_DIGITS or
+      begin < SUBSCRIBERS_PREFIX.size() + IMSI_SEGMENT.size()) {
+    return {};
+  }
+  if (path.substr(begin - IMSI_SEGMENT.size(), IMSI_SEGMENT.size()) !=
+      IMSI_SEGMENT) {
+    return {};
+  }
+  return path.substr(begin, digits);
+}
+
+}  // namespace
+
+PathRoute::PathRoute(std::string_view path) {
+  if (path.starts_with(LEGACY_PREFIX)) {
+    // ^/legacy/serv=Auth/[^/]*$
+    if (path.find('/', LEGACY_PREFIX.size()) == std::string_view::npos) {
+      kinds |= ROUTE_LEGACY;
+    }
+    return;
+  }
+
+  if (not path.starts_with(SUBSCRIBERS_PREFIX)) {
+    return;
+  }
+
+  if (matchAuthSubscription(path)) {
+    kinds |= ROUTE_AUTH_SUBSCRIPTION;
+  }
+
+  auto lastSlash = path.rfind('/');
+
+  // ^/subscribers/(.*?)/authSubscription/[^/]*$
+  if (matchAuthSubscription(path.substr(0, lastSlash))) {
+    kinds |= ROUTE_AUTH_SUBSCRIPTION_PRIV_ID;
+    privIdView = path.substr(lastSlash + 1);
+  }
+
+  // ^/subscribers/(.*?)/authSubscription/(.*?)/authSubscriptionStaticData$
+  // The lazy capture 1 stops at the first "/authSubscription/" after the
+  // prefix
+  if (path.ends_with(STATIC_DATA_SUFFIX)) {
+    auto head = path.substr(0, path.size() - STATIC_DATA_SUFFIX.size());
+    auto pos = head.find(AUTH_SUBSCRIPTION_SEGMENT, SUBSCRIBERS_PREFIX.size());
+    if (pos != std::string_view::npos) {
+      kinds |= ROUTE_AUTH_SUBSCRIPTION_STATIC_DATA;
+      mscIdView = head.substr(SUBSCRIBERS_PREFIX.size(),
+                              pos - SUBSCRIBERS_PREFIX.size());
+    }
+  }
+
+  // IMSI_PATTERN: the first alternative (IMSI as last segment) matches
+  // without capturing POS_IMSI, so the IMSI view is only set by the second
+  // one (IMSI followed by one more segment)
+  if (not matchImsiEndingAt(path, path.size()).empty()) {
+    kinds |= ROUTE_IMSI;
+  } else if (lastSlash > 0) {
+    imsiView = matchImsiEndingAt(path, lastSlash);
+    if (not imsiView.empty()) {
+      kinds |= ROUTE_IMSI;
+    }
+  }
+}
+
+}  // namespace entities
@@ -0,0 +1,59 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_PATH_ROUTE__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_PATH_ROUTE__
+
+#include <cstdint>
+#include <string_view>
+
+namespace entities {
+
+enum RouteKind : std::uint8_t {
+  ROUTE_NONE = 0,
+  ROUTE_AUTH_SUBSCRIPTION = 1 << 0,
+  ROUTE_AUTH_SUBSCRIPTION_STATIC_DATA = 1 << 1,
+  ROUTE_AUTH_SUBSCRIPTION_PRIV_ID = 1 << 2,
+  ROUTE_IMSI = 1 << 3,
+  ROUTE_LEGACY = 1 << 4,
+};
+
+// Single-pass classification of a resource_path. It gives the same results as
+// a full match of the URI patterns declared in ValidationData.hpp, so a path
+// is classified once and every rule reuses the result. Kinds are not mutually
+// exclusive (i.e. a path can be both authSubscription and priv-id).
+// Views point into the classified path, which must outlive the route.
+class PathRoute final {
+ public:
+  PathRoute() = default;
+  explicit PathRoute(std::string_view);
+  PathRoute(const PathRoute &) = default;
+  ~PathRoute() = default;
+
+  inline bool is(RouteKind kind) const { return kinds & kind; }
+  inline bool isAuthSubscription() const {
+    return is(ROUTE_AUTH_SUBSCRIPTION);
+  }
+  inline bool isAuthSubscriptionStaticData() const {
+    return is(ROUTE_AUTH_SUBSCRIPTION_STATIC_DATA);
+  }
+  inline bool isAuthSubscriptionPrivId() const {
+    return is(ROUTE_AUTH_SUBSCRIPTION_PRIV_ID);
+  }
+  inline bool hasImsi() const { return is(ROUTE_IMSI); }
+  inline bool isLegacy() const { return is(ROUTE_LEGACY); }
+
+  // capture 1 of AUTH_SUBSCRIPTION_STATIC_DATA_URI_PATTERN
+  inline std::string_view mscId() const { return mscIdView; }
+  // capture POS_IMSI of IMSI_PATTERN: empty when the path ends in the IMSI
+  inline std::string_view imsi() const { return imsiView; }
+  // last segment of an AUTH_SUBSCRIPTION_PRIV_ID_URI_PATTERN match
+  inline std::string_view privId() const { return privIdView; }
+
+ private:
+  std::uint8_t kinds{ROUTE_NONE};
+  std::string_view mscIdView;
+  std::string_view imsiView;
+  std::string_view privIdView;
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_PATH_ROUTE__
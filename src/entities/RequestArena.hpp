@@ -0,0 +1,50 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_REQUEST_ARENA__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_REQUEST_ARENA__
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+namespace entities {
+
+// Monotonic memory shared by every stage handling one request (parser,
+// rules and encoder). Allocations are never freed one by one: the whole
+// arena is released at once when it goes out of scope, after the response
+// has been sent. The first INITIAL_SIZE bytes live inside the arena itself,
+// so a typical request does not reach the global heap.
+class RequestArena final {
+ public:
+  static constexpr std::size_t INITIAL_SIZE = 32 * 1024;
+  // Initial chunk handed to each rapidjson::MemoryPoolAllocator
+  static constexpr std::size_t JSON_POOL_SIZE = 8 * 1024;
+
+  RequestArena()
+      : buffer{},
+        memory{buffer.data(), buffer.size(),
+               std::pmr::new_delete_resource()} {}
+  RequestArena(const RequestArena &) = delete;
+  RequestArena &operator=(const RequestArena &) = delete;
+  ~RequestArena() = default;
+
+  inline void *allocate(std::size_t size,
+                        std::size_t alignment = alignof(std::max_align_t)) {
+    return memory.allocate(size, alignment);
+  }
+
+  inline std::pmr::memory_resource *resource() { return &memory; }
+
+  inline void release() { memory.release(); }
+
+  inline bool isInline(const void *ptr) const {
+    auto p = static_cast<const std::byte *>(ptr);
+    return p >= buffer.data() and p < buffer.data() + buffer.size();
+  }
+
+ private:
+  alignas(std::max_align_t) std::array<std::byte, INITIAL_SIZE> buffer;
+  std::pmr::monotonic_buffer_resource memory;
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_REQUEST_ARENA__
@@ -0,0 +1,50 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_STAGE_TIMER__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_STAGE_TIMER__
+
+#include <chrono>
+
+#include "entities/Context.hpp"
+#include "entities/Metrics.hpp"
+
+namespace entities {
+
+// Records the time from its construction to stop(), or to its destruction,
+// once: in the metrics, and as a span of the request context when it is
+// traced. It may start with time already spent on the stage
+class StageTimer final {
+ public:
+  using clock_t = std::chrono::steady_clock;
+
+  StageTimer(Metrics &metrics, Stage stage, const Context *context = nullptr,
+             std::chrono::nanoseconds spent = {})
+      : metrics{metrics},
+        stage{stage},
+        context{context},
+        spent{spent},
+        start{clock_t::now()} {}
+  StageTimer(const StageTimer &) = delete;
+  ~StageTimer() { stop(); }
+
+  inline void stop() {
+    if (not stopped) {
+      stopped = true;
+      auto elapsed = spent + (clock_t::now() - start);
+      metrics.recordStage(stage, elapsed);
+      if (context and context->isTraced()) {
+        context->recordSpan(stage, elapsed);
+      }
+    }
+  }
+
+ private:
+  Metrics &metrics;
+  const Stage stage;
+  const Context *const context;
+  const std::chrono::nanoseconds spent;
+  const clock_t::time_point start;
+  bool stopped{false};
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_STAGE_TIMER__
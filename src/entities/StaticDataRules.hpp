@@ -0,0 +1,135 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_STATIC_DATA_RULES__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_STATIC_DATA_RULES__
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "entities/CharClass.hpp"
+#include "entities/ErrorText.hpp"
+#include "entities/ValidationData.hpp"
+#include "entities/types.hpp"
+#include "ports/json/JsonConstants.hpp"
+
+namespace entities {
+
+inline constexpr auto HAS_INVALID_VALUE = "\" has invalid value";
+inline constexpr auto HAS_INVALID_SIZE = "\" has invalid size";
+inline constexpr auto NOT_DEFINED_WITH_AKA =
+    "\" has not been defined with an AKA authentication method";
+inline constexpr auto MUST_NOT_BE_PRESENT_AS = "\" must not be present as \"";
+inline constexpr auto IS_NOT_MILLENAGE = "\" is not MILLENAGE (0,2-15)";
+
+// Description of an error on an authSubscriptionStaticData field
+template <const auto &FIELD, const auto &...REASON>
+inline constexpr const char *STATIC_DATA_ERROR =
+    JOINED<QUOTE, FIELD, IN_QUOTE, JSON_AUTH_SUBSCRIPTION_STATIC_DATA,
+           REASON...>
+        .data();
+
+enum class FieldCheck {
+  // ^[A-Fa-f0-9]*$, of length min when min is not 0
+  HEX,
+  // ^[A-Fa-f0-9]*$, then of length min, with its own error
+  HEX_OF_SIZE,
+  // charclass::toBoundedInt in [min, max]
+  BOUNDED_INT,
+  // charclass::toCanonicalInt in [min, max]
+  CANONICAL_INT
+};
+
+enum class FieldPresence {
+  OPTIONAL,
+  // Mandatory with an AKA authentication method, unless there is a 4G legacy
+  AKA
+};
+
+using static_data_field_t =
+    std::optional<std::string> AuthSubscriptionStaticData::*;
+using static_data_consistency_t = bool (*)(const AuthSubscriptionStaticData &);
+
+// How a field of authSubscriptionStaticData is checked. The errors are
+// constants, so a valid field builds no string
+struct FieldRule {
+  static_data_field_t field;
+  FieldCheck check;
+  int min;
+  int max;
+  FieldPresence presence;
+  const char *invalidValue;
+  const char *invalidSize;
+  const char *notDefined;
+  // Checked on a valid value, against the other fields. Null for none
+  static_data_consistency_t consistent;
+  const char *inconsistent;
+};
+
+template <const auto &FIELD>
+constexpr FieldRule fieldRule(static_data_field_t field, FieldCheck check,
+                              int min, int max, FieldPresence presence,
+                              static_data_consistency_t consistent = nullptr,
+                              const char *inconsistent = nullptr) {
+  return {field,
+          check,
+          min,
+          max,
+          presence,
+          STATIC_DATA_ERROR<FIELD, HAS_INVALID_VALUE>,
+          STATIC_DATA_ERROR<FIELD, HAS_INVALID_SIZE>,
+          STATIC_DATA_ERROR<FIELD, NOT_DEFINED_WITH_AKA>,
+          consistent,
+          inconsistent};
+}
+
+// An algorithmId given as a number is MILLENAGE (0,2-15)
+inline bool isMillenageAlgorithm(const AuthSubscriptionStaticData &data) {
+  if (not data.algorithmId.has_value()) {
+    return false;
+  }
+  const auto &algorithmId = data.algorithmId.value();
+  if (algorithmId.empty() or not charclass::isDigits(algorithmId)) {
+    return true;
+  }
+  auto value =
+      charclass::toBoundedInt(algorithmId, MIN_ALGORITHM_ID, MAX_ALGORITHM_ID);
+  return value.has_value() and value.value() != TEST_ALGORITHM_ID;
+}
+
+// Rules of the authSubscriptionStaticData fields, checked in this order.
+// A new field takes one entry
+inline constexpr std::array STATIC_DATA_FIELD_RULES{
+    fieldRule<JSON_ENC_PERMANENT_KEY>(
+        &AuthSubscriptionStaticData::encPermanentKey, FieldCheck::HEX_OF_SIZE,
+        LENGTH_ENC_PERMANENT_KEY, 0, FieldPresence::AKA),
+    fieldRule<JSON_AUTHENTICATION_MANAGEMENT_FIELD>(
+        &AuthSubscriptionStaticData::authenticationManagementField,
+        FieldCheck::HEX, AUTHENTICATION_MANAGEMENT_FIELD_LENGTH, 0,
+        FieldPresence::AKA),
+    fieldRule<JSON_ALGORITHM_ID>(
+        &AuthSubscriptionStaticData::algorithmId, FieldCheck::BOUNDED_INT,
+        MIN_ALGORITHM_ID, MAX_ALGORITHM_ID, FieldPresence::AKA),
+    fieldRule<JSON_A4_KEY_IND>(
+        &AuthSubscriptionStaticData::a4KeyInd, FieldCheck::BOUNDED_INT,
+        A4_KEY_IND_MIN, A4_KEY_IND_MAX, FieldPresence::AKA),
+    fieldRule<JSON_A4_IND>(&AuthSubscriptionStaticData::a4Ind,
+                           FieldCheck::BOUNDED_INT, A4_IND_MIN, A4_IND_MAX,
+                           FieldPresence::AKA),
+    fieldRule<JSON_ENC_OPC_KEY>(
+        &AuthSubscriptionStaticData::encOpcKey, FieldCheck::HEX, 0, 0,
+        FieldPresence::OPTIONAL, isMillenageAlgorithm,
+        STATIC_DATA_ERROR<JSON_ENC_OPC_KEY, MUST_NOT_BE_PRESENT_AS,
+                          JSON_ALGORITHM_ID, IS_NOT_MILLENAGE>),
+    fieldRule<JSON_A4_KEY_V>(
+        &AuthSubscriptionStaticData::a4KeyV, FieldCheck::CANONICAL_INT,
+        A4_KEY_V_MIN, A4_KEY_V_MAX, FieldPresence::OPTIONAL),
+    fieldRule<JSON_AKA_ALGORITHM_IND>(
+        &AuthSubscriptionStaticData::akaAlgorithmInd,
+        FieldCheck::CANONICAL_INT, AKA_ALGORITHM_IND_MIN,
+        AKA_ALGORITHM_IND_MAX, FieldPresence::OPTIONAL),
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_STATIC_DATA_RULES__
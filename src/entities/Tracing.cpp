@@ -0,0 +1,71 @@
+#include "entities/Tracing.hpp"
+
+#include <random>
+
+namespace entities {
+
+namespace {
+
+constexpr std::size_t SPAN_ID_DIGITS = 16;
+
+std::optional<std::uint64_t> hexOf(std::string_view digits) {
+  std::uint64_t value = 0;
+  for (auto c : digits) {
+    std::uint64_t digit;
+    if (c >= '0' and c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' and c <= 'f') {
+      digit = c - 'a' + 10;
+    } else if (c >= 'A' and c <= 'F') {
+      digit = c - 'A' + 10;
+    } else {
+      return std::nullopt;
+    }
+    value = value << 4 | digit;
+  }
+  return value;
+}
+
+// splitmix64, seeded once per thread
+std::uint64_t nextRandom() {
+  thread_local std::uint64_t state = std::random_device{}() |
+                                     std::uint64_t{std::random_device{}()}
+                                         << 32;
+  auto z = (state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+}  // namespace
+
+std::optional<SpanContext> traceIdOf(std::string_view id) {
+  if (id.size() != SPAN_ID_DIGITS and id.size() != 2 * SPAN_ID_DIGITS) {
+    return std::nullopt;
+  }
+  auto high = id.size() == SPAN_ID_DIGITS
+                  ? std::optional<std::uint64_t>{0}
+                  : hexOf(id.substr(0, SPAN_ID_DIGITS));
+  auto low = hexOf(id.substr(id.size() - SPAN_ID_DIGITS));
+  if (not high or not low or (*high == 0 and *low == 0)) {
+    return std::nullopt;
+  }
+  return SpanContext{*high, *low, 0};
+}
+
+std::optional<std::uint64_t> spanIdOf(std::string_view id) {
+  if (id.size() != SPAN_ID_DIGITS) {
+    return std::nullopt;
+  }
+  return hexOf(id);
+}
+
+std::uint64_t newSpanId() {
+  std::uint64_t id;
+  do {
+    id = nextRandom();
+  } while (id == 0);
+  return id;
+}
+
+}  // namespace entities
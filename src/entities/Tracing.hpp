@@ -0,0 +1,79 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_TRACING__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_TRACING__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "entities/Metrics.hpp"
+#include "entities/mpmcqueue.hpp"
+
+namespace entities {
+
+// B3 ids of a traced request, the stage spans are tied to
+struct SpanContext {
+  // Zero for 64 bit trace ids
+  std::uint64_t traceIdHigh{0};
+  std::uint64_t traceIdLow{0};
+  // Span of the caller, zero when it sent none
+  std::uint64_t parentSpanId{0};
+};
+
+// Parses an id of 16 or 32 hex digits (x-b3-traceid), or of 16 for
+// spanIdOf (x-b3-spanid). nullopt when it is not valid
+std::optional<SpanContext> traceIdOf(std::string_view);
+std::optional<std::uint64_t> spanIdOf(std::string_view);
+
+// Random, never zero
+std::uint64_t newSpanId();
+
+// Time spent on a stage of a traced request. Plain data, so recording one
+// only copies it into the ring
+struct Span {
+  SpanContext context;
+  std::uint64_t spanId{0};
+  std::uint64_t startUnixNanos{0};
+  std::uint64_t durationNanos{0};
+  Stage stage{Stage::OAI_REQUEST};
+};
+
+// Fixed size ring the workers record spans into, with no lock, and an
+// exporter drains. A span recorded while the ring is full is dropped and
+// counted, so tracing never slows a validation down
+class SpanRing final {
+ public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 8192;
+
+  explicit SpanRing(std::size_t capacity = DEFAULT_CAPACITY)
+      : spans{capacity} {}
+  SpanRing(const SpanRing &) = delete;
+  ~SpanRing() = default;
+
+  inline void record(Span &&span) {
+    if (not spans.tryPush(std::move(span))) {
+      droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Moves up to max spans to out. Returns the number of spans moved
+  inline std::size_t drain(std::vector<Span> &out, std::size_t max) {
+    return spans.popBulk(std::back_inserter(out), max);
+  }
+
+  inline std::size_t capacity() const { return spans.capacity(); }
+  inline std::uint64_t dropped() const {
+    return droppedCount.load(std::memory_order_relaxed);
+  }
+
+ private:
+  MpmcQueue<Span> spans;
+  std::atomic<std::uint64_t> droppedCount{0};
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_TRACING__
@@ -1,120 +1,225 @@
 #include "entities/ValidationData.hpp"
 
+#include <algorithm>
 #include <bitset>
 #include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
 #include <iomanip>
+#include <iterator>
 #include <stdexcept>
 
+#include "entities/CharClass.hpp"
+#include "entities/ErrorText.hpp"
+#include "entities/StaticDataRules.hpp"
 #include "ports/HTTPcodes.hpp"
 #include "ports/json/JsonConstants.hpp"
 
 namespace entities {
 
 entities::validation_response_t ValidationData::applyValidationRules() {
-  bool ret = true;
-  auto code = ::port::HTTP_OK;
+  return applySequentially(nullptr);
+}
 
-  for (auto c : changes) {
-    entities::validation_response_t resp{true, ::port::HTTP_OK};
+entities::validation_response_t ValidationData::applySequentially(
+    WorkerPool* workers) {
+  auto correlated = correlateChanges();
+  MergedOutcome merged{true, ::port::HTTP_OK};
+  for (std::size_t i = 0; i < changes.size(); ++i) {
+    if (workers and i) {
+      workers->preemptionPoint();
+    }
+    mergeChangeOutcome(
+        applyChangeRules(changes[i], correlated[i], hasErrors()), merged);
+  }
+  return {merged.validation, merged.code};
+}
+
+entities::validation_response_t ValidationData::applyValidationRules(
+    WorkerPool& workers, std::size_t minParallelChanges) {
+  if (changes.size() < std::max<std::size_t>(minParallelChanges, 2)) {
+    return applySequentially(&workers);
+  }
 
-    if (checkAuthSubscriptionUri(c.resourcePath)) {
-      if (not c.operation.compare(JSON_OPERATION_DELETE)) {
-        response.changes.push_back(c);
+  // The rules only read the changes and the related resources
+  auto correlated = correlateChanges();
+  auto earlierErrors = hasErrors();
+  std::vector<ChangeOutcome> outcomes(changes.size());
+  workers.parallelFor(changes.size(), [&](std::size_t i) {
+    outcomes[i] = applyChangeRules(changes[i], correlated[i], earlierErrors);
+  });
+
+  if (not earlierErrors) {
+    auto firstErrors =
+        std::find_if(outcomes.begin(), outcomes.end(),
+                     [](const auto& outcome) { return outcome.errors.size(); });
+    std::vector<std::size_t> again;
+    for (auto it = firstErrors; it != outcomes.end(); ++it) {
+      if (it != firstErrors and it->dependsOnEarlierErrors) {
+        again.push_back(it - outcomes.begin());
       }
-    } else if (checkAuthSubscriptionStaticDataUri(c.resourcePath) or
-               checkAuthSubscriptionPrivIdUri(c.resourcePath)) {
-      if (checkUriImsi(c.resourcePath)) {
-        if (not c.operation.compare(JSON_OPERATION_CREATE)) {
-          resp = checkForCreationAuthSubscription(c);
-        } else if (not c.operation.compare(JSON_OPERATION_UPDATE)) {
-          resp = checkForUpdateAuthSubscription(c);
-        }
+    }
+    workers.parallelFor(again.size(), [&](std::size_t i) {
+      outcomes[again[i]] =
+          applyChangeRules(changes[again[i]], correlated[again[i]], true);
+    });
+  }
+
+  MergedOutcome merged{true, ::port::HTTP_OK};
+  for (auto& outcome : outcomes) {
+    mergeChangeOutcome(std::move(outcome), merged);
+  }
+  return {merged.validation, merged.code};
+}
+
+std::vector<ValidationData::CorrelatedChange>
+ValidationData::correlateChanges() const {
+  std::vector<CorrelatedChange> correlated(changes.size());
+  for (std::size_t i = 0; i < changes.size(); ++i) {
+    auto& related = correlated[i];
+    const auto& path = changes[i].resourcePath;
+    related.route = PathRoute{path};
+    // Only the static data rules read related resources
+    if (not related.route.hasImsi() or
+        not(related.route.isAuthSubscriptionStaticData() or
+            related.route.isAuthSubscriptionPrivId())) {
+      continue;
+    }
+    related.legacy = relatedResources.find(LEGACY_BASE_PATH,
+                                           related.route.imsi());
+    related.provJournal =
+        relatedResources.find(PROV_JOURNAL_PATH_PREFIX, related.route.mscId(),
+                              PROV_JOURNAL_PATH_SUFFIX);
+    related.base = relatedResources.find(getBasePathView(path));
+    related.current = relatedResources.find(path);
+  }
+  return correlated;
+}
 
-        ret &= std::get<entities::VALIDATION>(resp);
-        // HTTP_UNPROCESSABLE_ENTITY (422) has preference over HTTP_CONFLICT
-        // (409) and HTTP_CONFLICT (409) has preference over HTTP_OK (200)
-        code = std::max(code, std::get<entities::CODE>(resp));
+ValidationData::ChangeOutcome ValidationData::applyChangeRules(
+    const entities::Change& c, const CorrelatedChange& related,
+    bool earlierErrors) const {
+  ChangeOutcome outcome;
+  RuleErrors errors{earlierErrors};
+  const auto& route = related.route;
 
-        if (ret) {
-          entities::Change responseChange = c;
-          computeMutations(responseChange);
-          response.changes.push_back(responseChange);
-        }
-      } else {
-        ret = false;
-        code = std::max(code, ::port::HTTP_CONFLICT);
-        addError("Constraint Violation",
-                 {{"resource_path", c.resourcePath},
-                  {"description", "\"" + std::string{JSON_IMSI} + "\" in \"" +
-                                      std::string{JSON_RESOURCE_PATH} +
-                                      "\" has not the valid format"}});
+  if (route.isAuthSubscription()) {
+    outcome.rule = ChangeRule::AUTH_SUBSCRIPTION;
+    if (not c.operation.compare(JSON_OPERATION_DELETE)) {
+      outcome.change = c;
+    }
+  } else if (route.isAuthSubscriptionStaticData() or
+             route.isAuthSubscriptionPrivId()) {
+    if (route.hasImsi()) {
+      outcome.rule = ChangeRule::STATIC_DATA;
+      outcome.resp = {true, ::port::HTTP_OK};
+      if (not c.operation.compare(JSON_OPERATION_CREATE)) {
+        outcome.resp = checkForCreationAuthSubscription(c, related, errors);
+        outcome.dependsOnEarlierErrors = true;
+      } else if (not c.operation.compare(JSON_OPERATION_UPDATE)) {
+        outcome.resp = checkForUpdateAuthSubscription(c, related, errors);
+        outcome.dependsOnEarlierErrors = true;
+      }
+
+      if (std::get<entities::VALIDATION>(outcome.resp)) {
+        outcome.change = c;
+        computeMutations(*outcome.change, related);
       }
-    } else if (c.resourcePath.ends_with(JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA)) {
-      ret = false;
-      code = std::max(code, ::port::HTTP_CONFLICT);
-      addError("Constraint Violation",
-               {{"resource_path", c.resourcePath},
-                {"description",
-                 "\"" + std::string{JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA} +
-                     "\" can not be created or updated"}});
-    } else if (c.operation.compare(JSON_OPERATION_DELETE)) {
-      ret = false;
-      code = ::port::HTTP_UNPROCESSABLE_ENTITY;
-      addError("Unprocessable entity", {{"resource_path", c.resourcePath},
-                                        {"description",
-                                         "Validation could not be performed on "
-                                         "the specified resource_path"}});
     } else {
-      ret = true;
-      code = ::port::HTTP_OK;
-      response.changes.push_back(c);
+      outcome.rule = ChangeRule::INVALID_IMSI;
+      errors.add(constraintViolation(c.resourcePath, INVALID_IMSI));
     }
+  } else if (c.resourcePath.ends_with(JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA)) {
+    outcome.rule = ChangeRule::DYNAMIC_DATA;
+    errors.add(constraintViolation(c.resourcePath, DYNAMIC_DATA_NOT_WRITABLE));
+  } else if (c.operation.compare(JSON_OPERATION_DELETE)) {
+    outcome.rule = ChangeRule::UNPROCESSABLE;
+    errors.add(unprocessableEntity(c.resourcePath, VALIDATION_NOT_PERFORMED));
+  } else {
+    outcome.rule = ChangeRule::DELETE;
+    outcome.change = c;
   }
 
-  return {ret, code};
+  outcome.errors = std::move(errors.errors);
+  return outcome;
+}
+
+void ValidationData::mergeChangeOutcome(ChangeOutcome&& outcome,
+                                        MergedOutcome& merged) {
+  response.errors.insert(response.errors.end(),
+                         std::make_move_iterator(outcome.errors.begin()),
+                         std::make_move_iterator(outcome.errors.end()));
+
+  switch (outcome.rule) {
+    case ChangeRule::AUTH_SUBSCRIPTION:
+      if (outcome.change) {
+        response.changes.push_back(std::move(*outcome.change));
+      }
+      break;
+    case ChangeRule::STATIC_DATA:
+      merged.validation &= std::get<entities::VALIDATION>(outcome.resp);
+      // HTTP_UNPROCESSABLE_ENTITY (422) has preference over HTTP_CONFLICT
+      // (409) and HTTP_CONFLICT (409) has preference over HTTP_OK (200)
+      merged.code =
+          std::max(merged.code, std::get<entities::CODE>(outcome.resp));
+      // Once a change is not valid, the valid ones after it are left out
+      if (merged.validation) {
+        response.changes.push_back(std::move(*outcome.change));
+      }
+      break;
+    case ChangeRule::INVALID_IMSI:
+    case ChangeRule::DYNAMIC_DATA:
+      merged.validation = false;
+      merged.code = std::max(merged.code, ::port::HTTP_CONFLICT);
+      break;
+    case ChangeRule::UNPROCESSABLE:
+      merged.validation = false;
+      merged.code = ::port::HTTP_UNPROCESSABLE_ENTITY;
+      break;
+    case ChangeRule::DELETE:
+      merged.validation = true;
+      merged.code = ::port::HTTP_OK;
+      response.changes.push_back(std::move(*outcome.change));
+      break;
+  }
 }
 
 bool ValidationData::checkAuthSubscriptionUri(const std::string& resourcePath) {
-  return checkPatternOnData(authSubscriptionUriRegex, resourcePath);
+  return PathRoute{resourcePath}.isAuthSubscription();
 }
 
 bool ValidationData::checkAuthSubscriptionStaticDataUri(
     const std::string& resourcePath) {
-  return checkPatternOnData(authSubscriptionStaticDataUriRegex, resourcePath);
+  return PathRoute{resourcePath}.isAuthSubscriptionStaticData();
 }
 
 bool ValidationData::checkAuthSubscriptionPrivIdUri(
     const std::string& resourcePath) {
-  return checkPatternOnData(authSubscriptionPrivIdUriRegex, resourcePath);
+  return PathRoute{resourcePath}.isAuthSubscriptionPrivId();
 }
 
 bool ValidationData::checkUriImsi(const std::string& resourcePath) {
-  return checkPatternOnData(imsiRegex, resourcePath);
+  return PathRoute{resourcePath}.hasImsi();
 }
 
 bool ValidationData::checkAuthSubscriptionLegacyUri(
     const std::string& resourcePath) {
-  return checkPatternOnData(legacyRegex, resourcePath);
+  return PathRoute{resourcePath}.isLegacy();
 }
 
 std::string ValidationData::getMscId(const std::string& resourcePath) {
-  boost::smatch sm;
-  if (boost::regex_search(resourcePath, sm,
-                          authSubscriptionStaticDataUriRegex)) {
-    return sm[POS_MSCID];
-  }
-  return {};
+  return std::string{PathRoute{resourcePath}.mscId()};
 }
 
 std::string ValidationData::buildProvJournalResourcePathFromMscId(
     const std::string& mscId) {
-  return std::string{"/subscribers/"}.append(mscId).append(
-      "/journal/provJournal");
+  return std::string{PROV_JOURNAL_PATH_PREFIX}.append(mscId).append(
+      PROV_JOURNAL_PATH_SUFFIX);
 }
 
-bool ValidationData::checkBitIsSet(const std::string& bitMask,
+bool ValidationData::checkBitIsSet(std::string_view bitMask,
                                    const int bitNumber) {
+  if (bitNumber < 0 or static_cast<std::size_t>(bitNumber) >= bitMask.size()) {
+    return false;
+  }
   auto it = bitMask.rbegin() + bitNumber;
   if (*it == '1') {
     return true;
@@ -123,63 +228,8 @@ bool ValidationData::checkBitIsSet(const std::string& bitMask,
   return false;
 }
 
-bool ValidationData::checkPatternOnData(const boost::regex& pattern,
-                                        const std::string& data) {
-  boost::cmatch patternMatch;
-  if (!boost::regex_match(data.c_str(), patternMatch, pattern)) {
-    return false;
-  }
-  return true;
-}
-
 std::string ValidationData::getImsi(const std::string& path) {
-  boost::cmatch patternMatch;
-  if (!boost::regex_match(path.c_str(), patternMatch, imsiRegex)) {
-    return {};
-  } else {
-    return boost::lexical_cast<std::string>(patternMatch[POS_IMSI]);
-  }
-}
-
-bool ValidationData::checkA4IndInRange(const std::string& a4ind) {
-  int value;
-  try {
-    value = std::stoi(a4ind);
-  } catch (...) {
-    return false;
-  }
-  return ((value >= A4_IND_MIN) && (value <= A4_IND_MAX));
-}
-
-bool ValidationData::checkA4KeyIndInRange(const std::string& a4keyind) {
-  int value;
-  try {
-    value = std::stoi(a4keyind);
-  } catch (...) {
-    return false;
-  }
-  return ((value >= A4_KEY_IND_MIN) && (value <= A4_KEY_IND_MAX));
-}
-
-bool ValidationData::checkAlgorithmIdInRange(const std::string& algorithm) {
-  int value;
-  try {
-    value = std::stoi(algorithm);
-  } catch (...) {
-    return false;
-  }
-  return ((value >= MIN_ALGORITHM_ID) && (value <= MAX_ALGORITHM_ID));
-}
-
-bool ValidationData::checkAlgorithmIdIsMillenage(const std::string& algorithm) {
-  int value;
-  try {
-    value = std::stoi(algorithm);
-  } catch (...) {
-    return false;
-  }
-  return ((value >= MIN_ALGORITHM_ID) && (value <= MAX_ALGORITHM_ID) &&
-          (value != TEST_ALGORITHM_ID));
+  return std::string{PathRoute{path}.imsi()};
 }
 
 unsigned int ValidationData::fromHexStringToUnsignedInt(
@@ -197,30 +247,24 @@ std::string ValidationData::fromUnsignedIntToHexString(
   return (boost::to_upper_copy(str.str()));
 }
 
-void ValidationData::computeMutations(entities::Change& change) {
-  if (checkAuthSubscriptionStaticDataUri(change.resourcePath)) {
+void ValidationData::computeMutations(
+    entities::Change& change, const CorrelatedChange& related) const {
+  if (related.route.isAuthSubscriptionStaticData()) {
     if (not change.operation.compare(JSON_OPERATION_CREATE)) {
       entities::auth_subscription_dynamic_data_t dynData;
 
-      std::string legacyPath =
-          getLegacyPathFromResourcePath(change.resourcePath);
-
-      if (relatedResources.contains(legacyPath)) {
-        auto authSubscriptionLegacyRelResource =
-            boost::get<entities::auth_subscription_legacy_t>(
-                relatedResources.at(legacyPath));
-
-        entities::seq_he_t seqHe;
-        if (authSubscriptionLegacyRelResource.seqHe.has_value()) {
-          seqHe = authSubscriptionLegacyRelResource.seqHe.value();
-        }
+      if (auto legacy = std::get_if<entities::auth_subscription_legacy_t>(
+              related.legacy)) {
+        const auto& authSubscriptionLegacyRelResource = *legacy;
 
         if (not authSubscriptionLegacyRelResource.seqHe.has_value() or
-            not seqHe.compare(SEQHE_INVALID_VALUE)) {
+            not authSubscriptionLegacyRelResource.seqHe.value().compare(
+                SEQHE_INVALID_VALUE)) {
           dynData.sqnScheme.emplace(SQN_SCHEME_TIME_BASED);
         } else {
           dynData.sqnScheme.emplace(SQN_SCHEME_NON_TIME_BASED);
-          entities::sqn_t sqn = computeSqnFromSeqHe(seqHe);
+          entities::sqn_t sqn = computeSqnFromSeqHe(
+              authSubscriptionLegacyRelResource.seqHe.value());
           dynData.sqn.emplace(sqn);
         }
         change.authSubscription.authSubscriptionDynamicData = dynData;
@@ -237,11 +281,9 @@ void ValidationData::computeMutations(entities::Change& change) {
       // Update of dynamic data is not done:
       // In case the user tries to update dynamic data,
       // we should return error
-      if (relatedResources.contains(change.resourcePath)) {
-        auto authSubscriptionRelResource =
-            boost::get<entities::auth_subscription_t>(
-                relatedResources.at(change.resourcePath));
-        if (not authSubscriptionRelResource.authSubscriptionDynamicData
+      if (auto authSubscriptionRelResource =
+              std::get_if<entities::auth_subscription_t>(related.current)) {
+        if (not authSubscriptionRelResource->authSubscriptionDynamicData
                     .has_value()) {
           change.authSubscription.authSubscriptionDynamicData.reset();
         }
@@ -252,7 +294,7 @@ void ValidationData::computeMutations(entities::Change& change) {
 
 void ValidationData::fillOptionalAuthSubscriptionStaticAttributes(
     entities::Change& c,
-    const entities::auth_subscription_legacy_t& relResource) {
+    const entities::auth_subscription_legacy_t& relResource) const {
   if (c.authSubscription.authSubscriptionStaticData.has_value()) {
     fillOptionalAttribute(
         c.authSubscription.authSubscriptionStaticData.value().encPermanentKey,
@@ -289,21 +331,22 @@ void ValidationData::fillOptionalAuthSubscriptionStaticAttributes(
 
 void ValidationData::fillOptionalAttribute(
     std::optional<std::string>& attr,
-    const std::optional<std::string>& attrLegacy) {
+    const std::optional<std::string>& attrLegacy) const {
   if (not attr.has_value() and attrLegacy.has_value()) {
     attr.emplace(attrLegacy.value());
   }
 }
 
-void ValidationData::fillOptionalAttribute(std::optional<std::string>& attr,
-                                           const std::string& attrLegacy) {
+void ValidationData::fillOptionalAttribute(
+    std::optional<std::string>& attr, const std::string& attrLegacy) const {
   if (not attr.has_value()) {
     attr.emplace(attrLegacy);
   }
 }
 
 void ValidationData::fillOptionalAttribute(
-    std::optional<std::string>& attr, const std::optional<int>& attrLegacy) {
+    std::optional<std::string>& attr,
+    const std::optional<int>& attrLegacy) const {
   if (not attr.has_value() and attrLegacy.has_value()) {
     attr.emplace(std::to_string(attrLegacy.value()));
   }
@@ -356,282 +399,127 @@ std::string ValidationData::fromBitsetToHexString(
 }
 
 entities::validation_response_t
-ValidationData::checkForCommonAuthSubscriptionRules(entities::Change& change) {
+ValidationData::checkForCommonAuthSubscriptionRules(
+    const entities::Change& change, const CorrelatedChange& related,
+    RuleErrors& errors) const {
   auto code = ::port::HTTP_CONFLICT;
 
   if (change.authSubscription.authSubscriptionStaticData.has_value()) {
-    auto authSubscriptionStaticData =
+    const auto& authSubscriptionStaticData =
         change.authSubscription.authSubscriptionStaticData.value();
-    auto authenticationMethod = authSubscriptionStaticData.authenticationMethod;
+    const auto& authenticationMethod =
+        authSubscriptionStaticData.authenticationMethod;
     auto isAuthenticatedMethodValid =
         (JSON_5G_AKA == authenticationMethod) ||
         (JSON_EAP_AKA_PRIME == authenticationMethod);
 
     if (!isAuthenticatedMethodValid) {
-      addError("Constraint Violation",
-               {{"resource_path", change.resourcePath},
-                {"description",
-                 "\"" + std::string{JSON_AUTHENTICATION_METHOD} + "\" in \"" +
-                     std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                     "\" has not the valid format"}});
+      errors.add(constraintViolation(change.resourcePath,
+                                     INVALID_AUTHENTICATION_METHOD));
     }
 
     auto isAuthenticationMethodAKA =
         (JSON_5G_AKA == authenticationMethod) ||
         (JSON_EAP_AKA_PRIME == authenticationMethod);
 
-    std::string legacyPath = getLegacyPathFromResourcePath(change.resourcePath);
-
-    auto has4GLegacy = false;
-    if (relatedResources.contains(legacyPath)) {
-      has4GLegacy = true;
-    }
-
-    if (authSubscriptionStaticData.encPermanentKey.has_value()) {
-      if (!checkPatternOnData(
-              encPermanentKeyRegex,
-              authSubscriptionStaticData.encPermanentKey.value())) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_ENC_PERMANENT_KEY} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid value"}});
-      } else if (authSubscriptionStaticData.encPermanentKey.value().length() !=
-                 LENGTH_ENC_PERMANENT_KEY) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_ENC_PERMANENT_KEY} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid size"}});
-      }
-    } else if (isAuthenticationMethodAKA and not has4GLegacy) {
-      addError(
-          "Constraint Violation",
-          {{"resource_path", change.resourcePath},
-           {"description",
-            "\"" + std::string{JSON_ENC_PERMANENT_KEY} + "\" in \"" +
-                std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                "\" has not been defined with an AKA authentication method"}});
-    }
-
-    if (authSubscriptionStaticData.authenticationManagementField.has_value()) {
-      if (!checkPatternOnData(authenticationManagementFieldRegex,
-                              authSubscriptionStaticData
-                                  .authenticationManagementField.value())) {
-        addError(
-            "Constraint Violation",
-            {{"resource_path", change.resourcePath},
-             {"description",
-              "\"" + std::string{JSON_AUTHENTICATION_MANAGEMENT_FIELD} +
-                  "\" in \"" + std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                  "\" has invalid value"}});
-      }
-    } else if (isAuthenticationMethodAKA and not has4GLegacy) {
-      addError(
-          "Constraint Violation",
-          {{"resource_path", change.resourcePath},
-           {"description",
-            "\"" + std::string{JSON_AUTHENTICATION_MANAGEMENT_FIELD} +
-                "\" in \"" + std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                "\" has not been defined with an AKA authentication method"}});
-    }
-
-    if (authSubscriptionStaticData.algorithmId.has_value()) {
-      if (!checkPatternOnData(algorithmIdRegex,
-                              authSubscriptionStaticData.algorithmId.value())) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_ALGORITHM_ID} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid value"}});
-      } else if (not checkAlgorithmIdInRange(
-                     authSubscriptionStaticData.algorithmId.value())) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_ALGORITHM_ID} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid value"}});
-      }
-    } else if (isAuthenticationMethodAKA and not has4GLegacy) {
-      addError(
-          "Constraint Violation",
-          {{"resource_path", change.resourcePath},
-           {"description",
-            "\"" + std::string{JSON_ALGORITHM_ID} + "\" in \"" +
-                std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                "\" has not been defined with an AKA authentication method"}});
-    }
-
-    if (authSubscriptionStaticData.a4KeyInd.has_value()) {
-      if (!checkPatternOnData(a4KeyIndRegex,
-                              authSubscriptionStaticData.a4KeyInd.value())) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_A4_KEY_IND} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid value"}});
-      } else if (not checkA4KeyIndInRange(
-                     authSubscriptionStaticData.a4KeyInd.value())) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_A4_KEY_IND} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid value"}});
-      }
-    } else if (isAuthenticationMethodAKA and not has4GLegacy) {
-      addError(
-          "Constraint Violation",
-          {{"resource_path", change.resourcePath},
-           {"description",
-            "\"" + std::string{JSON_A4_KEY_IND} + "\" in \"" +
-                std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                "\" has not been defined with an AKA authentication method"}});
-    }
-
-    if (authSubscriptionStaticData.a4Ind.has_value()) {
-      if (!checkPatternOnData(a4IndRegex,
-                              authSubscriptionStaticData.a4Ind.value())) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_A4_IND} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid value"}});
-      } else if (not checkA4IndInRange(
-                     authSubscriptionStaticData.a4Ind.value())) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_A4_IND} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid value"}});
-      }
-    } else if (isAuthenticationMethodAKA and not has4GLegacy) {
-      addError(
-          "Constraint Violation",
-          {{"resource_path", change.resourcePath},
-           {"description",
-            "\"" + std::string{JSON_A4_IND} + "\" in \"" +
-                std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                "\" has not been defined with an AKA authentication method"}});
-    }
-
-    if (authSubscriptionStaticData.encOpcKey.has_value()) {
-      if (!checkPatternOnData(encOpcKeyRegex,
-                              authSubscriptionStaticData.encOpcKey.value())) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_ENC_OPC_KEY} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid value"}});
-      } else if (not authSubscriptionStaticData.algorithmId.has_value()) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_ENC_OPC_KEY} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" must not be present as \"" +
-                       std::string{JSON_ALGORITHM_ID} +
-                       "\" is not MILLENAGE (0,2-15)"}});
-      } else if (checkPatternOnData(
-                     algorithmIdRegex,
-                     authSubscriptionStaticData.algorithmId.value())) {
-        if (!checkAlgorithmIdIsMillenage(
-                authSubscriptionStaticData.algorithmId.value())) {
-          addError("Constraint Violation",
-                   {{"resource_path", change.resourcePath},
-                    {"description",
-                     "\"" + std::string{JSON_ENC_OPC_KEY} + "\" in \"" +
-                         std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                         "\" must not be present as \"" +
-                         std::string{JSON_ALGORITHM_ID} +
-                         "\" is not MILLENAGE (0,2-15)"}});
-        }
-      }
-    }
-
-    if (authSubscriptionStaticData.a4KeyV.has_value() and
-        not checkPatternOnData(a4KeyVRegex,
-                               authSubscriptionStaticData.a4KeyV.value())) {
-      addError(
-          "Constraint Violation",
-          {{"resource_path", change.resourcePath},
-           {"description", "\"" + std::string{JSON_A4_KEY_V} + "\" in \"" +
-                               std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                               "\" has invalid value"}});
-    }
+    checkStaticDataFields(change,
+                          isAuthenticationMethodAKA and not related.legacy,
+                          errors);
 
     if (authSubscriptionStaticData.akaAlgorithmInd.has_value()) {
-      if (not checkPatternOnData(
-              akaAlgorithmIndRegex,
-              authSubscriptionStaticData.akaAlgorithmInd.value())) {
-        addError("Constraint Violation",
-                 {{"resource_path", change.resourcePath},
-                  {"description",
-                   "\"" + std::string{JSON_AKA_ALGORITHM_IND} + "\" in \"" +
-                       std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                       "\" has invalid value"}});
-      }
+      if (related.provJournal) {
+        auto imsiMask = getImsiMask(*related.provJournal);
 
-      auto mscId = getMscId(change.resourcePath);
-      auto pathToFind = buildProvJournalResourcePathFromMscId(mscId);
-      if (relatedResources.contains(pathToFind)) {
-        auto journal = boost::get<entities::prov_journal_t>(
-            relatedResources.at(pathToFind));
-
-        if (journal.imsiMask.empty() or
-            not checkBitIsSet(journal.imsiMask, POS_AUC_IN_IMSI_MASK)) {
-          addError(
-              "Constraint Violation",
-              {{"resource_path", change.resourcePath},
-               {"description",
-                "It is not allowed to create or update a subscriber with \"" +
-                    std::string{JSON_AKA_ALGORITHM_IND} + "\" in \"" +
-                    std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                    "\" if not defined in AuC"}});
+        if (imsiMask.empty() or
+            not checkBitIsSet(imsiMask, POS_AUC_IN_IMSI_MASK)) {
+          errors.add(constraintViolation(change.resourcePath,
+                                         AKA_ALGORITHM_IND_NOT_IN_AUC));
         }
       } else {
         code = ::port::HTTP_UNPROCESSABLE_ENTITY;
-        addError("Unprocessable entity",
-                 {{"resource_path", change.resourcePath},
-                  {"description", "provJournal for subscriber mscId=" + mscId +
-                                      " not included. Needed to check if user "
-                                      "is defined in AuC when attribute \"" +
-                                      std::string{JSON_AKA_ALGORITHM_IND} +
-                                      "\" is present"}});
+        errors.add(unprocessableEntity(change.resourcePath,
+                                       ErrorKind::PROV_JOURNAL_NOT_INCLUDED));
       }
     }
   }
 
   if (change.authSubscription.authSubscriptionDynamicData.has_value()) {
-    addError("Constraint Violation",
-             {{"resource_path", change.resourcePath},
-              {"description",
-               "\"" + std::string{JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA} +
-                   "\" can not be created or updated"}});
+    errors.add(
+        constraintViolation(change.resourcePath, DYNAMIC_DATA_NOT_WRITABLE));
   }
 
-  if (hasErrors()) {
+  if (errors.any()) {
     return {false, code};
   }
   return {true, ::port::HTTP_OK};
 }
 
+void ValidationData::checkStaticDataFields(const entities::Change& change,
+                                           bool akaWithout4GLegacy,
+                                           RuleErrors& errors) {
+  const auto& staticData =
+      change.authSubscription.authSubscriptionStaticData.value();
+  for (const auto& rule : STATIC_DATA_FIELD_RULES) {
+    if (auto error = checkField(rule, staticData, akaWithout4GLegacy)) {
+      errors.add(constraintViolation(change.resourcePath, error));
+    }
+  }
+}
+
+const char* ValidationData::checkField(
+    const FieldRule& rule, const auth_subscription_static_data_t& data,
+    bool akaWithout4GLegacy) {
+  const auto& field = data.*rule.field;
+  if (not field.has_value()) {
+    return rule.presence == FieldPresence::AKA and akaWithout4GLegacy
+               ? rule.notDefined
+               : nullptr;
+  }
+
+  const auto& value = field.value();
+  switch (rule.check) {
+    case FieldCheck::HEX:
+      if (not charclass::isHex(value) or
+          (rule.min != 0 and value.size() != std::size_t(rule.min))) {
+        return rule.invalidValue;
+      }
+      break;
+    case FieldCheck::HEX_OF_SIZE:
+      if (not charclass::isHex(value)) {
+        return rule.invalidValue;
+      }
+      if (value.size() != std::size_t(rule.min)) {
+        return rule.invalidSize;
+      }
+      break;
+    case FieldCheck::BOUNDED_INT:
+      if (not charclass::toBoundedInt(value, rule.min, rule.max)) {
+        return rule.invalidValue;
+      }
+      break;
+    case FieldCheck::CANONICAL_INT:
+      if (not charclass::toCanonicalInt(value, rule.min, rule.max)) {
+        return rule.invalidValue;
+      }
+      break;
+  }
+
+  if (rule.consistent and not rule.consistent(data)) {
+    return rule.inconsistent;
+  }
+  return nullptr;
+}
+
 entities::validation_response_t
-ValidationData::checkForCreationAuthSubscription(entities::Change& change) {
+ValidationData::checkForCreationAuthSubscription(
+    const entities::Change& change, const CorrelatedChange& related,
+    RuleErrors& errors) const {
   bool ret = true;
 
-  auto resp = checkForCommonAuthSubscriptionRules(change);
+  auto resp = checkForCommonAuthSubscriptionRules(change, related, errors);
   ret &= std::get<entities::VALIDATION>(resp);
   if (ret) {
-    ret &= checkForLegacyAuthSubscriptionRules(change);
+    ret &= checkForLegacyAuthSubscriptionRules(change, related, errors);
   }
 
   return {ret, ret ? port::HTTP_OK
@@ -640,23 +528,20 @@ ValidationData::checkForCreationAuthSubscription(entities::Change& change) {
 }
 
 entities::validation_response_t ValidationData::checkForUpdateAuthSubscription(
-    entities::Change& change) {
+    const entities::Change& change, const CorrelatedChange& related,
+    RuleErrors& errors) const {
   bool ret = true;
-  auto path = change.resourcePath;
-  auto basePath = ValidationData::getBasePath(path);
-
-  if (not hasRelatedResource(basePath)) {
-    addError("Unprocessable entity",
-             {{"resource_path", path},
-              {"description",
-               "There is no associated relatedResource: " + basePath}});
+  const auto& path = change.resourcePath;
+
+  if (not related.base) {
+    errors.add(unprocessableEntity(path, ErrorKind::NO_RELATED_RESOURCE));
     return {false, ::port::HTTP_UNPROCESSABLE_ENTITY};
   }
 
-  auto resp = checkForCommonAuthSubscriptionRules(change);
+  auto resp = checkForCommonAuthSubscriptionRules(change, related, errors);
   ret &= std::get<entities::VALIDATION>(resp);
   if (ret) {
-    ret &= checkForUpdateAuthSubscriptionRules(change);
+    ret &= checkForUpdateAuthSubscriptionRules(change, related, errors);
   }
 
   return {ret, ret ? port::HTTP_OK
@@ -665,81 +550,65 @@ entities::validation_response_t ValidationData::checkForUpdateAuthSubscription(
 }
 
 bool ValidationData::checkForUpdateAuthSubscriptionRules(
-    entities::Change& change) {
+    const entities::Change& change, const CorrelatedChange& related,
+    RuleErrors& errors) const {
   bool ret = true;
-  auto authSubscriptionStaticData =
+  const auto& authSubscriptionStaticData =
       change.authSubscription.authSubscriptionStaticData.value();
 
-  auto authSubsResourcePath = ValidationData::getBasePath(change.resourcePath);
-
-  if (relatedResources.contains(authSubsResourcePath)) {
-    auto authSubscriptionRelResource =
-        boost::get<entities::auth_subscription_t>(
-            relatedResources.at(authSubsResourcePath));
-    auto authSubscriptionStaticDataRelResource =
-        authSubscriptionRelResource.authSubscriptionStaticData.value();
+  if (auto authSubscriptionRelResource =
+          std::get_if<entities::auth_subscription_t>(related.base)) {
+    const auto& authSubscriptionStaticDataRelResource =
+        authSubscriptionRelResource->authSubscriptionStaticData.value();
 
     ret &= optionalAttributeHasChanged(
         authSubscriptionStaticData.encPermanentKey,
         authSubscriptionStaticDataRelResource.encPermanentKey,
-        change.resourcePath, std::string{JSON_ENC_PERMANENT_KEY});
+        change.resourcePath, JSON_ENC_PERMANENT_KEY, errors);
     ret &= optionalAttributeHasChanged(
         authSubscriptionStaticData.algorithmId,
         authSubscriptionStaticDataRelResource.algorithmId, change.resourcePath,
-        std::string{JSON_ALGORITHM_ID});
+        JSON_ALGORITHM_ID, errors);
     ret &= optionalAttributeHasChanged(
         authSubscriptionStaticData.a4KeyInd,
         authSubscriptionStaticDataRelResource.a4KeyInd, change.resourcePath,
-        std::string{JSON_A4_KEY_IND});
+        JSON_A4_KEY_IND, errors);
     ret &= optionalAttributeHasChanged(
         authSubscriptionStaticData.a4Ind,
         authSubscriptionStaticDataRelResource.a4Ind, change.resourcePath,
-        std::string{JSON_A4_IND});
+        JSON_A4_IND, errors);
     ret &= optionalAttributeHasChanged(
         authSubscriptionStaticData.encOpcKey,
         authSubscriptionStaticDataRelResource.encOpcKey, change.resourcePath,
-        std::string{JSON_ENC_OPC_KEY});
+        JSON_ENC_OPC_KEY, errors);
     ret &= optionalAttributeHasChanged(
         authSubscriptionStaticData.a4KeyV,
         authSubscriptionStaticDataRelResource.a4KeyV, change.resourcePath,
-        std::string{JSON_A4_KEY_V});
+        JSON_A4_KEY_V, errors);
   }
 
   return ret;
 }
 
-std::string ValidationData::getLegacyPathFromResourcePath(
-    const std::string& path) {
-  return std::string{LEGACY_BASE_PATH}.append(getImsi(path));
-}
-
 bool ValidationData::checkForLegacyAuthSubscriptionRules(
-    entities::Change& change) {
+    const entities::Change& change, const CorrelatedChange& related,
+    RuleErrors& errors) const {
   bool ret = true;
 
-  std::string legacyPath = getLegacyPathFromResourcePath(change.resourcePath);
-
-  if (relatedResources.contains(legacyPath)) {
-    auto authSubscriptionLegacyRelResource =
-        boost::get<entities::auth_subscription_legacy_t>(
-            relatedResources.at(legacyPath));
+  if (auto legacy =
+          std::get_if<entities::auth_subscription_legacy_t>(related.legacy)) {
+    const auto& authSubscriptionLegacyRelResource = *legacy;
 
     // Legacy.AKATYPE must be defined with value 1
     if (not authSubscriptionLegacyRelResource.akaType.has_value()) {
       ret = false;
-      addError("Constraint Violation",
-               {{"resource_path", change.resourcePath},
-                {"description",
-                 "\"" + std::string{JSON_AKA_TYPE} +
-                     "\" for 4G legacy subscription is not defined"}});
+      errors.add(constraintViolation(change.resourcePath,
+                                     LEGACY_AKA_TYPE_NOT_DEFINED));
     } else if (authSubscriptionLegacyRelResource.akaType.value() !=
                AKATYPE_ALLOWED_VALUE) {
       ret = false;
-      addError("Constraint Violation",
-               {{"resource_path", change.resourcePath},
-                {"description",
-                 "\"" + std::string{JSON_AKA_TYPE} +
-                     "\" for 4G legacy subscription has an invalid value"}});
+      errors.add(
+          constraintViolation(change.resourcePath, LEGACY_AKA_TYPE_INVALID));
     }
 
     if (change.authSubscription.authSubscriptionStaticData.has_value()) {
@@ -748,26 +617,26 @@ bool ValidationData::checkForLegacyAuthSubscriptionRules(
           change.authSubscription.authSubscriptionStaticData.value()
               .encPermanentKey,
           authSubscriptionLegacyRelResource.eki, change.resourcePath,
-          std::string{JSON_ENC_PERMANENT_KEY}, std::string{JSON_EKI});
+          JSON_ENC_PERMANENT_KEY, JSON_EKI, errors);
 
       // If a4KeyInd is defined, it must be equal to legacy.KIND
       ret &= checkOptionalAttributeWithLegacy(
           change.authSubscription.authSubscriptionStaticData.value().a4KeyInd,
           authSubscriptionLegacyRelResource.kind, change.resourcePath,
-          std::string{JSON_A4_KEY_IND}, std::string{JSON_KIND});
+          JSON_A4_KEY_IND, JSON_KIND, errors);
 
       // If a4Ind is defined, it must be equal to legacy.A4IND
       ret &= checkOptionalAttributeWithLegacy(
           change.authSubscription.authSubscriptionStaticData.value().a4Ind,
           authSubscriptionLegacyRelResource.a4Ind, change.resourcePath,
-          std::string{JSON_A4_IND}, std::string{JSON_A4_IND_LEGACY});
+          JSON_A4_IND, JSON_A4_IND_LEGACY, errors);
 
       // If algorithmId is defined, it must be equal to legacy.FSETIND
       ret &= checkOptionalAttributeWithLegacy(
           change.authSubscription.authSubscriptionStaticData.value()
               .algorithmId,
           authSubscriptionLegacyRelResource.fSetInd, change.resourcePath,
-          std::string{JSON_ALGORITHM_ID}, std::string{JSON_F_SET_IND});
+          JSON_ALGORITHM_ID, JSON_F_SET_IND, errors);
 
       // If authenticationManagementField is defined, it must be equal to
       // legacy.AMFVALUE
@@ -781,22 +650,23 @@ bool ValidationData::checkForLegacyAuthSubscriptionRules(
         ret &= checkOptionalAttributeWithLegacy(
             value, authSubscriptionLegacyRelResource.amfValue,
             change.resourcePath,
-            std::string{JSON_AUTHENTICATION_MANAGEMENT_FIELD},
-            std::string{JSON_AMF_VALUE});
+            JSON_AUTHENTICATION_MANAGEMENT_FIELD,
+            JSON_AMF_VALUE, errors);
       }
 
       // If encOpcKey is defined, it must be equal to legacy.EOPC
       ret &= checkOptionalAttributeWithLegacy(
           change.authSubscription.authSubscriptionStaticData.value().encOpcKey,
           authSubscriptionLegacyRelResource.eopc, change.resourcePath,
-          std::string{JSON_ENC_OPC_KEY}, std::string{JSON_EOPC});
+          JSON_ENC_OPC_KEY, JSON_EOPC, errors);
 
       // If akaAlgorithmInd is defined, it must be equal to legacy.AKAALGIND
       ret &= checkOptionalAttributeWithLegacy(
           change.authSubscription.authSubscriptionStaticData.value()
               .akaAlgorithmInd,
           authSubscriptionLegacyRelResource.akaAlgInd, change.resourcePath,
-          std::string{JSON_AKA_ALGORITHM_IND}, std::string{JSON_AKA_ALG_IND});
+          JSON_AKA_ALGORITHM_IND, JSON_AKA_ALG_IND,
+          errors);
     }
   }
 
@@ -804,33 +674,28 @@ bool ValidationData::checkForLegacyAuthSubscriptionRules(
 }
 
 bool ValidationData::checkOptionalAttributeWithLegacy(
-    std::optional<std::string> attr,
+    const std::optional<std::string>& attr,
     const std::optional<std::string>& attrLegacy,
-    const std::string& resourcePath, const std::string& attrName,
-    const std::string& attrLegacyName) {
+    const std::string& resourcePath, std::string_view attrName,
+    std::string_view attrLegacyName, RuleErrors& errors) {
   if (attr.has_value() && attrLegacy.has_value() &&
       attr.value().compare(attrLegacy.value())) {
-    addError("Constraint Violation",
-             {{"resource_path", resourcePath},
-              {"description", "\"" + attrName + "\" is not equal to \"" +
-                                  attrLegacyName +
-                                  "\" attribute of 4G legacy subscription"}});
+    errors.add(constraintViolation(resourcePath, ErrorKind::NOT_EQUAL_TO_LEGACY,
+                                   attrName, attrLegacyName));
     return false;
   }
   return true;
 }
 
 bool ValidationData::checkOptionalAttributeWithLegacy(
-    std::optional<std::string> attr, const std::optional<int>& attrLegacy,
-    const std::string& resourcePath, const std::string& attrName,
-    const std::string& attrLegacyName) {
+    const std::optional<std::string>& attr,
+    const std::optional<int>& attrLegacy,
+    const std::string& resourcePath, std::string_view attrName,
+    std::string_view attrLegacyName, RuleErrors& errors) {
   if (attr.has_value() && attrLegacy.has_value() &&
       attr.value().compare(std::to_string(attrLegacy.value()))) {
-    addError("Constraint Violation",
-             {{"resource_path", resourcePath},
-              {"description", "\"" + attrName + "\" is not equal to \"" +
-                                  attrLegacyName +
-                                  "\" attribute of 4G legacy subscription"}});
+    errors.add(constraintViolation(resourcePath, ErrorKind::NOT_EQUAL_TO_LEGACY,
+                                   attrName, attrLegacyName));
     return false;
   }
   return true;
@@ -838,60 +703,43 @@ bool ValidationData::checkOptionalAttributeWithLegacy(
 
 bool ValidationData::checkOptionalAttributeWithLegacy(
     unsigned int attr, const std::optional<int>& attrLegacy,
-    const std::string& resourcePath, const std::string& attrName,
-    const std::string& attrLegacyName) {
+    const std::string& resourcePath, std::string_view attrName,
+    std::string_view attrLegacyName, RuleErrors& errors) {
   if (attrLegacy.has_value() && attr != (unsigned int)attrLegacy.value()) {
-    addError("Constraint Violation",
-             {{"resource_path", resourcePath},
-              {"description", "\"" + attrName + "\" is not equal to \"" +
-                                  attrLegacyName +
-                                  "\" attribute of 4G legacy subscription"}});
+    errors.add(constraintViolation(resourcePath, ErrorKind::NOT_EQUAL_TO_LEGACY,
+                                   attrName, attrLegacyName));
     return false;
   }
   return true;
 }
 
 bool ValidationData::optionalAttributeHasChanged(
-    std::optional<std::string> newValue, std::optional<std::string> oldValue,
-    const std::string& resourcePath, const std::string& attrName) {
+    const std::optional<std::string>& newValue,
+    const std::optional<std::string>& oldValue,
+    const std::string& resourcePath, std::string_view attrName,
+    RuleErrors& errors) {
   if ((newValue.has_value() && not oldValue.has_value()) ||
       (not newValue.has_value() && oldValue.has_value())) {
-    addError(
-        "Constraint Violation",
-        {{"resource_path", resourcePath},
-         {"description", "\"" + attrName + "\" in \"" +
-                             std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                             "\" cannot be modified"}});
+    errors.add(constraintViolation(resourcePath, ErrorKind::CANNOT_BE_MODIFIED,
+                                   attrName));
     return false;
   } else if (newValue.has_value() && oldValue.has_value() &&
              newValue.value().compare(oldValue.value())) {
-    addError(
-        "Constraint Violation",
-        {{"resource_path", resourcePath},
-         {"description", "\"" + attrName + "\" in \"" +
-                             std::string{JSON_AUTH_SUBSCRIPTION_STATIC_DATA} +
-                             "\" cannot be modified"}});
+    errors.add(constraintViolation(resourcePath, ErrorKind::CANNOT_BE_MODIFIED,
+                                   attrName));
     return false;
   }
   return true;
 }
 
-void ValidationData::addError(
-    std::string message,
-    std::initializer_list<std::pair<std::string, std::string>> args) {
-  entities::Error err;
-  err.errorMessage = message;
-  for (auto& i : args) {
-    err.errorDetails.insert(i);
+std::string_view ValidationData::getImsiMask(
+    const entities::resource_t& resource) {
+  // Journals parsed in situ are borrowed from the request body
+  if (auto journal = std::get_if<entities::prov_journal_t>(&resource)) {
+    return journal->imsiMask;
   }
-  response.errors.push_back(err);
+  return std::get<entities::prov_journal_view_t>(resource).imsiMask;
 }
 
-bool ValidationData::hasRelatedResource(entities::resource_path_t& path) {
-  if (relatedResources.contains(path)) {
-    return true;
-  }
-  return false;
-}
 
 }  // namespace entities
@@ -1,50 +1,47 @@
 #ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_VALIDATION_DATA__
 #define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_VALIDATION_DATA__
 
-#include <boost/regex.hpp>
+#include <bitset>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
 
+#include "entities/PathRoute.hpp"
+#include "entities/WorkerPool.hpp"
 #include "entities/types.hpp"
 
 namespace entities {
 
+// Resource path grammar. Paths are classified by PathRoute, which matches
+// these patterns in a single pass.
 auto constexpr AUTH_SUBSCRIPTION_URI_PATTERN =
     "^/subscribers/(.*?)/authSubscription$";
-static const auto authSubscriptionUriRegex =
-    boost::regex{AUTH_SUBSCRIPTION_URI_PATTERN};
 auto constexpr AUTH_SUBSCRIPTION_PRIV_ID_URI_PATTERN =
     "^/subscribers/(.*?)/authSubscription/[^/]*$";
-static const auto authSubscriptionPrivIdUriRegex =
-    boost::regex{AUTH_SUBSCRIPTION_PRIV_ID_URI_PATTERN};
 auto constexpr AUTH_SUBSCRIPTION_STATIC_DATA_URI_PATTERN =
     "^/subscribers/(.*?)/authSubscription/(.*?)/authSubscriptionStaticData$";
-static const auto authSubscriptionStaticDataUriRegex =
-    boost::regex{AUTH_SUBSCRIPTION_STATIC_DATA_URI_PATTERN};
 auto constexpr IMSI_PATTERN =
     "^/subscribers/(.*?)/authSubscription/imsi-([0-9]{5,15})$|^/subscribers/"
     "(.*?)/authSubscription/imsi-([0-9]{5,15})/[^/]*$";
-static const auto imsiRegex = boost::regex{IMSI_PATTERN};
 auto constexpr POS_IMSI = 4;
 auto constexpr LEGACY_BASE_PATH = "/legacy/serv=Auth/IMSI=";
+auto constexpr PROV_JOURNAL_PATH_PREFIX = "/subscribers/";
+auto constexpr PROV_JOURNAL_PATH_SUFFIX = "/journal/provJournal";
 auto constexpr LEGACY_PATTERN = "^/legacy/serv=Auth/[^/]*$";
-static const auto legacyRegex = boost::regex{LEGACY_PATTERN};
+// Static data field grammar. Fields are checked by entities::charclass, which
+// gives the same results as a full match of these patterns.
 auto constexpr ENC_PERMANENT_KEY_PATTERN = "^[A-Fa-f0-9]*$";
-static const auto encPermanentKeyRegex =
-    boost::regex{ENC_PERMANENT_KEY_PATTERN};
 auto constexpr AUTHENTICATION_MANAGEMENT_FIELD_PATTERN = "^[A-Fa-f0-9]{4}$";
-static const auto authenticationManagementFieldRegex =
-    boost::regex{AUTHENTICATION_MANAGEMENT_FIELD_PATTERN};
+auto constexpr AUTHENTICATION_MANAGEMENT_FIELD_LENGTH = 4;
 auto constexpr ALGORITHM_ID_PATTERN = "^[0-9]+$";
-static const auto algorithmIdRegex = boost::regex{ALGORITHM_ID_PATTERN};
 auto constexpr A4_KEY_IND_PATTERN = "^[0-9]+$";
-static const auto a4KeyIndRegex = boost::regex{A4_KEY_IND_PATTERN};
 auto constexpr A4_KEY_IND_MIN = 0;
 auto constexpr A4_KEY_IND_MAX = 511;
 auto constexpr A4_IND_PATTERN = "^[0-9]+$";
-static const auto a4IndRegex = boost::regex{A4_IND_PATTERN};
 auto constexpr A4_IND_MIN = 0;
 auto constexpr A4_IND_MAX = 2;
 auto constexpr ENC_OPC_KEY_PATTERN = "^[A-Fa-f0-9]*$";
-static const auto encOpcKeyRegex = boost::regex{ENC_OPC_KEY_PATTERN};
 auto constexpr MIN_TUAK = 16;
 auto constexpr MAX_TUAK = 31;
 auto constexpr MIN_ALGORITHM_ID = 0;
@@ -56,10 +53,11 @@ auto constexpr SEQHE_INVALID_VALUE = "FFFFFFFFFFFF";
 auto constexpr SEQHE_BITS_LENGTH = 48;
 auto constexpr BITS_PER_CHAR = 4;
 auto constexpr A4_KEY_V_PATTERN = "^[0-9]$|^[1-2][0-9]$|^[3][0-1]$";
-static const auto a4KeyVRegex = boost::regex{A4_KEY_V_PATTERN};
+auto constexpr A4_KEY_V_MIN = 0;
+auto constexpr A4_KEY_V_MAX = 31;
 auto constexpr AKA_ALGORITHM_IND_PATTERN = "^[0-2]$";
-static const auto akaAlgorithmIndRegex =
-    boost::regex{AKA_ALGORITHM_IND_PATTERN};
+auto constexpr AKA_ALGORITHM_IND_MIN = 0;
+auto constexpr AKA_ALGORITHM_IND_MAX = 2;
 static const auto POS_MSCID = 1;
 static const auto POS_AUC_IN_IMSI_MASK = 4;  // 0 is the least significative
 
@@ -70,6 +68,24 @@ auto constexpr SQN_SCHEME_TIME_BASED = "TIME_BASED";
 auto constexpr VALIDATION = 0;
 auto constexpr CODE = 1;
 
+struct FieldRule;
+
+// Errors found by the rules of one change. The rules of a change also depend
+// on whether the changes before it had errors
+class RuleErrors final {
+ public:
+  explicit RuleErrors(bool earlierErrors) : earlierErrors{earlierErrors} {}
+  ~RuleErrors() = default;
+
+  inline void add(Error &&error) { errors.push_back(std::move(error)); }
+  inline bool any() const { return earlierErrors or not errors.empty(); }
+
+  errors_t errors;
+
+ private:
+  bool earlierErrors;
+};
+
 class ValidationData final {
  public:
   ValidationData() = default;
@@ -78,18 +94,18 @@ class ValidationData final {
   ~ValidationData() = default;
 
   entities::validation_response_t applyValidationRules();
-  void addError(std::string,
-                std::initializer_list<std::pair<std::string, std::string>>);
+  // Same result, with the rules of the changes applied in parallel over the
+  // workers when there are at least minParallelChanges of them. The changes
+  // after the first one with errors are applied twice when their rules
+  // depend on it. Fewer changes are applied one after the other, with a
+  // preemption point of the workers between two of them
+  entities::validation_response_t applyValidationRules(
+      WorkerPool &, std::size_t minParallelChanges);
+  inline void addError(Error &&error) {
+    response.errors.push_back(std::move(error));
+  }
   inline bool hasErrors();
   inline std::string emptyFieldError(const std::string &);
-  inline std::string unfoundMandatoryFieldError(const std::string &);
-  inline std::string unfoundMandatoryFieldError(const std::string &,
-                                                const std::string &);
-  inline std::string notObjectFieldError(const std::string &);
-  inline std::string notArrayFieldError(const std::string &);
-  inline std::string notStringFieldError(const std::string &);
-  inline std::string notIntFieldError(const std::string &);
-  inline std::string notBoolFieldError(const std::string &);
   static bool checkAuthSubscriptionUri(const std::string &);
   static bool checkAuthSubscriptionStaticDataUri(const std::string &);
   static bool checkAuthSubscriptionPrivIdUri(const std::string &);
@@ -97,6 +113,7 @@ class ValidationData final {
   static bool checkAuthSubscriptionLegacyUri(const std::string &);
   static std::string getImsi(const std::string &);
   inline static std::string getBasePath(const std::string &);
+  inline static std::string_view getBasePathView(std::string_view);
   inline static std::string createPathFromBasePath(
       const std::string &, const std::string & = std::string());
   inline static std::string addSuffixToPath(const std::string &,
@@ -110,54 +127,105 @@ class ValidationData final {
   static std::string fromBitsetToHexString(const std::bitset<48> &);
   static std::string getMscId(const std::string &);
   static std::string buildProvJournalResourcePathFromMscId(const std::string &);
-  static bool checkBitIsSet(const std::string &, const int);
+  static bool checkBitIsSet(std::string_view, const int);
 
   changes_t changes;
   related_resources_t relatedResources;
   response_t response;
 
  private:
+  // Branch of the rules a change goes through
+  enum class ChangeRule {
+    AUTH_SUBSCRIPTION,
+    STATIC_DATA,
+    INVALID_IMSI,
+    DYNAMIC_DATA,
+    UNPROCESSABLE,
+    DELETE
+  };
+
+  // What the rules give for one change on its own. The changes of a request
+  // are then merged in order
+  struct ChangeOutcome {
+    ChangeRule rule{ChangeRule::DELETE};
+    entities::validation_response_t resp{true, 0};
+    errors_t errors;
+    // Response change, with its mutations, when the change is valid
+    std::optional<entities::Change> change;
+    bool dependsOnEarlierErrors{false};
+  };
+
+  // A change with the related resources its rules read, looked up once for
+  // the request so that no rule builds or looks up a path. Null when absent
+  struct CorrelatedChange {
+    PathRoute route;
+    // at LEGACY_BASE_PATH and the IMSI
+    const resource_t *legacy{nullptr};
+    // at the provJournal path of the mscId
+    const resource_t *provJournal{nullptr};
+    // at the base path of the change, i.e. its authSubscription
+    const resource_t *base{nullptr};
+    // at the path of the change
+    const resource_t *current{nullptr};
+  };
+
+  // Validation and code of the changes merged so far
+  struct MergedOutcome {
+    bool validation;
+    int code;
+  };
+
+  std::vector<CorrelatedChange> correlateChanges() const;
+  // No preemption point without workers
+  entities::validation_response_t applySequentially(WorkerPool *);
+  ChangeOutcome applyChangeRules(const entities::Change &,
+                                 const CorrelatedChange &,
+                                 bool earlierErrors) const;
+  void mergeChangeOutcome(ChangeOutcome &&, MergedOutcome &);
   entities::validation_response_t checkForCreationAuthSubscription(
-      entities::Change &);
+      const entities::Change &, const CorrelatedChange &, RuleErrors &) const;
   entities::validation_response_t checkForUpdateAuthSubscription(
-      entities::Change &);
+      const entities::Change &, const CorrelatedChange &, RuleErrors &) const;
   entities::validation_response_t checkForCommonAuthSubscriptionRules(
-      entities::Change &);
-  bool checkForUpdateAuthSubscriptionRules(entities::Change &);
-  bool checkForLegacyAuthSubscriptionRules(entities::Change &);
-  static bool checkPatternOnData(const boost::regex &, const std::string &);
-  static bool checkA4IndInRange(const std::string &);
-  static bool checkA4KeyIndInRange(const std::string &);
-  static bool checkAlgorithmIdInRange(const std::string &);
-  static bool checkAlgorithmIdIsMillenage(const std::string &);
-  void computeMutations(entities::Change &);
-  bool optionalAttributeHasChanged(std::optional<std::string>,
-                                   std::optional<std::string>,
-                                   const std::string &, const std::string &);
-  bool checkOptionalAttributeWithLegacy(std::optional<std::string>,
-                                        const std::optional<std::string> &,
-                                        const std::string &,
-                                        const std::string &,
-                                        const std::string &);
-  bool checkOptionalAttributeWithLegacy(std::optional<std::string>,
-                                        const std::optional<int> &,
-                                        const std::string &,
-                                        const std::string &,
-                                        const std::string &);
-  bool checkOptionalAttributeWithLegacy(unsigned int,
-                                        const std::optional<int> &,
-                                        const std::string &,
-                                        const std::string &,
-                                        const std::string &);
-  std::string getLegacyPathFromResourcePath(const std::string &);
+      const entities::Change &, const CorrelatedChange &, RuleErrors &) const;
+  bool checkForUpdateAuthSubscriptionRules(const entities::Change &,
+                                           const CorrelatedChange &,
+                                           RuleErrors &) const;
+  bool checkForLegacyAuthSubscriptionRules(const entities::Change &,
+                                           const CorrelatedChange &,
+                                           RuleErrors &) const;
+  // STATIC_DATA_FIELD_RULES, in StaticDataRules.hpp
+  static void checkStaticDataFields(const entities::Change &,
+                                    bool akaWithout4GLegacy, RuleErrors &);
+  static const char *checkField(const FieldRule &,
+                                const auth_subscription_static_data_t &,
+                                bool akaWithout4GLegacy);
+  void computeMutations(entities::Change &, const CorrelatedChange &) const;
+  // Attribute names are views of constants, which errors refer to
+  static bool optionalAttributeHasChanged(const std::optional<std::string> &,
+                                          const std::optional<std::string> &,
+                                          const std::string &,
+                                          std::string_view, RuleErrors &);
+  static bool checkOptionalAttributeWithLegacy(
+      const std::optional<std::string> &, const std::optional<std::string> &,
+      const std::string &, std::string_view, std::string_view, RuleErrors &);
+  static bool checkOptionalAttributeWithLegacy(
+      const std::optional<std::string> &, const std::optional<int> &,
+      const std::string &, std::string_view, std::string_view, RuleErrors &);
+  static bool checkOptionalAttributeWithLegacy(unsigned int,
+                                               const std::optional<int> &,
+                                               const std::string &,
+                                               std::string_view,
+                                               std::string_view, RuleErrors &);
   void fillOptionalAuthSubscriptionStaticAttributes(
-      entities::Change &, const entities::auth_subscription_legacy_t &);
+      entities::Change &, const entities::auth_subscription_legacy_t &) const;
+  void fillOptionalAttribute(std::optional<std::string> &,
+                             const std::optional<std::string> &) const;
   void fillOptionalAttribute(std::optional<std::string> &,
-                             const std::optional<std::string> &);
-  void fillOptionalAttribute(std::optional<std::string> &, const std::string &);
+                             const std::string &) const;
   void fillOptionalAttribute(std::optional<std::string> &,
-                             const std::optional<int> &);
-  bool hasRelatedResource(entities::resource_path_t &);
+                             const std::optional<int> &) const;
+  static std::string_view getImsiMask(const entities::resource_t &);
 };
 
 bool ValidationData::hasErrors() { return response.errors.size(); }
@@ -166,42 +234,15 @@ std::string ValidationData::emptyFieldError(const std::string &field) {
   return "Field:[" + field + "] is empty";
 }
 
-std::string ValidationData::unfoundMandatoryFieldError(
-    const std::string &field) {
-  return "Mandatory field:[" + field + "] not found";
-}
-
-std::string ValidationData::unfoundMandatoryFieldError(
-    const std::string &field, const std::string &parent) {
-  return "Mandatory field:[" + field + "] not found as child of:[" + parent +
-         "]";
-}
-
-std::string ValidationData::notObjectFieldError(const std::string &field) {
-  return "Field:[" + field + "] is not an object";
-}
-
-std::string ValidationData::notArrayFieldError(const std::string &field) {
-  return "Field:[" + field + "] is not an array";
-}
-
-std::string ValidationData::notStringFieldError(const std::string &field) {
-  return "Field:[" + field + "] is not string";
-}
-
-std::string ValidationData::notIntFieldError(const std::string &field) {
-  return "Field:[" + field + "] is not integer";
-}
-
-std::string ValidationData::notBoolFieldError(const std::string &field) {
-  return "Field:[" + field + "] is not boolean";
-}
-
 std::string ValidationData::getBasePath(const std::string &path) {
   std::size_t found = path.find_last_of("/");
   return path.substr(0, found);
 }
 
+std::string_view ValidationData::getBasePathView(std::string_view path) {
+  return path.substr(0, path.find_last_of('/'));
+}
+
 std::string ValidationData::createPathFromBasePath(const std::string &path,
                                                    const std::string &suffix) {
   std::string basePath = getBasePath(path);
@@ -0,0 +1,168 @@
+#include "entities/WorkerPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace entities {
+
+namespace {
+
+// Priority of the task the thread runs. Threads out of the workers count as
+// interactive
+thread_local Priority running = Priority::INTERACTIVE;
+
+// Sets the priority of the thread for the life of a task
+class RunningAs final {
+ public:
+  explicit RunningAs(Priority priority) : previous{running} {
+    running = priority;
+  }
+  RunningAs(const RunningAs &) = delete;
+  ~RunningAs() { running = previous; }
+
+ private:
+  const Priority previous;
+};
+
+// Shared with the helper tasks, which may only start once every index has
+// been taken: they find none left and just return
+struct ParallelFor final {
+  ParallelFor(WorkerPool &pool, std::size_t n,
+              const std::function<void(std::size_t)> &fn)
+      : pool{pool}, n{n}, fn{fn} {}
+
+  void run() {
+    for (auto i = next++; i < n; i = next++) {
+      fn(i);
+      if (++done == n) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cond.notify_all();
+      }
+      pool.preemptionPoint();
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this]() { return done == n; });
+  }
+
+  WorkerPool &pool;
+  const std::size_t n;
+  const std::function<void(std::size_t)> fn;
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> done{0};
+  std::mutex mutex;
+  std::condition_variable cond;
+};
+
+}  // namespace
+
+WorkerPool::WorkerPool(std::size_t threads, std::size_t queueSize,
+                       std::size_t interactiveWeight)
+    : interactiveWeight{interactiveWeight},
+      interactive{queueSize},
+      bulk{queueSize},
+      bells{interactive.capacity() + bulk.capacity()} {
+  if (threads == 0) {
+    threads = 1;
+  }
+  workers.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.emplace_back(&WorkerPool::run, this);
+  }
+}
+
+WorkerPool::~WorkerPool() { stop(); }
+
+bool WorkerPool::submit(task_t &&task, Priority priority) {
+  if (bells.isClosed() or not queueOf(priority).tryPush(std::move(task))) {
+    return false;
+  }
+  // The bells only fill up with the ones of preempted tasks, which already
+  // wake up enough workers for this task
+  bells.tryPush(1);
+  return true;
+}
+
+void WorkerPool::preemptionPoint() {
+  if (running != Priority::BULK) {
+    return;
+  }
+  RunningAs preempting{Priority::INTERACTIVE};
+  task_t task;
+  while (interactive.tryPop(task)) {
+    task();
+    task = nullptr;
+  }
+}
+
+void WorkerPool::stop() {
+  bells.close();
+  for (auto &worker : workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void WorkerPool::parallelFor(std::size_t n,
+                             const std::function<void(std::size_t)> &fn) {
+  if (n == 0) {
+    return;
+  }
+  auto loop = std::make_shared<ParallelFor>(*this, n, fn);
+  auto helpers = std::min(n - 1, threads());
+  for (std::size_t i = 0; i < helpers; ++i) {
+    if (not submit([loop]() { loop->run(); }, running)) {
+      break;
+    }
+  }
+  loop->run();
+  loop->wait();
+}
+
+bool WorkerPool::takeNext(task_t &task, Priority &priority,
+                          std::size_t &streak) {
+  if (streak < interactiveWeight and interactive.tryPop(task)) {
+    priority = Priority::INTERACTIVE;
+    ++streak;
+    return true;
+  }
+  if (bulk.tryPop(task)) {
+    priority = Priority::BULK;
+    streak = 0;
+    return true;
+  }
+  if (interactive.tryPop(task)) {
+    priority = Priority::INTERACTIVE;
+    ++streak;
+    return true;
+  }
+  return false;
+}
+
+void WorkerPool::run() {
+  task_t task;
+  Priority priority;
+  std::size_t streak = 0;
+  std::uint8_t bell;
+  while (bells.pop(bell)) {
+    if (takeNext(task, priority, streak)) {
+      RunningAs runningAs{priority};
+      task();
+      task = nullptr;
+    }
+  }
+  // Tasks pushed while the pool stopped, or whose bell was lost
+  while (takeNext(task, priority, streak)) {
+    RunningAs runningAs{priority};
+    task();
+    task = nullptr;
+  }
+}
+
+}  // namespace entities
@@ -0,0 +1,94 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_WORKER_POOL__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_WORKER_POOL__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "entities/mpmcqueue.hpp"
+
+namespace entities {
+
+// Classes of the traffic the workers serve, interactive first
+enum class Priority : std::uint8_t { INTERACTIVE, BULK };
+
+inline constexpr std::array<std::string_view, 2> PRIORITY_NAMES{"interactive",
+                                                                "bulk"};
+
+// Fixed set of threads running the tasks pushed to bounded lock-free queues,
+// one per priority, so the HTTP/2 I/O thread only hands requests over and
+// keeps serving frames. Each queue is dequeued in submission order; a full
+// queue is reported to the caller instead of blocking it. Queue sizes are
+// rounded up to a power of two.
+// Workers take interactive tasks first, and a bulk one every
+// interactiveWeight interactive ones when both are waiting, so bulk work is
+// not starved. Bulk work is also preempted between its changes: it runs the
+// interactive tasks waiting at its preemption points
+class WorkerPool final {
+ public:
+  using task_t = std::function<void()>;
+
+  static constexpr std::size_t DEFAULT_THREADS = 2;
+  static constexpr std::size_t DEFAULT_QUEUE_SIZE = 1024;
+  static constexpr std::size_t DEFAULT_INTERACTIVE_WEIGHT = 16;
+
+  WorkerPool() : WorkerPool(DEFAULT_THREADS, DEFAULT_QUEUE_SIZE) {}
+  WorkerPool(std::size_t threads, std::size_t queueSize,
+             std::size_t interactiveWeight = DEFAULT_INTERACTIVE_WEIGHT);
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+  ~WorkerPool();
+
+  // Returns false when the queue of the priority is full or the pool is
+  // stopped
+  bool submit(task_t &&, Priority = Priority::INTERACTIVE);
+
+  // Called by bulk work between two of its changes: the interactive tasks
+  // waiting run first, on the calling thread. Does nothing out of bulk work
+  void preemptionPoint();
+
+  // Runs the pending tasks and joins the threads. It is idempotent
+  void stop();
+
+  // Runs fn(0) ... fn(n - 1) on the calling thread and on the workers that
+  // are free, and returns once every call is over. The caller takes part, so
+  // a busy, full or stopped pool only makes it slower, and a task may call it.
+  // fn must not throw. The helpers have the priority of the caller, and the
+  // loop is a preemption point between two calls
+  void parallelFor(std::size_t n, const std::function<void(std::size_t)> &fn);
+
+  inline std::size_t threads() const { return workers.size(); }
+  inline std::size_t pending() const {
+    return interactive.sizeApprox() + bulk.sizeApprox();
+  }
+  inline std::size_t pending(Priority priority) const {
+    return queueOf(priority).sizeApprox();
+  }
+
+ private:
+  inline MpmcQueue<task_t> &queueOf(Priority priority) {
+    return priority == Priority::BULK ? bulk : interactive;
+  }
+  inline const MpmcQueue<task_t> &queueOf(Priority priority) const {
+    return priority == Priority::BULK ? bulk : interactive;
+  }
+  // Next task for a worker which took streak interactive tasks in a row
+  bool takeNext(task_t &, Priority &, std::size_t &streak);
+  void run();
+
+  const std::size_t interactiveWeight;
+  MpmcQueue<task_t> interactive;
+  MpmcQueue<task_t> bulk;
+  // A bell for each task pushed, the workers waiting on it. Preempted work
+  // takes tasks without their bell, so a worker may find no task for one
+  BlockingMpmcQueue<std::uint8_t> bells;
+  std::vector<std::thread> workers;
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_WORKER_POOL__
@@ -0,0 +1,352 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_MPMC_QUEUE__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_MPMC_QUEUE__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace entities {
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// Bounded lock-free multi-producer multi-consumer ring (D. Vyukov). Each cell
+// carries a sequence number telling whether it is ready to be written or
+// read for a given turn, so producers and consumers only contend on their
+// own position counter, each one in its own cache line. Capacity is rounded
+// up to a power of two. Elements only need to be movable: neither copies nor
+// default construction are required.
+template <typename T>
+class MpmcQueue final {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "MpmcQueue elements must be nothrow move constructible");
+
+ public:
+  explicit MpmcQueue(std::size_t capacity)
+      : mask{roundCapacity(capacity) - 1},
+        cells{std::make_unique<Cell[]>(mask + 1)} {
+    for (std::size_t i = 0; i <= mask; ++i) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos.store(0, std::memory_order_relaxed);
+  }
+  MpmcQueue(const MpmcQueue &) = delete;
+  MpmcQueue &operator=(const MpmcQueue &) = delete;
+  ~MpmcQueue() {
+    auto head = dequeuePos.load(std::memory_order_relaxed);
+    auto tail = enqueuePos.load(std::memory_order_relaxed);
+    for (auto pos = head; pos != tail; ++pos) {
+      stored(cells[pos & mask])->~T();
+    }
+  }
+
+  // Returns false, leaving item untouched, when the queue is full
+  bool tryPush(T &&item) {
+    auto pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      auto &cell = cells[pos & mask];
+      auto seq = cell.sequence.load(std::memory_order_acquire);
+      auto diff =
+          static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+          ::new (cell.storage) T(std::move(item));
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Returns false when the queue is empty
+  bool tryPop(T &item) {
+    auto pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      auto &cell = cells[pos & mask];
+      auto seq = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(seq) -
+                  static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+          take(cell, pos, [&item](T &&value) { item = std::move(value); });
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Claims up to max consecutive ready items with a single CAS and moves
+  // them to out. Returns the number of items popped
+  template <typename OutputIt>
+  std::size_t popBulk(OutputIt out, std::size_t max) {
+    auto pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      std::size_t ready = 0;
+      std::intptr_t diff = 0;
+      while (ready < max) {
+        auto &cell = cells[(pos + ready) & mask];
+        auto seq = cell.sequence.load(std::memory_order_acquire);
+        diff = static_cast<std::intptr_t>(seq) -
+               static_cast<std::intptr_t>(pos + ready + 1);
+        if (diff != 0) {
+          break;
+        }
+        ++ready;
+      }
+      if (ready == 0) {
+        if (diff < 0 or max == 0) {
+          return 0;
+        }
+        pos = dequeuePos.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (dequeuePos.compare_exchange_weak(pos, pos + ready,
+                                           std::memory_order_relaxed)) {
+        for (std::size_t i = 0; i < ready; ++i) {
+          take(cells[(pos + i) & mask], pos + i,
+               [&out](T &&value) { *out++ = std::move(value); });
+        }
+        return ready;
+      }
+    }
+  }
+
+  inline std::size_t capacity() const { return mask + 1; }
+
+  // Only a hint while producers or consumers are running
+  inline std::size_t sizeApprox() const {
+    auto head = dequeuePos.load(std::memory_order_relaxed);
+    auto tail = enqueuePos.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+  inline bool emptyApprox() const { return sizeApprox() == 0; }
+
+ private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  static std::size_t roundCapacity(std::size_t capacity) {
+    std::size_t rounded = 2;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+
+  static inline T *stored(Cell &cell) {
+    return std::launder(reinterpret_cast<T *>(cell.storage));
+  }
+
+  // Hands the item over to sink and releases the cell for the next turn
+  template <typename Sink>
+  inline void take(Cell &cell, std::size_t pos, Sink &&sink) {
+    auto item = stored(cell);
+    sink(std::move(*item));
+    item->~T();
+    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+  }
+
+  const std::size_t mask;
+  const std::unique_ptr<Cell[]> cells;
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueuePos;
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeuePos;
+};
+
+// Blocking front-end of MpmcQueue. Waiting callers spin for a short while
+// and then park on a condition variable; the other side only takes the
+// mutex to wake them up when somebody is actually parked. Once closed,
+// pushes fail and pops drain what is left.
+template <typename T>
+class BlockingMpmcQueue final {
+ public:
+  static constexpr int SPIN_LIMIT = 128;
+
+  explicit BlockingMpmcQueue(std::size_t capacity) : queue{capacity} {}
+  BlockingMpmcQueue(const BlockingMpmcQueue &) = delete;
+  BlockingMpmcQueue &operator=(const BlockingMpmcQueue &) = delete;
+  ~BlockingMpmcQueue() = default;
+
+  // Never waits. Returns false when the queue is full or closed
+  bool tryPush(T &&item) {
+    if (closed.load(std::memory_order_acquire) or
+        not queue.tryPush(std::move(item))) {
+      return false;
+    }
+    wakeUp(popWaiters, notEmpty);
+    return true;
+  }
+
+  // Waits while the queue is full. Returns false when it is closed
+  bool push(T &&item) {
+    auto pushed = wait(pushWaiters, notFull, [this, &item]() {
+      return not closed.load(std::memory_order_acquire) and
+             queue.tryPush(std::move(item));
+    });
+    if (pushed) {
+      wakeUp(popWaiters, notEmpty);
+    }
+    return pushed;
+  }
+
+  bool tryPop(T &item) {
+    if (not queue.tryPop(item)) {
+      return false;
+    }
+    wakeUp(pushWaiters, notFull);
+    return true;
+  }
+
+  // Waits for an item. Returns false when the queue is closed and empty
+  bool pop(T &item) {
+    auto popped = wait(popWaiters, notEmpty,
+                       [this, &item]() { return queue.tryPop(item); });
+    if (popped) {
+      wakeUp(pushWaiters, notFull);
+    }
+    return popped;
+  }
+
+  // As pop(T&), giving up after timeout
+  template <typename Rep, typename Period>
+  bool popFor(T &item, const std::chrono::duration<Rep, Period> &timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto popped = wait(
+        popWaiters, notEmpty, [this, &item]() { return queue.tryPop(item); },
+        &deadline);
+    if (popped) {
+      wakeUp(pushWaiters, notFull);
+    }
+    return popped;
+  }
+
+  // Waits for at least one item and pops up to max. Returns 0 when the queue
+  // is closed and empty
+  template <typename OutputIt>
+  std::size_t popBulk(OutputIt out, std::size_t max) {
+    std::size_t popped = 0;
+    wait(popWaiters, notEmpty, [this, &out, &popped, max]() {
+      popped = queue.popBulk(out, max);
+      return popped > 0;
+    });
+    if (popped) {
+      wakeUp(pushWaiters, notFull, popped > 1);
+    }
+    return popped;
+  }
+
+  void close() {
+    closed.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(mutex);
+    notEmpty.notify_all();
+    notFull.notify_all();
+  }
+
+  inline bool isClosed() const {
+    return closed.load(std::memory_order_acquire);
+  }
+  inline std::size_t capacity() const { return queue.capacity(); }
+  inline std::size_t sizeApprox() const { return queue.sizeApprox(); }
+
+ private:
+  using deadline_t = std::chrono::steady_clock::time_point;
+
+  template <typename Attempt>
+  bool wait(std::atomic<int> &waiters, std::condition_variable &cond,
+            Attempt attempt, const deadline_t *deadline = nullptr) {
+    for (int i = 0; i < SPIN_LIMIT; ++i) {
+      if (attempt()) {
+        return true;
+      }
+      if (closed.load(std::memory_order_acquire)) {
+        return attempt();
+      }
+      cpuRelax();
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    // Pairs with the fence in wakeUp(): either the other side sees this
+    // waiter or this attempt sees its item (or its free cell)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool done = false;
+    for (;;) {
+      if (attempt()) {
+        done = true;
+        break;
+      }
+      if (closed.load(std::memory_order_acquire)) {
+        break;
+      }
+      if (deadline == nullptr) {
+        cond.wait(lock);
+      } else if (cond.wait_until(lock, *deadline) ==
+                 std::cv_status::timeout) {
+        done = attempt();
+        break;
+      }
+    }
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+    return done;
+  }
+
+  inline void wakeUp(std::atomic<int> &waiters, std::condition_variable &cond,
+                     bool all = false) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) > 0) {
+      // Taking the mutex makes sure the waiter is either before its last
+      // attempt or already waiting on cond
+      { std::lock_guard<std::mutex> lock(mutex); }
+      if (all) {
+        cond.notify_all();
+      } else {
+        cond.notify_one();
+      }
+    }
+  }
+
+  MpmcQueue<T> queue;
+  std::atomic<bool> closed{false};
+  std::atomic<int> popWaiters{0};
+  std::atomic<int> pushWaiters{0};
+  std::mutex mutex;
+  std::condition_variable notEmpty;
+  std::condition_variable notFull;
+};
+
+}  // namespace entities
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_MPMC_QUEUE__
@@ -1,12 +1,15 @@
 #ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_TYPES__
 #define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_ENTITIES_TYPES__
 
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <variant>
 #include <vector>
 
-#include "boost/variant.hpp"
+#include "entities/PathIndex.hpp"
 #include "rapidjson/document.h"
 
 namespace entities {
@@ -127,6 +130,75 @@ struct ProvJournal {
   subs_id_list_t subsIdList;
 };
 
+// Borrowed counterparts of the owning entities above. Their fields point into
+// the in-situ parsed request body, so they are only valid while the
+// ValidatorRapidJsonParser that produced them is alive.
+using string_view_t = std::string_view;
+
+struct SubscriberIdentitiesIdView {
+  string_view_t id;
+  string_view_t prefix;
+};
+
+struct ProvJournalView {
+  string_view_t notifRef;
+  string_view_t imsi;
+  string_view_t imsiMask;
+  string_view_t imsiExtMask;
+  string_view_t msisdn;
+  string_view_t msisdnMask;
+  string_view_t msisdnExtMask;
+  string_view_t imsiAux;
+  string_view_t imsiAuxMask;
+  string_view_t imsiAuxExtMask;
+  string_view_t impi;
+  string_view_t impiMask;
+  string_view_t impiExtMask;
+  string_view_t secImpi;
+  string_view_t impiAux;
+  string_view_t username;
+  string_view_t usernameMask;
+  string_view_t usernameExtMask;
+  imsi_cho_status_t imsiChoStatus;
+  string_view_t imsiExpiryDate;
+  string_view_t imsiChoExec;
+  std::vector<string_view_t> impuChoIds;
+  string_view_t mscIdAux;
+  string_view_t notifInfo;
+  string_view_t ueFunctionMask;
+  std::vector<string_view_t> extIdList;
+  string_view_t nai;
+  string_view_t naiMask;
+  string_view_t naiExtMask;
+  std::vector<SubscriberIdentitiesIdView> subsIdList;
+};
+
+inline ProvJournal toProvJournal(const ProvJournalView &view) {
+  ProvJournal journal{
+      std::string{view.notifRef},       std::string{view.imsi},
+      std::string{view.imsiMask},       std::string{view.imsiExtMask},
+      std::string{view.msisdn},         std::string{view.msisdnMask},
+      std::string{view.msisdnExtMask},  std::string{view.imsiAux},
+      std::string{view.imsiAuxMask},    std::string{view.imsiAuxExtMask},
+      std::string{view.impi},           std::string{view.impiMask},
+      std::string{view.impiExtMask},    std::string{view.secImpi},
+      std::string{view.impiAux},        std::string{view.username},
+      std::string{view.usernameMask},   std::string{view.usernameExtMask},
+      view.imsiChoStatus,               std::string{view.imsiExpiryDate},
+      std::string{view.imsiChoExec},    {},
+      std::string{view.mscIdAux},       std::string{view.notifInfo},
+      std::string{view.ueFunctionMask}, {},
+      std::string{view.nai},            std::string{view.naiMask},
+      std::string{view.naiExtMask},     {}};
+  journal.impuChoIds.assign(view.impuChoIds.begin(), view.impuChoIds.end());
+  journal.extIdList.assign(view.extIdList.begin(), view.extIdList.end());
+  for (const auto &subsId : view.subsIdList) {
+    journal.subsIdList.push_back(
+        {std::string{subsId.id}, std::string{subsId.prefix}});
+  }
+  return journal;
+}
+
 using f_set_ind_t = int;
 using eki_t = std::string;
 using kind_t = int;
@@ -153,18 +225,49 @@ struct AuthSubscriptionLegacy {
 
 using changes_t = std::vector<Change>;
 using prov_journal_t = ProvJournal;
+using prov_journal_view_t = ProvJournalView;
 using auth_subscription_legacy_t = AuthSubscriptionLegacy;
 using path_t = std::string;
-using resource_t = boost::variant<auth_subscription_t, prov_journal_t,
-                                  auth_subscription_legacy_t>;
-using related_resources_t = std::map<path_t, resource_t>;
+using resource_t =
+    std::variant<auth_subscription_t, prov_journal_t,
+                 auth_subscription_legacy_t, prov_journal_view_t>;
+using related_resources_t = PathIndex<resource_t>;
 
-using error_details_t = std::map<std::string, std::string>;
-using error_message_t = std::string;
+// Description of an error, rendered by ErrorText.hpp when the response is
+// encoded, from the field and other views of the error
+enum class ErrorKind : std::uint8_t {
+  // field is the description
+  TEXT,
+  // text is the description
+  OWNED_TEXT,
+  MANDATORY_FIELD_NOT_FOUND,
+  // other is the parent of the field
+  MANDATORY_FIELD_NOT_FOUND_IN,
+  NOT_OBJECT_FIELD,
+  NOT_STRING_FIELD,
+  // other is the legacy attribute
+  NOT_EQUAL_TO_LEGACY,
+  CANNOT_BE_MODIFIED,
+  // From the resource path: its base path
+  NO_RELATED_RESOURCE,
+  // From the resource path: its mscId
+  PROV_JOURNAL_NOT_INCLUDED
+};
 
+// An error as what it is about rather than as its text, so that an error
+// costs no formatting until it is encoded. message, field and other are
+// views of constants
 struct Error {
-  error_message_t errorMessage;
-  error_details_t errorDetails;
+  std::string_view message;
+  ErrorKind kind{ErrorKind::TEXT};
+  std::string_view field;
+  std::string_view other;
+  // resource_path detail, left out when empty. Owned: the parsers raise
+  // errors while the change is still being read into a scratch one, reused
+  // for the next change and copied out with the others at the end, and
+  // related authSubscriptions report paths built by suffixing theirs
+  std::string resourcePath;
+  std::string text;
 };
 
 using errors_t = std::vector<Error>;
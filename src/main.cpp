@@ -1,12 +1,17 @@
+#include <chrono>
 #include <csignal>
+#include <memory>
+#include <optional>
 
 #include "cpph2/overload.hpp"
 #include "cppmonitor/monitor.hpp"
 #include "log/logout.hpp"
+#include "ports/logs/logcontrol.hpp"
 #include "ports/oaivalidator/OaiValidator.hpp"
 #include "ports/oaivalidator/OaiValidatorInterface.hpp"
 #include "ports/ports.hpp"
 #include "ports/server/ValidatorHttp2AsyncServer.hpp"
+#include "ports/tracing/OtlpFileExporter.hpp"
 #include "validatorEnvHandler.hpp"
 
 namespace {
@@ -31,6 +36,8 @@ int main(int argc, char *argv[]) {
   ::logout::setServiceId(envHandler::DEFAULT_SERVICE_ID);
   ::logout::setServiceName(envHandler::DEFAULT_SERVICE_NAME);
   ::logout::startLogging();
+  ::anonlog::watchLogControl(envHandler::getLogControlPath(),
+                             envHandler::DEFAULT_SERVICE_NAME);
 
   // oaivalidator initialization
   auto schemaFilePath = envHandler::getOaiSchemaFile();
@@ -44,16 +51,72 @@ int main(int argc, char *argv[]) {
   http2::overload::interface::setCPUPercentConsumptionFunction(
       monitor::getPercentCPUConsumption);
 
-  // setting overload protection
+  // setting overload protection: on the time requests wait for a worker, or
+  // on the CPU consumption through cpph2
   auto overloadProtection = envHandler::isOverloadProtected();
-  http2::overload::interface::setOverloadProtection(overloadProtection);
+  auto overloadControl = envHandler::getOverloadControl();
+  auto cpuOverload = overloadProtection and
+                     overloadControl == envHandler::OVERLOAD_CONTROL_CPU;
+  http2::overload::interface::setOverloadProtection(cpuOverload);
+  std::optional<::entities::AdmissionSettings> admission;
+  if (overloadProtection and not cpuOverload) {
+    overloadControl = envHandler::OVERLOAD_CONTROL_LATENCY;
+    admission = ::entities::AdmissionSettings{
+        std::chrono::milliseconds{envHandler::getOverloadTarget()},
+        std::chrono::milliseconds{envHandler::getOverloadInterval()},
+        std::chrono::milliseconds{envHandler::getOverloadLatencyObjective()}};
+  }
+
+  // validation runs on its own threads, out of the cpph2 I/O thread
+  auto workerThreads = envHandler::getWorkerThreads();
+  auto workerQueueSize = envHandler::getWorkerQueueSize();
+  auto parallelChanges = envHandler::getParallelChanges();
+  auto interactiveWeight = envHandler::getInteractiveWeight();
+  auto maxBatchItems = envHandler::getMaxBatchItems();
+  auto responseValidation = envHandler::getResponseValidation();
+  auto responseSample = envHandler::getResponseValidationSample();
+  auto jsonParser = envHandler::getJsonParser();
+
+  // request stages are traced when a trace file is given. The spans outlive
+  // the server, the exporter writes the last ones once it is gone
+  auto traceFile = envHandler::getTraceFile();
+  std::unique_ptr<::entities::SpanRing> spans;
+  std::unique_ptr<::port::secondary::tracing::OtlpFileExporter> spanExporter;
+  if (not traceFile.empty()) {
+    spans =
+        std::make_unique<::entities::SpanRing>(envHandler::getTraceRingSize());
+    spanExporter =
+        std::make_unique<::port::secondary::tracing::OtlpFileExporter>(
+            *spans, traceFile, envHandler::DEFAULT_SERVICE_NAME,
+            std::chrono::milliseconds{envHandler::getTraceExportInterval()},
+            std::uint64_t{envHandler::getTraceFileSize()} << 20);
+  }
 
   LOG_INFO("Starting server", "Authentication provisioning validator URI",
            portValidator, "schema", schemaFilePath, "overload",
-           overloadProtection ? "on" : "off");
+           overloadProtection ? overloadControl : "off", "workers",
+           std::to_string(workerThreads), "queue",
+           std::to_string(workerQueueSize), "parallel changes",
+           std::to_string(parallelChanges), "interactive weight",
+           std::to_string(interactiveWeight), "batch items",
+           std::to_string(maxBatchItems), "response validation",
+           responseValidation, "sample", std::to_string(responseSample),
+           "json parser", jsonParser, "trace file",
+           traceFile.empty() ? "off" : traceFile);
 
   // cpph2 server start
-  ::port::primary::ValidatorHttp2AsyncServer server;
+  ::port::primary::ServerSettings settings;
+  settings.workerThreads = workerThreads;
+  settings.workerQueueSize = workerQueueSize;
+  settings.interactiveWeight = interactiveWeight;
+  settings.responseValidation = responseValidation;
+  settings.responseSampleRate = responseSample;
+  settings.jsonParser = jsonParser;
+  settings.minParallelChanges = parallelChanges;
+  settings.maxBatchItems = maxBatchItems;
+  settings.spans = spans.get();
+  settings.admission = admission;
+  ::port::primary::ValidatorHttp2AsyncServer server(settings);
   auto sc = server.start(portValidator);
 
   return sc;
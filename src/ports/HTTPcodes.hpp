@@ -5,8 +5,10 @@ namespace port {
 constexpr auto HTTP_OK = 200;
 constexpr auto HTTP_BAD_REQUEST = 400;
 constexpr auto HTTP_CONFLICT = 409;
+constexpr auto HTTP_PAYLOAD_TOO_LARGE = 413;
 constexpr auto HTTP_UNPROCESSABLE_ENTITY = 422;
 constexpr auto HTTP_INTERNAL_SERVER_ERROR = 500;
+constexpr auto HTTP_SERVICE_UNAVAILABLE = 503;
 
 }  // namespace port
 
@@ -0,0 +1,104 @@
+#include "JsonBatch.hpp"
+
+namespace port {
+namespace secondary {
+namespace json {
+
+namespace {
+
+constexpr std::string_view BLANKS = " \t\r\n";
+
+std::string_view trim(std::string_view str) {
+  auto first = str.find_first_not_of(BLANKS);
+  if (first == std::string_view::npos) {
+    return str.substr(str.size());
+  }
+  auto last = str.find_last_not_of(BLANKS);
+  return str.substr(first, last + 1 - first);
+}
+
+bool splitArray(std::string_view body, std::vector<std::string_view> &items) {
+  // body starts right after the opening bracket
+  std::size_t depth = 0;
+  std::size_t start = 0;
+  bool inString = false;
+  for (std::size_t pos = 0; pos < body.size(); ++pos) {
+    auto c = body[pos];
+    if (inString) {
+      if (c == '\\') {
+        ++pos;
+      } else if (c == '"') {
+        inString = false;
+      }
+      continue;
+    }
+    switch (c) {
+      case '"':
+        inString = true;
+        break;
+      case '{':
+      case '[':
+        ++depth;
+        break;
+      case '}':
+        if (depth > 0) {
+          --depth;
+        }
+        break;
+      case ']':
+        if (depth > 0) {
+          --depth;
+          break;
+        }
+        [[fallthrough]];
+      case ',':
+        if (depth == 0) {
+          auto item = trim(body.substr(start, pos - start));
+          // "[]" has no items, but "[{},]" has an empty last one
+          if (c == ',' or not item.empty() or not items.empty()) {
+            items.push_back(item);
+          }
+          if (c == ']') {
+            return trim(body.substr(pos + 1)).empty();
+          }
+          start = pos + 1;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+void splitLines(std::string_view body, std::vector<std::string_view> &items) {
+  while (not body.empty()) {
+    auto end = body.find('\n');
+    auto item = trim(body.substr(0, end));
+    if (not item.empty()) {
+      items.push_back(item);
+    }
+    if (end == std::string_view::npos) {
+      break;
+    }
+    body.remove_prefix(end + 1);
+  }
+}
+
+}  // namespace
+
+bool splitBatch(std::string_view body, BatchFormat &format,
+                std::vector<std::string_view> &items) {
+  auto first = body.find_first_not_of(BLANKS);
+  if (first != std::string_view::npos and body[first] == '[') {
+    format = BatchFormat::ARRAY;
+    return splitArray(body.substr(first + 1), items);
+  }
+  format = BatchFormat::NDJSON;
+  splitLines(body, items);
+  return true;
+}
+
+}  // namespace json
+}  // namespace secondary
+}  // namespace port
@@ -0,0 +1,29 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_JSON_BATCH_HPP__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_JSON_BATCH_HPP__
+
+#include <string_view>
+#include <vector>
+
+namespace port {
+namespace secondary {
+namespace json {
+
+// How the validation documents of a batch are laid out:
+//   - ARRAY: a JSON array of documents. '[' is the first non-blank character
+//     of the body.
+//   - NDJSON: one document per line. Blank lines are skipped.
+enum class BatchFormat { ARRAY, NDJSON };
+
+// Splits a batch into its items, as views into the body, without parsing
+// them: each item is parsed, and its errors reported, on its own. Array items
+// are split at their top-level commas, so an empty one ("[{},,{}]") is kept as
+// an empty item. Returns false when the array is not closed, or when something
+// other than blanks follows it.
+bool splitBatch(std::string_view body, BatchFormat &format,
+                std::vector<std::string_view> &items);
+
+}  // namespace json
+}  // namespace secondary
+}  // namespace port
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_JSON_BATCH_HPP__
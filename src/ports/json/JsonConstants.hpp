@@ -15,6 +15,11 @@ constexpr auto JSON_OPERATION_DELETE = "DELETE";
 constexpr auto JSON_ERRORS = "errors";
 constexpr auto JSON_ERROR_MESSAGE = "errorMessage";
 constexpr auto JSON_ERROR_DETAILS = "errorDetails";
+constexpr auto JSON_DESCRIPTION = "description";
+
+// batch response
+constexpr auto JSON_BATCH_STATUS = "status";
+constexpr auto JSON_BATCH_RESPONSE = "response";
 
 constexpr auto JSON_AUTH_SUBSCRIPTION = "authSubscription";
 
@@ -3,14 +3,233 @@
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 
+#include <cstring>
+
 #include "JsonConstants.hpp"
+#include "entities/ErrorText.hpp"
 
 namespace port {
 namespace secondary {
 namespace json {
 
+using json_buffer_t =
+    rapidjson::GenericStringBuffer<rapidjson::UTF8<>,
+                                   rapidjson::MemoryPoolAllocator<>>;
+
+namespace {
+
+// rapidjson output stream appending to a string owned by the caller
+class StringOutputStream final {
+ public:
+  using Ch = char;
+  explicit StringOutputStream(std::string& out) : out{out} {}
+  void Put(Ch c) { out.push_back(c); }
+  void Flush() {}
+
+ private:
+  std::string& out;
+};
+
+// Strings end at their first null character, as the DOM values built from
+// c_str() do, so that both encodings give the same bytes
+template <typename Writer>
+void writeString(Writer& writer, const std::string& str) {
+  writer.String(str.c_str(), std::strlen(str.c_str()));
+}
+
+template <typename Writer>
+void writeKey(Writer& writer, const std::string& key) {
+  writer.Key(key.c_str(), std::strlen(key.c_str()));
+}
+
+// Empty strings are not written, as strToJson()
+template <typename Writer>
+void writeMember(Writer& writer, const char* key, const std::string& str) {
+  if (not str.empty()) {
+    writer.Key(key);
+    writeString(writer, str);
+  }
+}
+
+template <typename Writer>
+void writeMember(Writer& writer, const char* key,
+                 const std::optional<std::string>& str) {
+  if (str.has_value()) {
+    writeMember(writer, key, str.value());
+  }
+}
+
+template <typename Writer>
+void writeStaticData(Writer& writer,
+                     const entities::auth_subscription_t& authSubscription) {
+  if (not authSubscription.authSubscriptionStaticData.has_value()) {
+    return;
+  }
+  const auto& staticData = authSubscription.authSubscriptionStaticData.value();
+
+  for (auto const& [key, val] : staticData.vendorSpecific) {
+    writeKey(writer, key);
+    val.Accept(writer);
+  }
+  writeMember(writer, JSON_AUTHENTICATION_METHOD,
+              staticData.authenticationMethod);
+  writeMember(writer, JSON_ENC_PERMANENT_KEY, staticData.encPermanentKey);
+  writeMember(writer, JSON_AUTHENTICATION_MANAGEMENT_FIELD,
+              staticData.authenticationManagementField);
+  writeMember(writer, JSON_ALGORITHM_ID, staticData.algorithmId);
+  writeMember(writer, JSON_A4_KEY_IND, staticData.a4KeyInd);
+  writeMember(writer, JSON_A4_IND, staticData.a4Ind);
+  writeMember(writer, JSON_ENC_OPC_KEY, staticData.encOpcKey);
+  writeMember(writer, JSON_A4_KEY_V, staticData.a4KeyV);
+  writeMember(writer, JSON_AKA_ALGORITHM_IND, staticData.akaAlgorithmInd);
+}
+
+template <typename Writer>
+void writeDynamicData(Writer& writer,
+                      const entities::auth_subscription_t& authSubscription) {
+  if (not authSubscription.authSubscriptionDynamicData.has_value()) {
+    return;
+  }
+  const auto& dynamicData =
+      authSubscription.authSubscriptionDynamicData.value();
+
+  writeMember(writer, JSON_SQN_SCHEME, dynamicData.sqnScheme);
+  writeMember(writer, JSON_SQN, dynamicData.sqn);
+
+  writer.Key(JSON_LAST_INDEXES_LIST);
+  writer.StartObject();
+  if (dynamicData.lastIndexesList.has_value()) {
+    for (auto const& [key, index] : dynamicData.lastIndexesList.value()) {
+      writeKey(writer, key);
+      writer.Int(index);
+    }
+  }
+  writer.EndObject();
+}
+
+// The description is rendered into text, which is reused from one error to
+// the next
+template <typename Writer>
+void writeError(Writer& writer, const entities::Error& err,
+                std::string& text) {
+  writer.StartObject();
+  writer.Key(JSON_ERROR_MESSAGE);
+  writer.String(err.message.data(), err.message.size());
+  writer.Key(JSON_ERROR_DETAILS);
+  writer.StartObject();
+  text.clear();
+  entities::appendErrorDescription(err, text);
+  writer.Key(JSON_DESCRIPTION);
+  writeString(writer, text);
+  writeMember(writer, JSON_RESOURCE_PATH, err.resourcePath);
+  writer.EndObject();
+  writer.EndObject();
+}
+
+// A created authSubscription is followed by the change of its dynamic data
+template <typename Writer>
+void writeChange(Writer& writer, const entities::Change& change) {
+  const auto& op = change.operation;
+  bool isAuthSubscription =
+      change.resourcePath.find(JSON_AUTH_SUBSCRIPTION) != std::string::npos;
+
+  writer.StartObject();
+  writer.Key(JSON_OPERATION);
+  writeString(writer, op);
+  writer.Key(JSON_RESOURCE_PATH);
+  writeString(writer, change.resourcePath);
+  if (op.compare(JSON_OPERATION_DELETE)) {
+    writer.Key(JSON_DATA);
+    writer.StartObject();
+    if (isAuthSubscription) {
+      writeStaticData(writer, change.authSubscription);
+    }
+    writer.EndObject();
+  }
+  writer.EndObject();
+
+  if (not op.compare(JSON_OPERATION_CREATE)) {
+    writer.StartObject();
+    writer.Key(JSON_OPERATION);
+    writeString(writer, op);
+    writer.Key(JSON_RESOURCE_PATH);
+    writeString(writer, entities::ValidationData::createPathFromBasePath(
+                            change.resourcePath,
+                            JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA));
+    writer.Key(JSON_DATA);
+    writer.StartObject();
+    if (isAuthSubscription) {
+      writeDynamicData(writer, change.authSubscription);
+    }
+    writer.EndObject();
+    writer.EndObject();
+  }
+}
+
+template <typename Writer>
+void writeResponse(Writer& writer, const entities::ValidationData& data,
+                   std::string& errorText) {
+  writer.StartObject();
+  if (data.response.errors.size()) {
+    writer.Key(JSON_ERRORS);
+    writer.StartArray();
+    for (const auto& err : data.response.errors) {
+      writeError(writer, err, errorText);
+    }
+    writer.EndArray();
+  } else if (data.response.changes.size()) {
+    writer.Key(JSON_CHANGES);
+    writer.StartArray();
+    for (const auto& change : data.response.changes) {
+      writeChange(writer, change);
+    }
+    writer.EndArray();
+  }
+  writer.EndObject();
+}
+
+// The response has already been encoded
+template <typename Writer>
+void writeBatchResult(Writer& writer, const batch_result_t& result) {
+  writer.StartObject();
+  writer.Key(JSON_BATCH_STATUS);
+  writer.Uint(result.first);
+  writer.Key(JSON_BATCH_RESPONSE);
+  writer.RawValue(result.second.data(), result.second.size(),
+                  rapidjson::kObjectType);
+  writer.EndObject();
+}
+
+// The writer stack is taken from the encoder allocator, as the DOM is
+template <typename Write>
+void writeTo(std::string& out, bool prettyFormat,
+             rapidjson::MemoryPoolAllocator<>& allocator, Write&& write) {
+  out.clear();
+  StringOutputStream os(out);
+  if (prettyFormat) {
+    rapidjson::PrettyWriter<StringOutputStream, rapidjson::UTF8<>,
+                            rapidjson::UTF8<>, rapidjson::MemoryPoolAllocator<>>
+        writer(os, &allocator);
+    write(writer);
+  } else {
+    rapidjson::Writer<StringOutputStream, rapidjson::UTF8<>, rapidjson::UTF8<>,
+                      rapidjson::MemoryPoolAllocator<>>
+        writer(os, &allocator);
+    write(writer);
+  }
+}
+
+}  // namespace
+
 ValidatorRapidJsonEncoder::ValidatorRapidJsonEncoder()
-    : rJsonDoc{}, prettyFormat{false} {}
+    : rJsonAllocator{}, rJsonDoc{&rJsonAllocator}, prettyFormat{false} {}
+
+ValidatorRapidJsonEncoder::ValidatorRapidJsonEncoder(
+    entities::RequestArena& arena)
+    : rJsonAllocator{arena.allocate(entities::RequestArena::JSON_POOL_SIZE),
+                     entities::RequestArena::JSON_POOL_SIZE},
+      rJsonDoc{&rJsonAllocator},
+      prettyFormat{false} {}
 
 void ValidatorRapidJsonEncoder::authSubscriptionStaticDataToJson(
     rapidjson::Value& data,
@@ -99,6 +318,26 @@ void ValidatorRapidJsonEncoder::authSubscriptionDynamicDataToJson(
   }
 }
 
+void ValidatorRapidJsonEncoder::errorToJson(
+    rapidjson::Value& error, const ::entities::Error& err,
+    rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value valueErrorMessage(
+      err.message.data(), static_cast<rapidjson::SizeType>(err.message.size()),
+      allocator);
+  error.AddMember(rapidjson::StringRef(JSON_ERROR_MESSAGE), valueErrorMessage,
+                  allocator);
+
+  errorText.clear();
+  entities::appendErrorDescription(err, errorText);
+  rapidjson::Value details(rapidjson::kObjectType);
+  rapidjson::Value description(errorText.c_str(), allocator);
+  details.AddMember(rapidjson::StringRef(JSON_DESCRIPTION), description,
+                    allocator);
+  strToJson(details, err.resourcePath, JSON_RESOURCE_PATH, allocator);
+  error.AddMember(rapidjson::StringRef(JSON_ERROR_DETAILS), details,
+                  allocator);
+}
+
 std::ostringstream ValidatorRapidJsonEncoder::validatorResponseToJson(
     const ::entities::ValidationData& data) {
   rJsonDoc.SetObject();
@@ -110,19 +349,7 @@ std::ostringstream ValidatorRapidJsonEncoder::validatorResponseToJson(
 
     for (const auto& elem : data.response.errors) {
       rapidjson::Value error(rapidjson::kObjectType);
-      rapidjson::Value keyErrorMessage(JSON_ERROR_MESSAGE, allocator);
-      rapidjson::Value valueErrorMessage(elem.errorMessage.c_str(), allocator);
-      error.AddMember(keyErrorMessage, valueErrorMessage, allocator);
-
-      rapidjson::Value details(rapidjson::kObjectType);
-      for (auto const& it : elem.errorDetails) {
-        rapidjson::Value key(it.first.c_str(), allocator);
-        rapidjson::Value val(it.second.c_str(), allocator);
-        details.AddMember(key, val, allocator);
-      }
-      error.AddMember(rapidjson::StringRef(JSON_ERROR_DETAILS), details,
-                      allocator);
-
+      errorToJson(error, elem, allocator);
       errors.PushBack(error, allocator);
     }
 
@@ -205,20 +432,7 @@ std::ostringstream ValidatorRapidJsonEncoder::validatorResponseToJson(
 std::ostringstream ValidatorRapidJsonEncoder::errorResponseToJson(
     const ::entities::Error& err) {
   rJsonDoc.SetObject();
-  rapidjson::Document::AllocatorType& allocator = rJsonDoc.GetAllocator();
-
-  rapidjson::Value keyErrorMessage(JSON_ERROR_MESSAGE, allocator);
-  rapidjson::Value valueErrorMessage(err.errorMessage.c_str(), allocator);
-  rJsonDoc.AddMember(keyErrorMessage, valueErrorMessage, allocator);
-
-  rapidjson::Value details(rapidjson::kObjectType);
-  for (auto const& it : err.errorDetails) {
-    rapidjson::Value key(it.first.c_str(), allocator);
-    rapidjson::Value val(it.second.c_str(), allocator);
-    details.AddMember(key, val, allocator);
-  }
-  rJsonDoc.AddMember(rapidjson::StringRef(JSON_ERROR_DETAILS), details,
-                     allocator);
+  errorToJson(rJsonDoc, err, rJsonDoc.GetAllocator());
 
   std::ostringstream os;
   if (!rJsonDoc.IsNull()) {
@@ -229,6 +443,43 @@ std::ostringstream ValidatorRapidJsonEncoder::errorResponseToJson(
   return os;
 }
 
+void ValidatorRapidJsonEncoder::validatorResponseToJson(
+    const ::entities::ValidationData& data, std::string& out) {
+  writeTo(out, prettyFormat, rJsonAllocator, [this, &data](auto& writer) {
+    writeResponse(writer, data, errorText);
+  });
+}
+
+void ValidatorRapidJsonEncoder::errorResponseToJson(
+    const ::entities::Error& err, std::string& out) {
+  writeTo(out, prettyFormat, rJsonAllocator, [this, &err](auto& writer) {
+    writeError(writer, err, errorText);
+  });
+}
+
+void ValidatorRapidJsonEncoder::batchResponseToJson(
+    const std::vector<batch_result_t>& results, bool ndjson, std::string& out) {
+  out.clear();
+  StringOutputStream os(out);
+  rapidjson::Writer<StringOutputStream, rapidjson::UTF8<>, rapidjson::UTF8<>,
+                    rapidjson::MemoryPoolAllocator<>>
+      writer(os, &rJsonAllocator);
+  if (not ndjson) {
+    writer.StartArray();
+    for (const auto& result : results) {
+      writeBatchResult(writer, result);
+    }
+    writer.EndArray();
+    return;
+  }
+  // A writer takes one root value: it is reset for each line
+  for (const auto& result : results) {
+    writer.Reset(os);
+    writeBatchResult(writer, result);
+    out.push_back('\n');
+  }
+}
+
 void ValidatorRapidJsonEncoder::strToJson(
     rapidjson::Value& data, const std::string& str, const std::string& keyName,
     rapidjson::Document::AllocatorType& allocator) {
@@ -239,13 +490,17 @@ void ValidatorRapidJsonEncoder::strToJson(
   }
 }
 
-void ValidatorRapidJsonEncoder::acceptWriter(std::ostringstream& os) const {
-  rapidjson::StringBuffer buffer;
+void ValidatorRapidJsonEncoder::acceptWriter(std::ostringstream& os) {
+  json_buffer_t buffer(&rJsonAllocator);
   if (prettyFormat) {
-    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    rapidjson::PrettyWriter<json_buffer_t, rapidjson::UTF8<>,
+                            rapidjson::UTF8<>, rapidjson::MemoryPoolAllocator<>>
+        writer(buffer, &rJsonAllocator);
     rJsonDoc.Accept(writer);
   } else {
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    rapidjson::Writer<json_buffer_t, rapidjson::UTF8<>, rapidjson::UTF8<>,
+                      rapidjson::MemoryPoolAllocator<>>
+        writer(buffer, &rJsonAllocator);
     rJsonDoc.Accept(writer);
   }
   os << buffer.GetString();
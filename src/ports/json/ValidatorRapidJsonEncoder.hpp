@@ -1,9 +1,14 @@
 #ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_RAPIDJSON_ENCODER_HPP__
 #define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_RAPIDJSON_ENCODER_HPP__
 
+#include <cstdint>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "entities/ProblemDetails.hpp"
+#include "entities/RequestArena.hpp"
 #include "entities/ValidationData.hpp"
 #include "rapidjson/document.h"
 
@@ -11,21 +16,42 @@ namespace port {
 namespace secondary {
 namespace json {
 
+// Status and encoded response of one item of a batch
+using batch_result_t = std::pair<std::uint32_t, std::string>;
+
 class ValidatorRapidJsonEncoder final {
  public:
   ValidatorRapidJsonEncoder();
+  // DOM and output buffer are allocated from the request arena
+  explicit ValidatorRapidJsonEncoder(entities::RequestArena&);
   ValidatorRapidJsonEncoder(ValidatorRapidJsonEncoder&&) = delete;
   ~ValidatorRapidJsonEncoder() noexcept = default;
   std::string toStringJson(const ::entities::ProblemDetails&);
   std::ostringstream toJson(const ::entities::ProblemDetails&);
   std::ostringstream validatorResponseToJson(const ::entities::ValidationData&);
   std::ostringstream errorResponseToJson(const ::entities::Error&);
+  // Same output as above, written straight into out through a rapidjson
+  // Writer, with no document built. out is cleared first, but keeps its
+  // capacity, so a caller may reuse it or move it to the response
+  void validatorResponseToJson(const ::entities::ValidationData&,
+                               std::string& out);
+  void errorResponseToJson(const ::entities::Error&, std::string& out);
+  // {"status":...,"response":...} per item, in order, with the responses
+  // copied as they are: as a JSON array, or one object per line when ndjson.
+  // Always compact, so an object never spans lines
+  void batchResponseToJson(const std::vector<batch_result_t>&, bool ndjson,
+                           std::string& out);
   inline void enablePrettyFormat();
 
  private:
+  rapidjson::MemoryPoolAllocator<> rJsonAllocator;
   rapidjson::Document rJsonDoc;
   bool prettyFormat;
-  void acceptWriter(std::ostringstream&) const;
+  // Error descriptions are rendered here, one at a time, as they are written
+  std::string errorText;
+  void acceptWriter(std::ostringstream&);
+  void errorToJson(rapidjson::Value&, const ::entities::Error&,
+                   rapidjson::Document::AllocatorType&);
   void authSubscriptionStaticDataToJson(rapidjson::Value&,
                                         const entities::auth_subscription_t&,
                                         rapidjson::Document::AllocatorType&);
@@ -1,7 +1,10 @@
 #include "ValidatorRapidJsonParser.hpp"
 
+#include <boost/regex.hpp>
+
 #include "JsonConstants.hpp"
 #include "codec/Codec.hpp"
+#include "entities/ErrorText.hpp"
 #include "entities/ValidationData.hpp"
 #include "ports/ports.hpp"
 
@@ -19,29 +22,58 @@ bool ValidatorRapidJsonParser::isVendorSpecific(const std::string& vs) {
 
 ValidatorRapidJsonParser::ValidatorRapidJsonParser(
     const std::string& json_string)
-    : rJsonDoc{}, rJsonParseError{false}, rJsonParseErrorStr{} {
+    : rJsonBuffer{},
+      rJsonInsitu{false},
+      rJsonAllocator{},
+      rJsonDoc{&rJsonAllocator},
+      rJsonParseError{false},
+      rJsonParseErrorStr{} {
   if (not(rapidjson::ParseResult) rJsonDoc.Parse(json_string.c_str())) {
     setParsingError("wrong json format");
   }
 }
 
+ValidatorRapidJsonParser::ValidatorRapidJsonParser(std::string&& json_string)
+    : rJsonBuffer{std::move(json_string)},
+      rJsonInsitu{true},
+      rJsonAllocator{},
+      rJsonDoc{&rJsonAllocator},
+      rJsonParseError{false},
+      rJsonParseErrorStr{} {
+  if (not(rapidjson::ParseResult) rJsonDoc.ParseInsitu(rJsonBuffer.data())) {
+    setParsingError("wrong json format");
+  }
+}
+
+ValidatorRapidJsonParser::ValidatorRapidJsonParser(
+    std::string&& json_string, entities::RequestArena& arena)
+    : rJsonBuffer{std::move(json_string)},
+      rJsonInsitu{true},
+      rJsonAllocator{arena.allocate(entities::RequestArena::JSON_POOL_SIZE),
+                     entities::RequestArena::JSON_POOL_SIZE},
+      rJsonDoc{&rJsonAllocator},
+      rJsonParseError{false},
+      rJsonParseErrorStr{} {
+  if (not(rapidjson::ParseResult) rJsonDoc.ParseInsitu(rJsonBuffer.data())) {
+    setParsingError("wrong json format");
+  }
+}
+
 void ValidatorRapidJsonParser::getAuthSubscription(
     const rapidjson::Value& attrData,
     entities::auth_subscription_t& authSubscription,
     entities::ValidationData& data, const std::string& resourcePath) {
   if (not attrData.HasMember(JSON_AUTH_SUBSCRIPTION_STATIC_DATA)) {
-    data.addError("Constraint Violation",
-                  {{"resource_path", resourcePath},
-                   {"description", data.unfoundMandatoryFieldError(
-                                       JSON_AUTH_SUBSCRIPTION_STATIC_DATA)}});
+    data.addError(entities::constraintViolation(
+        resourcePath, entities::ErrorKind::MANDATORY_FIELD_NOT_FOUND,
+        JSON_AUTH_SUBSCRIPTION_STATIC_DATA));
     return;
   }
 
   if (not attrData[JSON_AUTH_SUBSCRIPTION_STATIC_DATA].IsObject()) {
-    data.addError("Constraint Violation",
-                  {{"resource_path", resourcePath},
-                   {"description", data.notObjectFieldError(
-                                       JSON_AUTH_SUBSCRIPTION_STATIC_DATA)}});
+    data.addError(entities::constraintViolation(
+        resourcePath, entities::ErrorKind::NOT_OBJECT_FIELD,
+        JSON_AUTH_SUBSCRIPTION_STATIC_DATA));
     return;
   }
 
@@ -57,11 +89,9 @@ void ValidatorRapidJsonParser::getAuthSubscription(
 
   if (attrData.HasMember(JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA)) {
     if (not attrData[JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA].IsObject()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description",
-            data.notObjectFieldError(JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_OBJECT_FIELD,
+          JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA));
     } else {
       const rapidjson::Value& authSubscriptionDynamicDataJson =
           attrData[JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA];
@@ -87,18 +117,16 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
 
   if (not authSubscriptionStaticDataJson.HasMember(
           JSON_AUTHENTICATION_METHOD)) {
-    data.addError("Constraint Violation",
-                  {{"resource_path", resourcePath},
-                   {"description", data.unfoundMandatoryFieldError(
-                                       JSON_AUTHENTICATION_METHOD,
-                                       JSON_AUTH_SUBSCRIPTION_STATIC_DATA)}});
+    data.addError(entities::constraintViolation(
+        resourcePath, entities::ErrorKind::MANDATORY_FIELD_NOT_FOUND_IN,
+        JSON_AUTHENTICATION_METHOD,
+        JSON_AUTH_SUBSCRIPTION_STATIC_DATA));
   } else {
     if (not authSubscriptionStaticDataJson[JSON_AUTHENTICATION_METHOD]
                 .IsString()) {
-      data.addError("Constraint Violation",
-                    {{"resource_path", resourcePath},
-                     {"description",
-                      data.notStringFieldError(JSON_AUTHENTICATION_METHOD)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+          JSON_AUTHENTICATION_METHOD));
 
     } else {
       authSubscriptionStaticData.authenticationMethod =
@@ -109,10 +137,9 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
 
   if (authSubscriptionStaticDataJson.HasMember(JSON_ENC_PERMANENT_KEY)) {
     if (not authSubscriptionStaticDataJson[JSON_ENC_PERMANENT_KEY].IsString()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description", data.notStringFieldError(JSON_ENC_PERMANENT_KEY)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+          JSON_ENC_PERMANENT_KEY));
 
     } else {
       authSubscriptionStaticData.encPermanentKey =
@@ -124,11 +151,9 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
           JSON_AUTHENTICATION_MANAGEMENT_FIELD)) {
     if (not authSubscriptionStaticDataJson[JSON_AUTHENTICATION_MANAGEMENT_FIELD]
                 .IsString()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description",
-            data.notStringFieldError(JSON_AUTHENTICATION_MANAGEMENT_FIELD)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+          JSON_AUTHENTICATION_MANAGEMENT_FIELD));
 
     } else {
       authSubscriptionStaticData.authenticationManagementField =
@@ -139,10 +164,9 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
 
   if (authSubscriptionStaticDataJson.HasMember(JSON_ALGORITHM_ID)) {
     if (not authSubscriptionStaticDataJson[JSON_ALGORITHM_ID].IsString()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description", data.notStringFieldError(JSON_ALGORITHM_ID)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+          JSON_ALGORITHM_ID));
 
     } else {
       authSubscriptionStaticData.algorithmId =
@@ -152,10 +176,9 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
 
   if (authSubscriptionStaticDataJson.HasMember(JSON_A4_KEY_IND)) {
     if (not authSubscriptionStaticDataJson[JSON_A4_KEY_IND].IsString()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description", data.notStringFieldError(JSON_A4_KEY_IND)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+          JSON_A4_KEY_IND));
 
     } else {
       authSubscriptionStaticData.a4KeyInd =
@@ -165,9 +188,8 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
 
   if (authSubscriptionStaticDataJson.HasMember(JSON_A4_IND)) {
     if (not authSubscriptionStaticDataJson[JSON_A4_IND].IsString()) {
-      data.addError("Constraint Violation",
-                    {{"resource_path", resourcePath},
-                     {"description", data.notStringFieldError(JSON_A4_IND)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD, JSON_A4_IND));
 
     } else {
       authSubscriptionStaticData.a4Ind =
@@ -177,10 +199,9 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
 
   if (authSubscriptionStaticDataJson.HasMember(JSON_ENC_OPC_KEY)) {
     if (not authSubscriptionStaticDataJson[JSON_ENC_OPC_KEY].IsString()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description", data.notStringFieldError(JSON_ENC_OPC_KEY)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+          JSON_ENC_OPC_KEY));
 
     } else {
       authSubscriptionStaticData.encOpcKey =
@@ -190,10 +211,9 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
 
   if (authSubscriptionStaticDataJson.HasMember(JSON_ENC_TOPC_KEY)) {
     if (not authSubscriptionStaticDataJson[JSON_ENC_TOPC_KEY].IsString()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description", data.notStringFieldError(JSON_ENC_TOPC_KEY)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+          JSON_ENC_TOPC_KEY));
 
     } else {
       authSubscriptionStaticData.encTopcKey =
@@ -203,9 +223,8 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
 
   if (authSubscriptionStaticDataJson.HasMember(JSON_A4_KEY_V)) {
     if (not authSubscriptionStaticDataJson[JSON_A4_KEY_V].IsString()) {
-      data.addError("Constraint Violation",
-                    {{"resource_path", resourcePath},
-                     {"description", data.notStringFieldError(JSON_A4_KEY_V)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD, JSON_A4_KEY_V));
 
     } else {
       authSubscriptionStaticData.a4KeyV =
@@ -215,10 +234,9 @@ void ValidatorRapidJsonParser::getAuthSubscriptionStaticData(
 
   if (authSubscriptionStaticDataJson.HasMember(JSON_AKA_ALGORITHM_IND)) {
     if (not authSubscriptionStaticDataJson[JSON_AKA_ALGORITHM_IND].IsString()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description", data.notStringFieldError(JSON_AKA_ALGORITHM_IND)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+          JSON_AKA_ALGORITHM_IND));
 
     } else {
       authSubscriptionStaticData.akaAlgorithmInd =
@@ -233,10 +251,9 @@ void ValidatorRapidJsonParser::getAuthSubscriptionDynamicData(
     entities::ValidationData& data, const std::string& resourcePath) {
   if (authSubscriptionDynamicDataJson.HasMember(JSON_SQN_SCHEME)) {
     if (not authSubscriptionDynamicDataJson[JSON_SQN_SCHEME].IsString()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description", data.notStringFieldError(JSON_SQN_SCHEME)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+          JSON_SQN_SCHEME));
     } else {
       authSubscriptionDynamicData.sqnScheme.emplace(
           authSubscriptionDynamicDataJson[JSON_SQN_SCHEME].GetString());
@@ -245,9 +262,8 @@ void ValidatorRapidJsonParser::getAuthSubscriptionDynamicData(
 
   if (authSubscriptionDynamicDataJson.HasMember(JSON_SQN)) {
     if (not authSubscriptionDynamicDataJson[JSON_SQN].IsString()) {
-      data.addError("Constraint Violation",
-                    {{"resource_path", resourcePath},
-                     {"description", data.notStringFieldError(JSON_SQN)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_STRING_FIELD, JSON_SQN));
     } else {
       authSubscriptionDynamicData.sqn.emplace(
           authSubscriptionDynamicDataJson[JSON_SQN].GetString());
@@ -257,28 +273,21 @@ void ValidatorRapidJsonParser::getAuthSubscriptionDynamicData(
   if (authSubscriptionDynamicDataJson.HasMember(JSON_LAST_INDEXES_LIST)) {
     if (not authSubscriptionDynamicDataJson[JSON_LAST_INDEXES_LIST]
                 .IsObject()) {
-      data.addError(
-          "Constraint Violation",
-          {{"resource_path", resourcePath},
-           {"description", data.notObjectFieldError(JSON_LAST_INDEXES_LIST)}});
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::ErrorKind::NOT_OBJECT_FIELD,
+          JSON_LAST_INDEXES_LIST));
     } else {
       entities::last_indexes_list_t lastIndexesList;
       for (auto& v : authSubscriptionDynamicDataJson[JSON_LAST_INDEXES_LIST]
                          .GetObject()) {
         if (not v.name.IsString()) {
-          data.addError("Constraint Violation",
-                        {{"resource_path", resourcePath},
-                         {"description",
-                          "key not string in \"" +
-                              std::string{JSON_LAST_INDEXES_LIST} + "\""}});
+          data.addError(entities::constraintViolation(
+              resourcePath, entities::LAST_INDEXES_KEY_NOT_STRING));
           continue;
         }
         if (not v.value.IsInt()) {
-          data.addError("Constraint Violation",
-                        {{"resource_path", resourcePath},
-                         {"description",
-                          "value not integer in \"" +
-                              std::string{JSON_LAST_INDEXES_LIST} + "\""}});
+          data.addError(entities::constraintViolation(
+              resourcePath, entities::LAST_INDEXES_VALUE_NOT_INTEGER));
           continue;
         }
         lastIndexesList.insert({v.name.GetString(), v.value.GetInt()});
@@ -409,11 +418,19 @@ void ValidatorRapidJsonParser::getRelatedResources(
           }
         }
       } else if (resourcePath.ends_with(JSON_PROV_JOURNAL)) {
-        entities::ProvJournal provJournal;
+        if (rJsonInsitu) {
+          entities::prov_journal_view_t provJournal{};
+
+          getProvJournal(it->value, provJournal);
 
-        getProvJournal(it->value, provJournal);
+          data.relatedResources.insert({resourcePath, std::move(provJournal)});
+        } else {
+          entities::ProvJournal provJournal{};
 
-        data.relatedResources.insert({resourcePath, provJournal});
+          getProvJournal(it->value, provJournal);
+
+          data.relatedResources.insert({resourcePath, std::move(provJournal)});
+        }
       } else if (entities::ValidationData::checkAuthSubscriptionLegacyUri(
                      resourcePath)) {
         entities::auth_subscription_legacy_t authSubscriptionLegacy;
@@ -426,43 +443,44 @@ void ValidatorRapidJsonParser::getRelatedResources(
   }
 }
 
-void ValidatorRapidJsonParser::getProvJournal(
-    const rapidjson::Value& attrData, entities::ProvJournal& provJournal) {
-  provJournal.notifRef = getString(attrData, JSON_NOTIF_REF);
+template <typename Journal>
+void ValidatorRapidJsonParser::getProvJournal(const rapidjson::Value& attrData,
+                                              Journal& provJournal) {
+  provJournal.notifRef = getStringView(attrData, JSON_NOTIF_REF);
 
-  provJournal.imsi = getString(attrData, JSON_IMSI_TYPE);
+  provJournal.imsi = getStringView(attrData, JSON_IMSI_TYPE);
 
-  provJournal.imsiMask = getString(attrData, JSON_IMSI_MASK);
+  provJournal.imsiMask = getStringView(attrData, JSON_IMSI_MASK);
 
-  provJournal.imsiExtMask = getString(attrData, JSON_IMSI_EXT_MASK);
+  provJournal.imsiExtMask = getStringView(attrData, JSON_IMSI_EXT_MASK);
 
-  provJournal.msisdn = getString(attrData, JSON_MSISDN);
+  provJournal.msisdn = getStringView(attrData, JSON_MSISDN);
 
-  provJournal.msisdnMask = getString(attrData, JSON_MSISDN_MASK);
+  provJournal.msisdnMask = getStringView(attrData, JSON_MSISDN_MASK);
 
-  provJournal.msisdnExtMask = getString(attrData, JSON_MSISDN_EXT_MASK);
+  provJournal.msisdnExtMask = getStringView(attrData, JSON_MSISDN_EXT_MASK);
 
-  provJournal.imsiAux = getString(attrData, JSON_IMSI_AUX);
+  provJournal.imsiAux = getStringView(attrData, JSON_IMSI_AUX);
 
-  provJournal.imsiAuxMask = getString(attrData, JSON_IMSI_AUX_MASK);
+  provJournal.imsiAuxMask = getStringView(attrData, JSON_IMSI_AUX_MASK);
 
-  provJournal.imsiAuxExtMask = getString(attrData, JSON_IMSI_AUX_EXT_MASK);
+  provJournal.imsiAuxExtMask = getStringView(attrData, JSON_IMSI_AUX_EXT_MASK);
 
-  provJournal.impi = getString(attrData, JSON_IMPI);
+  provJournal.impi = getStringView(attrData, JSON_IMPI);
 
-  provJournal.impiMask = getString(attrData, JSON_IMPI_MASK);
+  provJournal.impiMask = getStringView(attrData, JSON_IMPI_MASK);
 
-  provJournal.impiExtMask = getString(attrData, JSON_IMPI_EXT_MASK);
+  provJournal.impiExtMask = getStringView(attrData, JSON_IMPI_EXT_MASK);
 
-  provJournal.secImpi = getString(attrData, JSON_SEC_IMPI);
+  provJournal.secImpi = getStringView(attrData, JSON_SEC_IMPI);
 
-  provJournal.impiAux = getString(attrData, JSON_IMPI_AUX);
+  provJournal.impiAux = getStringView(attrData, JSON_IMPI_AUX);
 
-  provJournal.username = getString(attrData, JSON_USERNAME);
+  provJournal.username = getStringView(attrData, JSON_USERNAME);
 
-  provJournal.usernameMask = getString(attrData, JSON_USERNAME_MASK);
+  provJournal.usernameMask = getStringView(attrData, JSON_USERNAME_MASK);
 
-  provJournal.usernameExtMask = getString(attrData, JSON_USERNAME_EXT_MASK);
+  provJournal.usernameExtMask = getStringView(attrData, JSON_USERNAME_EXT_MASK);
 
   if (attrData.HasMember(JSON_IMSICHO_STATUS)) {
     if (attrData[JSON_IMSICHO_STATUS].IsInt()) {
@@ -470,55 +488,59 @@ void ValidatorRapidJsonParser::getProvJournal(
     }
   }
 
-  provJournal.imsiExpiryDate = getString(attrData, JSON_IMSI_EXPIRY_DATE);
+  provJournal.imsiExpiryDate = getStringView(attrData, JSON_IMSI_EXPIRY_DATE);
 
-  provJournal.imsiChoExec = getString(attrData, JSON_IMSICHO_EXEC);
+  provJournal.imsiChoExec = getStringView(attrData, JSON_IMSICHO_EXEC);
 
   if (attrData.HasMember(JSON_IMPUCHO_IDS)) {
     if (attrData[JSON_IMPUCHO_IDS].IsArray()) {
       for (auto& v : attrData[JSON_IMPUCHO_IDS].GetArray()) {
         if (v.IsString()) {
-          provJournal.impuChoIds.push_back(v.GetString());
+          provJournal.impuChoIds.emplace_back(v.GetString(),
+                                              v.GetStringLength());
         }
       }
     }
   }
 
-  provJournal.mscIdAux = getString(attrData, JSON_MSC_ID_AUX);
+  provJournal.mscIdAux = getStringView(attrData, JSON_MSC_ID_AUX);
 
-  provJournal.notifInfo = getString(attrData, JSON_NOTIF_INFO);
+  provJournal.notifInfo = getStringView(attrData, JSON_NOTIF_INFO);
 
-  provJournal.ueFunctionMask = getString(attrData, JSON_UE_FUNCTION_MASK);
+  provJournal.ueFunctionMask = getStringView(attrData, JSON_UE_FUNCTION_MASK);
 
   if (attrData.HasMember(JSON_EXT_ID_LIST)) {
     if (attrData[JSON_EXT_ID_LIST].IsArray()) {
       for (auto& v : attrData[JSON_EXT_ID_LIST].GetArray()) {
         if (v.IsString()) {
-          provJournal.extIdList.push_back(v.GetString());
+          provJournal.extIdList.emplace_back(v.GetString(),
+                                             v.GetStringLength());
         }
       }
     }
   }
 
-  provJournal.nai = getString(attrData, JSON_NAI);
+  provJournal.nai = getStringView(attrData, JSON_NAI);
 
-  provJournal.naiMask = getString(attrData, JSON_NAI_MASK);
+  provJournal.naiMask = getStringView(attrData, JSON_NAI_MASK);
 
-  provJournal.naiExtMask = getString(attrData, JSON_NAI_EXT_MASK);
+  provJournal.naiExtMask = getStringView(attrData, JSON_NAI_EXT_MASK);
 
   if (attrData.HasMember(JSON_SUBS_ID_LIST)) {
     if (attrData[JSON_SUBS_ID_LIST].IsArray()) {
       for (auto& v : attrData[JSON_SUBS_ID_LIST].GetArray()) {
         if (v.IsObject()) {
-          entities::SubscriberIdentitiesId subsId;
+          typename decltype(provJournal.subsIdList)::value_type subsId;
           rapidjson::Value::ConstMemberIterator itr =
               v.FindMember(JSON_SUBS_ID);
           if (itr != v.MemberEnd()) {
-            subsId.id = itr->value.GetString();
+            subsId.id = std::string_view{itr->value.GetString(),
+                                         itr->value.GetStringLength()};
           }
           itr = v.FindMember(JSON_SUBS_PREFIX);
           if (itr != v.MemberEnd()) {
-            subsId.prefix = itr->value.GetString();
+            subsId.prefix = std::string_view{itr->value.GetString(),
+                                             itr->value.GetStringLength()};
           }
           provJournal.subsIdList.push_back(subsId);
         }
@@ -648,6 +670,15 @@ std::string ValidatorRapidJsonParser::getString(
   return {};
 }
 
+std::string_view ValidatorRapidJsonParser::getStringView(
+    const rapidjson::Value& attrData, const char* key) {
+  auto it = attrData.FindMember(key);
+  if (it != attrData.MemberEnd() and it->value.IsString()) {
+    return {it->value.GetString(), it->value.GetStringLength()};
+  }
+  return {};
+}
+
 std::string ValidatorRapidJsonParser::sortLDAPoctetString(
     const std::string& str) {
   std::string ordered, dest;
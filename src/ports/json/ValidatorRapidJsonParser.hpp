@@ -1,6 +1,7 @@
 #ifndef __UDM_PROVISIONING_VALIDATOR_RAPIDJSON_PARSER_HPP__
 #define __UDM_PROVISIONING_VALIDATOR_RAPIDJSON_PARSER_HPP__
 
+#include "entities/RequestArena.hpp"
 #include "entities/ValidationData.hpp"
 #include "rapidjson/document.h"
 
@@ -12,6 +13,12 @@ class ValidatorRapidJsonParser final {
  public:
   ValidatorRapidJsonParser() = default;
   explicit ValidatorRapidJsonParser(const std::string&);
+  // Takes ownership of the body and parses it in situ. Related provJournals
+  // are then stored as prov_journal_view_t borrowing from the body, so the
+  // parser must outlive the ValidationData it fills.
+  explicit ValidatorRapidJsonParser(std::string&&);
+  // Same as above, with the DOM allocated from the request arena
+  ValidatorRapidJsonParser(std::string&&, entities::RequestArena&);
   ValidatorRapidJsonParser(ValidatorRapidJsonParser&&) = delete;
   ~ValidatorRapidJsonParser() = default;
   inline bool error() const;
@@ -32,7 +39,8 @@ class ValidatorRapidJsonParser final {
   void getAuthSubscriptionDynamicData(
       const rapidjson::Value&, entities::auth_subscription_dynamic_data_t&,
       entities::ValidationData&, const std::string&);
-  void getProvJournal(const rapidjson::Value&, entities::ProvJournal&);
+  template <typename Journal>
+  void getProvJournal(const rapidjson::Value&, Journal&);
   void getAuthSubscriptionLegacy(const rapidjson::Value&,
                                  entities::auth_subscription_legacy_t&);
   void getVendorSpecific(const rapidjson::Value&, entities::vendorSpecific_t&);
@@ -44,6 +52,10 @@ class ValidatorRapidJsonParser final {
                                             const std::string&);
   std::string getString(const rapidjson::Value&, const char*,
                         const bool& = false, const bool& = false);
+  static std::string_view getStringView(const rapidjson::Value&, const char*);
+  std::string rJsonBuffer;
+  bool rJsonInsitu;
+  rapidjson::MemoryPoolAllocator<> rJsonAllocator;
   rapidjson::Document rJsonDoc;
   bool rJsonParseError;
   std::string rJsonParseErrorStr;
@@ -0,0 +1,1032 @@
+#include "ValidatorRapidJsonSaxParser.hpp"
+
+#include <array>
+#include <bitset>
+#include <climits>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "JsonConstants.hpp"
+#include "ValidatorRapidJsonParser.hpp"
+#include "codec/Codec.hpp"
+#include "entities/ErrorText.hpp"
+#include "rapidjson/reader.h"
+
+namespace port {
+namespace secondary {
+namespace json {
+
+namespace {
+
+constexpr std::string_view VENDOR_SPECIFIC_PREFIX = "vendorSpecific-";
+
+template <std::size_t N>
+using names_t = std::array<std::string_view, N>;
+
+constexpr auto UNKNOWN_MEMBER = SIZE_MAX;
+
+template <std::size_t N>
+std::size_t indexOf(const names_t<N>& names, std::string_view name) {
+  for (std::size_t i = 0; i < N; ++i) {
+    if (names[i] == name) {
+      return i;
+    }
+  }
+  return UNKNOWN_MEMBER;
+}
+
+constexpr names_t<2> ROOT_MEMBERS = {JSON_CHANGES, JSON_RELATED_RESOURCES};
+enum { ROOT_CHANGES, ROOT_RELATED_RESOURCES };
+
+constexpr names_t<3> CHANGE_MEMBERS = {JSON_OPERATION, JSON_RESOURCE_PATH,
+                                       JSON_DATA};
+enum { CHANGE_OPERATION, CHANGE_RESOURCE_PATH, CHANGE_DATA };
+
+constexpr names_t<2> AUTH_MEMBERS = {JSON_AUTH_SUBSCRIPTION_STATIC_DATA,
+                                     JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA};
+enum { AUTH_STATIC_DATA, AUTH_DYNAMIC_DATA };
+
+// In the order ValidatorRapidJsonParser checks them. authenticationMethod,
+// the only mandatory one, is the first
+constexpr names_t<10> STATIC_MEMBERS = {JSON_AUTHENTICATION_METHOD,
+                                        JSON_ENC_PERMANENT_KEY,
+                                        JSON_AUTHENTICATION_MANAGEMENT_FIELD,
+                                        JSON_ALGORITHM_ID,
+                                        JSON_A4_KEY_IND,
+                                        JSON_A4_IND,
+                                        JSON_ENC_OPC_KEY,
+                                        JSON_ENC_TOPC_KEY,
+                                        JSON_A4_KEY_V,
+                                        JSON_AKA_ALGORITHM_IND};
+using static_field_t =
+    std::optional<std::string> entities::auth_subscription_static_data_t::*;
+constexpr std::array<static_field_t, 10> STATIC_FIELDS = {
+    nullptr,
+    &entities::auth_subscription_static_data_t::encPermanentKey,
+    &entities::auth_subscription_static_data_t::authenticationManagementField,
+    &entities::auth_subscription_static_data_t::algorithmId,
+    &entities::auth_subscription_static_data_t::a4KeyInd,
+    &entities::auth_subscription_static_data_t::a4Ind,
+    &entities::auth_subscription_static_data_t::encOpcKey,
+    &entities::auth_subscription_static_data_t::encTopcKey,
+    &entities::auth_subscription_static_data_t::a4KeyV,
+    &entities::auth_subscription_static_data_t::akaAlgorithmInd};
+
+constexpr names_t<3> DYNAMIC_MEMBERS = {JSON_SQN_SCHEME, JSON_SQN,
+                                        JSON_LAST_INDEXES_LIST};
+enum { DYNAMIC_SQN_SCHEME, DYNAMIC_SQN, DYNAMIC_LAST_INDEXES };
+
+using journal_field_t = entities::string_view_t entities::ProvJournalView::*;
+constexpr names_t<30> JOURNAL_MEMBERS = {
+    JSON_NOTIF_REF,         JSON_IMSI_TYPE,        JSON_IMSI_MASK,
+    JSON_IMSI_EXT_MASK,     JSON_MSISDN,           JSON_MSISDN_MASK,
+    JSON_MSISDN_EXT_MASK,   JSON_IMSI_AUX,         JSON_IMSI_AUX_MASK,
+    JSON_IMSI_AUX_EXT_MASK, JSON_IMPI,             JSON_IMPI_MASK,
+    JSON_IMPI_EXT_MASK,     JSON_SEC_IMPI,         JSON_IMPI_AUX,
+    JSON_USERNAME,          JSON_USERNAME_MASK,    JSON_USERNAME_EXT_MASK,
+    JSON_IMSI_EXPIRY_DATE,  JSON_IMSICHO_EXEC,     JSON_MSC_ID_AUX,
+    JSON_NOTIF_INFO,        JSON_UE_FUNCTION_MASK, JSON_NAI,
+    JSON_NAI_MASK,          JSON_NAI_EXT_MASK,     JSON_IMSICHO_STATUS,
+    JSON_IMPUCHO_IDS,       JSON_EXT_ID_LIST,      JSON_SUBS_ID_LIST};
+// String members come first, in the same order as JOURNAL_MEMBERS
+constexpr std::array<journal_field_t, 26> JOURNAL_FIELDS = {
+    &entities::ProvJournalView::notifRef,
+    &entities::ProvJournalView::imsi,
+    &entities::ProvJournalView::imsiMask,
+    &entities::ProvJournalView::imsiExtMask,
+    &entities::ProvJournalView::msisdn,
+    &entities::ProvJournalView::msisdnMask,
+    &entities::ProvJournalView::msisdnExtMask,
+    &entities::ProvJournalView::imsiAux,
+    &entities::ProvJournalView::imsiAuxMask,
+    &entities::ProvJournalView::imsiAuxExtMask,
+    &entities::ProvJournalView::impi,
+    &entities::ProvJournalView::impiMask,
+    &entities::ProvJournalView::impiExtMask,
+    &entities::ProvJournalView::secImpi,
+    &entities::ProvJournalView::impiAux,
+    &entities::ProvJournalView::username,
+    &entities::ProvJournalView::usernameMask,
+    &entities::ProvJournalView::usernameExtMask,
+    &entities::ProvJournalView::imsiExpiryDate,
+    &entities::ProvJournalView::imsiChoExec,
+    &entities::ProvJournalView::mscIdAux,
+    &entities::ProvJournalView::notifInfo,
+    &entities::ProvJournalView::ueFunctionMask,
+    &entities::ProvJournalView::nai,
+    &entities::ProvJournalView::naiMask,
+    &entities::ProvJournalView::naiExtMask};
+enum {
+  JOURNAL_IMSICHO_STATUS = JOURNAL_FIELDS.size(),
+  JOURNAL_IMPUCHO_IDS,
+  JOURNAL_EXT_ID_LIST,
+  JOURNAL_SUBS_ID_LIST
+};
+
+constexpr names_t<2> SUBS_ID_MEMBERS = {JSON_SUBS_ID, JSON_SUBS_PREFIX};
+enum { SUBS_ID_ID, SUBS_ID_PREFIX };
+
+constexpr names_t<13> LEGACY_MEMBERS = {
+    JSON_F_SET_IND,  JSON_KIND,    JSON_A4_IND_LEGACY, JSON_AMF_VALUE,
+    JSON_AKA_TYPE,   JSON_VNUMBER, JSON_AKA_ALG_IND,   JSON_EKI,
+    JSON_EKI_BASE64, JSON_EOPC,    JSON_EOPC_BASE64,   JSON_SEQ_HE,
+    JSON_SEQ_HE_BASE64};
+using legacy_field_t = std::optional<int> entities::AuthSubscriptionLegacy::*;
+// Integer members come first, in the same order as LEGACY_MEMBERS
+constexpr std::array<legacy_field_t, 6> LEGACY_FIELDS = {
+    &entities::AuthSubscriptionLegacy::fSetInd,
+    &entities::AuthSubscriptionLegacy::kind,
+    &entities::AuthSubscriptionLegacy::a4Ind,
+    &entities::AuthSubscriptionLegacy::amfValue,
+    &entities::AuthSubscriptionLegacy::akaType,
+    &entities::AuthSubscriptionLegacy::vNumber};
+enum {
+  LEGACY_VNUMBER = 5,
+  LEGACY_AKA_ALG_IND,
+  LEGACY_EKI,
+  LEGACY_EKI_BASE64,
+  LEGACY_EOPC,
+  LEGACY_EOPC_BASE64,
+  LEGACY_SEQ_HE,
+  LEGACY_SEQ_HE_BASE64
+};
+
+using scalar_t = std::variant<std::nullptr_t, bool, int, unsigned, std::int64_t,
+                              std::uint64_t, double, std::string_view>;
+
+// A value as seen by the object or array holding it: either a scalar or the
+// start of a nested object or array
+struct Token {
+  enum Kind { SCALAR, OBJECT, ARRAY };
+  Kind kind;
+  const scalar_t* scalar;
+
+  inline bool isObject() const { return kind == OBJECT; }
+  inline bool isArray() const { return kind == ARRAY; }
+  inline bool isString() const {
+    return kind == SCALAR and std::holds_alternative<std::string_view>(*scalar);
+  }
+  inline std::string_view getString() const {
+    return std::get<std::string_view>(*scalar);
+  }
+  // Same as rapidjson::Value::IsInt()
+  inline bool isInt() const {
+    if (kind != SCALAR) {
+      return false;
+    }
+    if (auto u = std::get_if<unsigned>(scalar)) {
+      return *u <= static_cast<unsigned>(INT_MAX);
+    }
+    return std::holds_alternative<int>(*scalar);
+  }
+  inline int getInt() const {
+    if (auto u = std::get_if<unsigned>(scalar)) {
+      return static_cast<int>(*u);
+    }
+    return std::get<int>(*scalar);
+  }
+};
+
+entities::genericValue_t toValue(const scalar_t& scalar) {
+  return std::visit(
+      [](auto value) -> entities::genericValue_t {
+        using value_t = decltype(value);
+        if constexpr (std::is_same_v<value_t, std::nullptr_t>) {
+          return entities::genericValue_t{};
+        } else if constexpr (std::is_same_v<value_t, std::string_view>) {
+          return entities::genericValue_t{rapidjson::StringRef(
+              value.data(), static_cast<rapidjson::SizeType>(value.size()))};
+        } else {
+          return entities::genericValue_t{value};
+        }
+      },
+      scalar);
+}
+
+enum class Presence { ABSENT, WRONG_TYPE, PRESENT };
+
+struct StringField {
+  Presence presence{Presence::ABSENT};
+  std::string_view value;
+
+  inline void set(const Token& token) {
+    if (token.isString()) {
+      presence = Presence::PRESENT;
+      value = token.getString();
+    } else {
+      presence = Presence::WRONG_TYPE;
+    }
+  }
+};
+
+// An authSubscription being read. Its errors can only be reported once it
+// is complete: static data ones go first, whatever the order of the members
+struct AuthState {
+  Presence staticData{Presence::ABSENT};
+  std::array<StringField, STATIC_MEMBERS.size()> staticFields;
+  entities::vendorSpecific_t vendorSpecific;
+  Presence dynamicData{Presence::ABSENT};
+  StringField sqnScheme;
+  StringField sqn;
+  Presence lastIndexes{Presence::ABSENT};
+  entities::last_indexes_list_t lastIndexesList;
+  std::size_t lastIndexesErrors{0};
+};
+
+struct LegacyState {
+  std::array<std::optional<int>, LEGACY_FIELDS.size() + 1> numbers;
+  std::array<std::optional<std::string_view>, 6> strings;
+};
+
+void addError(entities::ValidationData& data, const std::string& resourcePath,
+              entities::ErrorKind kind, std::string_view field,
+              std::string_view other = {}) {
+  data.addError(
+      entities::constraintViolation(resourcePath, kind, field, other));
+}
+
+entities::auth_subscription_static_data_t toStaticData(
+    AuthState& state, entities::ValidationData& data,
+    const std::string& resourcePath) {
+  entities::auth_subscription_static_data_t staticData;
+  staticData.vendorSpecific.swap(state.vendorSpecific);
+
+  const auto& method = state.staticFields[0];
+  if (method.presence == Presence::ABSENT) {
+    addError(data, resourcePath,
+             entities::ErrorKind::MANDATORY_FIELD_NOT_FOUND_IN,
+             JSON_AUTHENTICATION_METHOD, JSON_AUTH_SUBSCRIPTION_STATIC_DATA);
+  } else if (method.presence == Presence::WRONG_TYPE) {
+    addError(data, resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+             JSON_AUTHENTICATION_METHOD);
+  } else {
+    staticData.authenticationMethod = method.value;
+  }
+
+  for (std::size_t i = 1; i < STATIC_FIELDS.size(); ++i) {
+    const auto& field = state.staticFields[i];
+    if (field.presence == Presence::WRONG_TYPE) {
+      addError(data, resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+               STATIC_MEMBERS[i]);
+    } else if (field.presence == Presence::PRESENT) {
+      (staticData.*STATIC_FIELDS[i]).emplace(field.value);
+    }
+  }
+  return staticData;
+}
+
+entities::auth_subscription_dynamic_data_t toDynamicData(
+    AuthState& state, entities::ValidationData& data,
+    const std::string& resourcePath) {
+  entities::auth_subscription_dynamic_data_t dynamicData;
+  if (state.sqnScheme.presence == Presence::WRONG_TYPE) {
+    addError(data, resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+             JSON_SQN_SCHEME);
+  } else if (state.sqnScheme.presence == Presence::PRESENT) {
+    dynamicData.sqnScheme.emplace(state.sqnScheme.value);
+  }
+  if (state.sqn.presence == Presence::WRONG_TYPE) {
+    addError(data, resourcePath, entities::ErrorKind::NOT_STRING_FIELD,
+             JSON_SQN);
+  } else if (state.sqn.presence == Presence::PRESENT) {
+    dynamicData.sqn.emplace(state.sqn.value);
+  }
+  if (state.lastIndexes == Presence::WRONG_TYPE) {
+    addError(data, resourcePath, entities::ErrorKind::NOT_OBJECT_FIELD,
+             JSON_LAST_INDEXES_LIST);
+  } else if (state.lastIndexes == Presence::PRESENT) {
+    for (std::size_t i = 0; i < state.lastIndexesErrors; ++i) {
+      data.addError(entities::constraintViolation(
+          resourcePath, entities::LAST_INDEXES_VALUE_NOT_INTEGER));
+    }
+    dynamicData.lastIndexesList.emplace(std::move(state.lastIndexesList));
+  }
+  return dynamicData;
+}
+
+void toAuthSubscription(AuthState& state, entities::ValidationData& data,
+                      const std::string& resourcePath,
+                      entities::auth_subscription_t& authSubscription) {
+  if (state.staticData == Presence::ABSENT) {
+    addError(data, resourcePath,
+             entities::ErrorKind::MANDATORY_FIELD_NOT_FOUND,
+             JSON_AUTH_SUBSCRIPTION_STATIC_DATA);
+    return;
+  }
+  if (state.staticData == Presence::WRONG_TYPE) {
+    addError(data, resourcePath, entities::ErrorKind::NOT_OBJECT_FIELD,
+             JSON_AUTH_SUBSCRIPTION_STATIC_DATA);
+    return;
+  }
+  authSubscription.authSubscriptionStaticData =
+      toStaticData(state, data, resourcePath);
+  if (state.dynamicData == Presence::WRONG_TYPE) {
+    addError(data, resourcePath, entities::ErrorKind::NOT_OBJECT_FIELD,
+             JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA);
+  } else if (state.dynamicData == Presence::PRESENT) {
+    authSubscription.authSubscriptionDynamicData =
+        toDynamicData(state, data, resourcePath);
+  }
+}
+
+std::string legacyString(const std::optional<std::string_view>& value,
+                         bool reverseOrderLDAP, bool isBase64Encoded) {
+  if (not value) {
+    return {};
+  }
+  std::string decoded{*value};
+  if (isBase64Encoded) {
+    decoded = ::codec::decodeFromBase64(decoded);
+  }
+  if (not reverseOrderLDAP) {
+    return decoded;
+  }
+  return ValidatorRapidJsonParser::sortLDAPoctetString(decoded);
+}
+
+}  // namespace
+
+// Receives the reader events. Each object or array open in the body has its
+// level in the stack, telling what it is and so what its members are for.
+// Subtrees nothing is extracted from are skipped by a single SKIP level
+// counting their depth.
+class ValidatorRapidJsonSaxParser::Handler final
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler> {
+ public:
+  explicit Handler(ValidatorRapidJsonSaxParser& parser) : parser{parser} {}
+
+  bool Null() { return scalar(nullptr); }
+  bool Bool(bool b) { return scalar(b); }
+  bool Int(int i) { return scalar(i); }
+  bool Uint(unsigned u) { return scalar(u); }
+  bool Int64(std::int64_t i) { return scalar(i); }
+  bool Uint64(std::uint64_t u) { return scalar(u); }
+  bool Double(double d) { return scalar(d); }
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    return scalar(std::string_view{str, length});
+  }
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    key = std::string_view{str, length};
+    if (not stack.empty() and stack.back().frame == Frame::VENDOR) {
+      builder.push_back(toValue(key));
+    }
+    return true;
+  }
+  bool StartObject() { return open(Token::OBJECT); }
+  bool StartArray() { return open(Token::ARRAY); }
+  bool EndObject(rapidjson::SizeType members) { return close(2 * members); }
+  bool EndArray(rapidjson::SizeType elements) { return close(elements); }
+
+ private:
+  enum class Frame {
+    ROOT,
+    CHANGES,
+    CHANGE,
+    AUTH,
+    STATIC,
+    DYNAMIC,
+    LAST_INDEXES,
+    VENDOR,
+    RELATED,
+    IDS,
+    JOURNAL,
+    JOURNAL_LIST,
+    SUBS_ID_LIST,
+    SUBS_ID,
+    LEGACY,
+    SKIP
+  };
+
+  struct Level {
+    Frame frame;
+    // authSubscription filled by AUTH, STATIC, DYNAMIC and LAST_INDEXES
+    AuthState* auth{nullptr};
+    // strings filled by JOURNAL_LIST
+    std::vector<entities::string_view_t>* list{nullptr};
+    // known members already read, the DOM walk only looks at the first one
+    std::bitset<32> seen{};
+    // containers open in a SKIP or VENDOR level
+    std::size_t depth{0};
+
+    inline bool first(std::size_t member) {
+      if (member == UNKNOWN_MEMBER or seen.test(member)) {
+        return false;
+      }
+      seen.set(member);
+      return true;
+    }
+  };
+
+  // An authSubscription under a related resource path, found by suffix
+  struct Entry {
+    std::string resourcePath;
+    entities::auth_subscription_t authSubscription;
+    entities::ValidationData errors;
+  };
+
+  bool scalar(const scalar_t& value) {
+    if (stack.empty()) {
+      return true;
+    }
+    switch (stack.back().frame) {
+      case Frame::SKIP:
+        break;
+      case Frame::VENDOR:
+        builder.push_back(toValue(value));
+        break;
+      default:
+        onValue(Token{Token::SCALAR, &value});
+    }
+    return true;
+  }
+
+  bool open(Token::Kind kind) {
+    if (stack.empty()) {
+      stack.push_back({kind == Token::OBJECT ? Frame::ROOT : Frame::SKIP});
+      stack.back().depth = 1;
+      return true;
+    }
+    auto& top = stack.back();
+    if (top.frame == Frame::SKIP) {
+      ++top.depth;
+    } else if (top.frame == Frame::VENDOR) {
+      ++top.depth;
+      builder.emplace_back(kind == Token::OBJECT ? rapidjson::kObjectType
+                                                 : rapidjson::kArrayType);
+    } else {
+      onValue(Token{kind, nullptr});
+    }
+    return true;
+  }
+
+  // values is the number of values the container holds, keys included
+  bool close(std::size_t values) {
+    auto& top = stack.back();
+    if (top.frame == Frame::SKIP) {
+      if (--top.depth == 0) {
+        stack.pop_back();
+      }
+      return true;
+    }
+    if (top.frame == Frame::VENDOR) {
+      closeVendor(values);
+      return true;
+    }
+    auto level = top;
+    stack.pop_back();
+    finish(level);
+    return true;
+  }
+
+  void push(Frame frame, AuthState* auth = nullptr) {
+    stack.push_back({frame, auth});
+  }
+
+  void skip(const Token& token) {
+    if (token.kind == Token::SCALAR) {
+      return;
+    }
+    if (stack.back().frame == Frame::SKIP) {
+      ++stack.back().depth;
+    } else {
+      push(Frame::SKIP);
+      stack.back().depth = 1;
+    }
+  }
+
+  // Stops reading "changes", as the DOM walk does, skipping what is left
+  // of them
+  void fail(const std::string& error, const Token& token) {
+    parser.changesError = error;
+    auto open = stack.size() - 1;
+    stack.resize(1);
+    if (open > 0) {
+      push(Frame::SKIP);
+      stack.back().depth = open;
+    }
+    skip(token);
+  }
+
+  void onValue(const Token& token) {
+    auto& level = stack.back();
+    switch (level.frame) {
+      case Frame::ROOT:
+        return onRoot(level, token);
+      case Frame::CHANGES:
+        return onChanges(token);
+      case Frame::CHANGE:
+        return onChange(token);
+      case Frame::AUTH:
+        return onAuth(level, token);
+      case Frame::STATIC:
+        return onStatic(level, token);
+      case Frame::DYNAMIC:
+        return onDynamic(level, token);
+      case Frame::LAST_INDEXES:
+        return onLastIndexes(level, token);
+      case Frame::RELATED:
+        return onRelated(token);
+      case Frame::IDS:
+        return onIds(level, token);
+      case Frame::JOURNAL:
+        return onJournal(level, token);
+      case Frame::JOURNAL_LIST:
+        if (token.isString()) {
+          level.list->push_back(token.getString());
+        }
+        return skip(token);
+      case Frame::SUBS_ID_LIST:
+        if (token.isObject()) {
+          subsId = {};
+          return push(Frame::SUBS_ID);
+        }
+        return skip(token);
+      case Frame::SUBS_ID:
+        return onSubsId(level, token);
+      case Frame::LEGACY:
+        return onLegacy(level, token);
+      default:
+        return skip(token);
+    }
+  }
+
+  void onRoot(Level& level, const Token& token) {
+    auto member = indexOf(ROOT_MEMBERS, key);
+    if (not level.first(member)) {
+      return skip(token);
+    }
+    if (member == ROOT_CHANGES) {
+      if (not token.isArray()) {
+        return fail(std::string{JSON_CHANGES} + " is not a list", token);
+      }
+      return push(Frame::CHANGES);
+    }
+    if (token.isObject()) {
+      return push(Frame::RELATED);
+    }
+    skip(token);
+  }
+
+  void onChanges(const Token& token) {
+    if (not token.isObject()) {
+      return fail("change is not an object", token);
+    }
+    change = {};
+    push(Frame::CHANGE);
+  }
+
+  void onChange(const Token& token) {
+    switch (indexOf(CHANGE_MEMBERS, key)) {
+      case CHANGE_OPERATION:
+        if (not token.isString()) {
+          return fail(std::string{JSON_OPERATION} + " is not string", token);
+        }
+        change.operation = token.getString();
+        if (change.operation.empty()) {
+          return fail(parser.changesData.emptyFieldError(JSON_OPERATION),
+                      token);
+        }
+        if (change.operation != JSON_OPERATION_CREATE &&
+            change.operation != JSON_OPERATION_UPDATE &&
+            change.operation != JSON_OPERATION_DELETE) {
+          return fail(
+              "operation value is not allowed. It should be either: CREATE, "
+              "UPDATE or DELETE",
+              token);
+        }
+        return;
+      case CHANGE_RESOURCE_PATH:
+        if (not token.isString()) {
+          return fail(std::string{JSON_RESOURCE_PATH} + " is not string",
+                      token);
+        }
+        change.resourcePath = token.getString();
+        if (change.resourcePath.empty()) {
+          return fail(parser.changesData.emptyFieldError(JSON_RESOURCE_PATH),
+                      token);
+        }
+        return;
+      case CHANGE_DATA:
+        if (not token.isObject()) {
+          return fail(std::string{JSON_DATA} + " is not an object", token);
+        }
+        if (entities::ValidationData::checkAuthSubscriptionUri(
+                change.resourcePath)) {
+          changeAuth = {};
+          return push(Frame::AUTH, &changeAuth);
+        }
+        if (entities::ValidationData::checkAuthSubscriptionStaticDataUri(
+                change.resourcePath)) {
+          changeAuth = {};
+          changeAuth.staticData = Presence::PRESENT;
+          return push(Frame::STATIC, &changeAuth);
+        }
+        return skip(token);
+      default:
+        return skip(token);
+    }
+  }
+
+  void onAuth(Level& level, const Token& token) {
+    auto member = indexOf(AUTH_MEMBERS, key);
+    if (not level.first(member)) {
+      return skip(token);
+    }
+    auto auth = level.auth;
+    auto& presence =
+        member == AUTH_STATIC_DATA ? auth->staticData : auth->dynamicData;
+    if (not token.isObject()) {
+      presence = Presence::WRONG_TYPE;
+      return skip(token);
+    }
+    presence = Presence::PRESENT;
+    push(member == AUTH_STATIC_DATA ? Frame::STATIC : Frame::DYNAMIC, auth);
+  }
+
+  void onStatic(Level& level, const Token& token) {
+    auto auth = level.auth;
+    if (key.starts_with(VENDOR_SPECIFIC_PREFIX)) {
+      std::string name{key};
+      if (auth->vendorSpecific.contains(name)) {
+        return skip(token);
+      }
+      if (token.kind == Token::SCALAR) {
+        parser.vendorValues.push_back(toValue(*token.scalar));
+        auth->vendorSpecific.emplace(name, parser.vendorValues.back());
+        return;
+      }
+      vendorName = std::move(name);
+      builder.emplace_back(token.isObject() ? rapidjson::kObjectType
+                                            : rapidjson::kArrayType);
+      push(Frame::VENDOR, auth);
+      stack.back().depth = 1;
+      return;
+    }
+    auto member = indexOf(STATIC_MEMBERS, key);
+    if (level.first(member)) {
+      auth->staticFields[member].set(token);
+    }
+    skip(token);
+  }
+
+  void onDynamic(Level& level, const Token& token) {
+    auto member = indexOf(DYNAMIC_MEMBERS, key);
+    if (not level.first(member)) {
+      return skip(token);
+    }
+    auto auth = level.auth;
+    switch (member) {
+      case DYNAMIC_SQN_SCHEME:
+        auth->sqnScheme.set(token);
+        return skip(token);
+      case DYNAMIC_SQN:
+        auth->sqn.set(token);
+        return skip(token);
+      default:
+        if (not token.isObject()) {
+          auth->lastIndexes = Presence::WRONG_TYPE;
+          return skip(token);
+        }
+        auth->lastIndexes = Presence::PRESENT;
+        return push(Frame::LAST_INDEXES, auth);
+    }
+  }
+
+  void onLastIndexes(Level& level, const Token& token) {
+    if (not token.isInt()) {
+      ++level.auth->lastIndexesErrors;
+      return skip(token);
+    }
+    level.auth->lastIndexesList.insert({std::string{key}, token.getInt()});
+  }
+
+  void onRelated(const Token& token) {
+    resourcePath = key;
+    if (not token.isObject()) {
+      return skip(token);
+    }
+    if (entities::ValidationData::checkAuthSubscriptionUri(resourcePath)) {
+      idsAuth = {};
+      entries.clear();
+      return push(Frame::IDS, &idsAuth);
+    }
+    if (resourcePath.ends_with(JSON_PROV_JOURNAL)) {
+      journal = {};
+      return push(Frame::JOURNAL);
+    }
+    if (entities::ValidationData::checkAuthSubscriptionLegacyUri(
+            resourcePath)) {
+      legacy = {};
+      return push(Frame::LEGACY);
+    }
+    skip(token);
+  }
+
+  // The members of a related authSubscription are either its static and
+  // dynamic data or, when there is no static data, authSubscriptions whose
+  // path is suffixed by the member name. Both readings are kept until the
+  // end of the object tells which one the DOM walk takes
+  void onIds(Level& level, const Token& token) {
+    auto member = indexOf(AUTH_MEMBERS, key);
+    if (member == AUTH_STATIC_DATA) {
+      return onAuth(level, token);
+    }
+    if (token.isObject()) {
+      entries.push_back(
+          {entities::ValidationData::addSuffixToPath(resourcePath,
+                                                     std::string{key}),
+           {},
+           {}});
+    }
+    if (member == AUTH_DYNAMIC_DATA) {
+      // As an authSubscription of its own, dynamic data has no static data
+      if (token.isObject()) {
+        auto& entry = entries.back();
+        addError(entry.errors, entry.resourcePath,
+                 entities::ErrorKind::MANDATORY_FIELD_NOT_FOUND,
+                 JSON_AUTH_SUBSCRIPTION_STATIC_DATA);
+      }
+      return onAuth(level, token);
+    }
+    if (not token.isObject()) {
+      return skip(token);
+    }
+    entryAuth = {};
+    push(Frame::AUTH, &entryAuth);
+  }
+
+  void onJournal(Level& level, const Token& token) {
+    auto member = indexOf(JOURNAL_MEMBERS, key);
+    if (not level.first(member)) {
+      return skip(token);
+    }
+    if (member < JOURNAL_FIELDS.size()) {
+      if (token.isString()) {
+        journal.*JOURNAL_FIELDS[member] = token.getString();
+      }
+      return skip(token);
+    }
+    switch (member) {
+      case JOURNAL_IMSICHO_STATUS:
+        if (token.isInt()) {
+          journal.imsiChoStatus = token.getInt();
+        }
+        return skip(token);
+      case JOURNAL_IMPUCHO_IDS:
+      case JOURNAL_EXT_ID_LIST:
+        if (not token.isArray()) {
+          return skip(token);
+        }
+        push(Frame::JOURNAL_LIST);
+        stack.back().list = member == JOURNAL_IMPUCHO_IDS
+                                ? &journal.impuChoIds
+                                : &journal.extIdList;
+        return;
+      default:
+        if (not token.isArray()) {
+          return skip(token);
+        }
+        return push(Frame::SUBS_ID_LIST);
+    }
+  }
+
+  void onSubsId(Level& level, const Token& token) {
+    auto member = indexOf(SUBS_ID_MEMBERS, key);
+    if (level.first(member) and token.isString()) {
+      (member == SUBS_ID_ID ? subsId.id : subsId.prefix) = token.getString();
+    }
+    skip(token);
+  }
+
+  void onLegacy(Level& level, const Token& token) {
+    auto member = indexOf(LEGACY_MEMBERS, key);
+    if (not level.first(member)) {
+      return skip(token);
+    }
+    if (member <= LEGACY_AKA_ALG_IND) {
+      if (token.isInt()) {
+        legacy.numbers[member] = token.getInt();
+      }
+    } else if (token.isString()) {
+      legacy.strings[member - LEGACY_EKI] = token.getString();
+    }
+    skip(token);
+  }
+
+  void closeVendor(std::size_t values) {
+    auto begin = builder.size() - values;
+    auto& container = builder[begin - 1];
+    auto& allocator = parser.rJsonAllocator;
+    if (container.IsObject()) {
+      for (auto i = begin; i < builder.size(); i += 2) {
+        container.AddMember(builder[i], builder[i + 1], allocator);
+      }
+    } else {
+      for (auto i = begin; i < builder.size(); ++i) {
+        container.PushBack(builder[i], allocator);
+      }
+    }
+    builder.erase(builder.begin() + begin, builder.end());
+    auto& top = stack.back();
+    if (--top.depth > 0) {
+      return;
+    }
+    parser.vendorValues.push_back(std::move(builder.back()));
+    builder.clear();
+    top.auth->vendorSpecific.emplace(std::move(vendorName),
+                                     parser.vendorValues.back());
+    stack.pop_back();
+  }
+
+  void finish(const Level& level) {
+    auto parent = stack.empty() ? Frame::SKIP : stack.back().frame;
+    switch (level.frame) {
+      case Frame::CHANGE:
+        parser.changesData.changes.push_back(change);
+        break;
+      case Frame::AUTH:
+        if (parent == Frame::CHANGE) {
+          toAuthSubscription(changeAuth, parser.changesData,
+                             change.resourcePath, change.authSubscription);
+        } else {
+          auto& entry = entries.back();
+          toAuthSubscription(entryAuth, entry.errors, entry.resourcePath,
+                             entry.authSubscription);
+        }
+        break;
+      case Frame::STATIC:
+        // Static data changed on its own
+        if (parent == Frame::CHANGE) {
+          change.authSubscription.authSubscriptionStaticData =
+              toStaticData(changeAuth, parser.changesData, change.resourcePath);
+        }
+        break;
+      case Frame::IDS:
+        finishIds();
+        break;
+      case Frame::JOURNAL:
+        if (parser.rJsonBorrowed) {
+          parser.relatedData.relatedResources.insert(
+              {resourcePath, std::move(journal)});
+        } else {
+          parser.relatedData.relatedResources.insert(
+              {resourcePath, entities::toProvJournal(journal)});
+        }
+        break;
+      case Frame::SUBS_ID:
+        journal.subsIdList.push_back(subsId);
+        break;
+      case Frame::LEGACY:
+        finishLegacy();
+        break;
+      default:
+        break;
+    }
+  }
+
+  void finishIds() {
+    auto& related = parser.relatedData;
+    if (idsAuth.staticData != Presence::ABSENT) {
+      entities::auth_subscription_t authSub;
+      toAuthSubscription(idsAuth, related, resourcePath, authSub);
+      related.relatedResources.insert({resourcePath, authSub});
+      return;
+    }
+    for (auto& entry : entries) {
+      auto& errors = entry.errors.response.errors;
+      related.response.errors.insert(related.response.errors.end(),
+                                     errors.begin(), errors.end());
+      related.relatedResources.insert(
+          {entry.resourcePath, entry.authSubscription});
+    }
+  }
+
+  void finishLegacy() {
+    entities::auth_subscription_legacy_t authSubscriptionLegacy;
+    for (std::size_t i = 0; i < LEGACY_FIELDS.size(); ++i) {
+      authSubscriptionLegacy.*LEGACY_FIELDS[i] = legacy.numbers[i];
+    }
+    // As the DOM walk does, AKAALGIND is only taken along with VNUMBER
+    if (legacy.numbers[LEGACY_AKA_ALG_IND] and
+        legacy.numbers[LEGACY_VNUMBER]) {
+      authSubscriptionLegacy.akaAlgInd = legacy.numbers[LEGACY_AKA_ALG_IND];
+    }
+
+    const auto& strings = legacy.strings;
+    auto eki = legacyString(strings[LEGACY_EKI - LEGACY_EKI], false, false);
+    if (eki.empty()) {
+      eki = legacyString(strings[LEGACY_EKI_BASE64 - LEGACY_EKI], false, true);
+    }
+    if (not eki.empty()) {
+      authSubscriptionLegacy.eki.emplace(eki);
+    }
+    auto eopc = legacyString(strings[LEGACY_EOPC - LEGACY_EKI], false, false);
+    if (eopc.empty()) {
+      eopc =
+          legacyString(strings[LEGACY_EOPC_BASE64 - LEGACY_EKI], false, true);
+    }
+    if (not eopc.empty()) {
+      authSubscriptionLegacy.eopc.emplace(eopc);
+    }
+    auto seqHe = legacyString(strings[LEGACY_SEQ_HE - LEGACY_EKI], true, false);
+    if (seqHe.empty()) {
+      seqHe =
+          legacyString(strings[LEGACY_SEQ_HE_BASE64 - LEGACY_EKI], true, true);
+    }
+    if (not seqHe.empty()) {
+      authSubscriptionLegacy.seqHe.emplace(seqHe);
+    }
+
+    parser.relatedData.relatedResources.insert(
+        {resourcePath, authSubscriptionLegacy});
+  }
+
+  ValidatorRapidJsonSaxParser& parser;
+  std::vector<Level> stack;
+  // Last member name read
+  std::string_view key;
+  entities::Change change;
+  AuthState changeAuth;
+  std::string resourcePath;
+  AuthState idsAuth;
+  AuthState entryAuth;
+  std::vector<Entry> entries;
+  entities::prov_journal_view_t journal{};
+  entities::SubscriberIdentitiesIdView subsId;
+  LegacyState legacy;
+  // vendorSpecific value being built
+  std::string vendorName;
+  std::vector<entities::genericValue_t> builder;
+};
+
+ValidatorRapidJsonSaxParser::ValidatorRapidJsonSaxParser(
+    const std::string& json_string)
+    : rJsonBuffer{json_string},
+      rJsonBorrowed{false},
+      rJsonAllocator{},
+      rJsonParseError{false},
+      rJsonParseErrorStr{} {
+  parse();
+}
+
+ValidatorRapidJsonSaxParser::ValidatorRapidJsonSaxParser(
+    std::string&& json_string)
+    : rJsonBuffer{std::move(json_string)},
+      rJsonBorrowed{true},
+      rJsonAllocator{},
+      rJsonParseError{false},
+      rJsonParseErrorStr{} {
+  parse();
+}
+
+ValidatorRapidJsonSaxParser::ValidatorRapidJsonSaxParser(
+    std::string&& json_string, entities::RequestArena& arena)
+    : rJsonBuffer{std::move(json_string)},
+      rJsonBorrowed{true},
+      rJsonAllocator{arena.allocate(entities::RequestArena::JSON_POOL_SIZE),
+                     entities::RequestArena::JSON_POOL_SIZE},
+      rJsonParseError{false},
+      rJsonParseErrorStr{} {
+  parse();
+}
+
+void ValidatorRapidJsonSaxParser::parse() {
+  Handler handler{*this};
+  rapidjson::InsituStringStream stream{rJsonBuffer.data()};
+  rapidjson::GenericReader<rapidjson::UTF8<>, rapidjson::UTF8<>,
+                           rapidjson::MemoryPoolAllocator<>>
+      reader{&rJsonAllocator};
+  if (reader.Parse<rapidjson::kParseInsituFlag>(stream, handler).IsError()) {
+    setParsingError("wrong json format");
+  }
+}
+
+bool ValidatorRapidJsonSaxParser::getValidationData(
+    entities::ValidationData& data) {
+  if (error()) {
+    return false;
+  }
+
+  auto& errors = data.response.errors;
+  data.changes.insert(data.changes.end(), changesData.changes.begin(),
+                      changesData.changes.end());
+  errors.insert(errors.end(), changesData.response.errors.begin(),
+                changesData.response.errors.end());
+  if (not changesError.empty()) {
+    setParsingError(changesError);
+    return false;
+  }
+
+  data.relatedResources.insert(relatedData.relatedResources.begin(),
+                               relatedData.relatedResources.end());
+  errors.insert(errors.end(), relatedData.response.errors.begin(),
+                relatedData.response.errors.end());
+  return true;
+}
+
+}  // namespace json
+}  // namespace secondary
+}  // namespace port
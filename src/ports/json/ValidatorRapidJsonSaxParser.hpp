@@ -0,0 +1,77 @@
+#ifndef __UDM_PROVISIONING_VALIDATOR_RAPIDJSON_SAX_PARSER_HPP__
+#define __UDM_PROVISIONING_VALIDATOR_RAPIDJSON_SAX_PARSER_HPP__
+
+#include <deque>
+#include <string>
+
+#include "entities/RequestArena.hpp"
+#include "entities/ValidationData.hpp"
+#include "rapidjson/document.h"
+
+namespace port {
+namespace secondary {
+namespace json {
+
+// Streaming counterpart of ValidatorRapidJsonParser. The body is read once
+// with the rapidjson SAX reader, in situ, and changes and related resources
+// are filled as their tokens arrive: no DOM is built and no member is looked
+// up. Only vendorSpecific attributes, which are echoed as they came, are
+// kept as rapidjson values.
+//
+// Results and errors are the same as ValidatorRapidJsonParser ones: errors
+// are reported in the order the DOM walk would find them, whatever the order
+// of the members in the body, and duplicated members resolve the same way.
+class ValidatorRapidJsonSaxParser final {
+ public:
+  // Works on a copy of the body. Related provJournals are owning
+  explicit ValidatorRapidJsonSaxParser(const std::string&);
+  // Takes ownership of the body. Related provJournals are then stored as
+  // prov_journal_view_t borrowing from it, so the parser must outlive the
+  // ValidationData it fills
+  explicit ValidatorRapidJsonSaxParser(std::string&&);
+  // Same as above, with the reader stack and vendorSpecific values allocated
+  // from the request arena
+  ValidatorRapidJsonSaxParser(std::string&&, entities::RequestArena&);
+  ValidatorRapidJsonSaxParser(ValidatorRapidJsonSaxParser&&) = delete;
+  ~ValidatorRapidJsonSaxParser() = default;
+  inline bool error() const;
+  inline const std::string errorString() const;
+  // Hands the extracted data over, so it can only be called once
+  bool getValidationData(entities::ValidationData&);
+
+ private:
+  class Handler;
+
+  void parse();
+  inline void setParsingError(const std::string&);
+
+  std::string rJsonBuffer;
+  bool rJsonBorrowed;
+  rapidjson::MemoryPoolAllocator<> rJsonAllocator;
+  std::deque<entities::genericValue_t> vendorValues;
+  // What the DOM walk collects from "changes" and from "relatedResources",
+  // kept apart as they may come in any order
+  entities::ValidationData changesData;
+  entities::ValidationData relatedData;
+  // Error stopping the DOM walk of "changes", reported by getValidationData
+  std::string changesError;
+  bool rJsonParseError;
+  std::string rJsonParseErrorStr;
+};
+
+bool ValidatorRapidJsonSaxParser::error() const { return rJsonParseError; }
+
+const std::string ValidatorRapidJsonSaxParser::errorString() const {
+  return rJsonParseErrorStr;
+}
+
+void ValidatorRapidJsonSaxParser::setParsingError(const std::string& err) {
+  rJsonParseError = true;
+  rJsonParseErrorStr = err;
+}
+
+}  // namespace json
+}  // namespace secondary
+}  // namespace port
+
+#endif  //__UDM_PROVISIONING_VALIDATOR_RAPIDJSON_SAX_PARSER_HPP__
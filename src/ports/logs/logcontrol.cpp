@@ -0,0 +1,104 @@
+#include "logcontrol.hpp"
+
+#include <rapidjson/document.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+namespace anonlog {
+
+namespace {
+
+constexpr auto CONTAINER_KEY = "container";
+constexpr auto SEVERITY_KEY = "severity";
+constexpr std::string_view DEBUG_SEVERITY = "debug";
+
+std::string_view stringMember(const rapidjson::Value &entry, const char *key) {
+  auto member = entry.FindMember(key);
+  if (member == entry.MemberEnd() or not member->value.IsString()) {
+    return {};
+  }
+  return {member->value.GetString(), member->value.GetStringLength()};
+}
+
+// The file is read again by a thread of its own, so that checking the level
+// on the request path is a single load
+struct WatchedFile {
+  ~WatchedFile() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wakeUp.notify_one();
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+
+  // The caller holds the mutex
+  void readDebug() {
+    std::ifstream file(path);
+    std::string text{std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>()};
+    debug.store(file and isDebugSeverity(text, container),
+                std::memory_order_relaxed);
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (not wakeUp.wait_for(lock, LOG_CONTROL_REFRESH,
+                               [this]() { return stopping; })) {
+      readDebug();
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable wakeUp;
+  bool stopping{false};
+  std::string path;
+  std::string container;
+  std::atomic<bool> debug{false};
+  std::thread thread;
+};
+
+WatchedFile &watchedFile() {
+  static WatchedFile watched;
+  return watched;
+}
+
+}  // namespace
+
+bool isDebugSeverity(std::string_view logControl, std::string_view container) {
+  rapidjson::Document document;
+  document.Parse(logControl.data(), logControl.size());
+  if (document.HasParseError() or not document.IsArray()) {
+    return false;
+  }
+  for (const auto &entry : document.GetArray()) {
+    if (entry.IsObject() and stringMember(entry, CONTAINER_KEY) == container) {
+      return stringMember(entry, SEVERITY_KEY) == DEBUG_SEVERITY;
+    }
+  }
+  return false;
+}
+
+void watchLogControl(const std::string &path, const std::string &container) {
+  auto &watched = watchedFile();
+  std::lock_guard<std::mutex> lock(watched.mutex);
+  watched.path = path;
+  watched.container = container;
+  watched.readDebug();
+  if (not watched.thread.joinable()) {
+    watched.thread = std::thread([&watched]() { watched.run(); });
+  }
+}
+
+bool isDebugEnabled() {
+  return watchedFile().debug.load(std::memory_order_relaxed);
+}
+
+}  // namespace anonlog
@@ -0,0 +1,31 @@
+#ifndef __LOGCONTROL__
+#define __LOGCONTROL__
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace anonlog {
+
+// Time after which the logControl.json file is read again
+constexpr std::chrono::seconds LOG_CONTROL_REFRESH{1};
+
+// Whether the logControl.json text gives the debug severity to container:
+//   [ { "container": "<container>", "severity": "debug" } ]
+// Not when the text is not such a JSON array
+bool isDebugSeverity(std::string_view logControl, std::string_view container);
+
+// The debug level is taken from the logControl.json file cpplog reads its
+// level from, so that what a debug record costs to build, such as an
+// anonymized body, is only paid when it is emitted, whatever the logging
+// library does with the arguments of the records it drops. The file is read
+// now, then again every LOG_CONTROL_REFRESH by a background thread, so the
+// requests never read it. Debug is off until a file is watched, or when it
+// cannot be read
+void watchLogControl(const std::string &path, const std::string &container);
+// The level read last, without any I/O
+bool isDebugEnabled();
+
+}  // namespace anonlog
+
+#endif  // __LOGCONTROL__
@@ -1,34 +1,143 @@
 #include "logwrapper.hpp"
 
-#include <boost/algorithm/string.hpp>
-#include <boost/regex.hpp>
-#include <filesystem>
+namespace anonlog {
 
-#include "formatter.hpp"
+namespace {
 
-namespace anonlog {
+constexpr std::string_view IMSI_LOWER = "imsi";
+constexpr std::string_view IMSI_UPPER = "IMSI";
+constexpr std::size_t MIN_DIGITS = 5;
+constexpr std::size_t MAX_DIGITS = 15;
+
+bool isImsiAt(std::string_view str, std::size_t pos) {
+  auto token = str.substr(pos, IMSI_LOWER.size());
+  return token == IMSI_LOWER or token == IMSI_UPPER;
+}
+
+std::size_t skipSpaces(std::string_view str, std::size_t pos) {
+  while (pos < str.size() and str[pos] == ' ') {
+    ++pos;
+  }
+  return pos;
+}
+
+// Digits from pos, up to limit of them
+std::size_t digitsAt(std::string_view str, std::size_t pos,
+                     std::size_t limit) {
+  std::size_t n = 0;
+  while (n < limit and pos + n < str.size() and str[pos + n] >= '0' and
+         str[pos + n] <= '9') {
+    ++n;
+  }
+  return n;
+}
 
-static boost::regex userRegExp{"((imsi|IMSI)-[0-9]{5,15})"};
+void appendMasked(std::string &out, std::string_view part) {
+  for (std::size_t i = 0; i < part.size(); ++i) {
+    out.push_back(i % 2 == 0 ? '*' : part[i]);
+  }
+}
+
+// Each match function appends the masked match at pos and returns its end,
+// or returns pos when there is no match there. Matches of different styles
+// never overlap, so one pass gives what a pass per style gave.
+
+// imsi-[0-9]{5,15}
+std::size_t maskDash(std::string_view str, std::size_t pos, std::string &out) {
+  auto digits = pos + IMSI_LOWER.size() + 1;
+  if (not isImsiAt(str, pos) or digits > str.size() or
+      str[digits - 1] != '-') {
+    return pos;
+  }
+  auto n = digitsAt(str, digits, MAX_DIGITS);
+  if (n < MIN_DIGITS) {
+    return pos;
+  }
+  out.append(str.substr(pos, digits - pos));
+  appendMasked(out, str.substr(digits, n));
+  return digits + n;
+}
 
-static boost::regex userUrlRegExp{"((imsi|IMSI) *= *[0-9]{5,15})"};
+// imsi *= *[0-9]{5,15}: the spaces after '=' are masked too
+std::size_t maskUrl(std::string_view str, std::size_t pos, std::string &out) {
+  if (not isImsiAt(str, pos)) {
+    return pos;
+  }
+  auto equal = skipSpaces(str, pos + IMSI_LOWER.size());
+  if (equal == str.size() or str[equal] != '=') {
+    return pos;
+  }
+  auto digits = skipSpaces(str, equal + 1);
+  auto n = digitsAt(str, digits, MAX_DIGITS);
+  if (n < MIN_DIGITS) {
+    return pos;
+  }
+  out.append(str.substr(pos, equal + 1 - pos));
+  appendMasked(out, str.substr(equal + 1, digits + n - equal - 1));
+  return digits + n;
+}
 
-static boost::regex userJsonRegExp{"(\"(imsi|IMSI)\" *: *\"[0-9]{5,15}\")"};
+// "imsi" *: *"[0-9]{5,15}": the spaces are dropped
+std::size_t maskJson(std::string_view str, std::size_t pos, std::string &out) {
+  auto token = pos + 1;
+  auto tokenEnd = token + IMSI_LOWER.size();
+  if (str[pos] != '"' or not isImsiAt(str, token) or
+      tokenEnd >= str.size() or str[tokenEnd] != '"') {
+    return pos;
+  }
+  auto colon = skipSpaces(str, tokenEnd + 1);
+  if (colon == str.size() or str[colon] != ':') {
+    return pos;
+  }
+  auto quote = skipSpaces(str, colon + 1);
+  if (quote == str.size() or str[quote] != '"') {
+    return pos;
+  }
+  // The digits must be closed by a quote: a longer run does not match
+  auto n = digitsAt(str, quote + 1, MAX_DIGITS + 1);
+  auto end = quote + 1 + n;
+  if (n < MIN_DIGITS or n > MAX_DIGITS or end == str.size() or
+      str[end] != '"') {
+    return pos;
+  }
+  out.push_back('"');
+  out.append(str.substr(token, IMSI_LOWER.size()));
+  out.append("\":\"");
+  appendMasked(out, str.substr(quote + 1, n));
+  out.push_back('"');
+  return end + 1;
+}
 
-std::string anonymizeString(const std::string &str) {
-  static Formatter fmt;
-  return ::boost::regex_replace(str, userRegExp, fmt,
-                                ::boost::match_default | ::boost::format_all);
+template <bool ALL_STYLES>
+std::string anonymize(std::string_view str) {
+  std::string out;
+  out.reserve(str.size());
+  std::size_t pos = 0;
+  while (pos < str.size()) {
+    auto end = pos;
+    if (str[pos] == 'i' or str[pos] == 'I') {
+      end = maskDash(str, pos, out);
+      if (ALL_STYLES and end == pos) {
+        end = maskUrl(str, pos, out);
+      }
+    } else if (ALL_STYLES and str[pos] == '"') {
+      end = maskJson(str, pos, out);
+    }
+    if (end == pos) {
+      out.push_back(str[pos]);
+      ++end;
+    }
+    pos = end;
+  }
+  return out;
 }
 
-std::string anonymizeJson(const std::string &str) {
-  static JsonFormatter json_fmt;
-  static UrlFormatter url_fmt;
-  std::string def_filter = anonymizeString(str);
-  std::string url_filter =
-      ::boost::regex_replace(def_filter, userUrlRegExp, url_fmt,
-                             ::boost::match_default | ::boost::format_all);
-  return ::boost::regex_replace(url_filter, userJsonRegExp, json_fmt,
-                                ::boost::match_default | ::boost::format_all);
+}  // namespace
+
+std::string anonymizeString(std::string_view str) {
+  return anonymize<false>(str);
 }
 
-}  // namespace anonlog
\ No newline at end of file
+std::string anonymizeJson(std::string_view str) { return anonymize<true>(str); }
+
+}  // namespace anonlog
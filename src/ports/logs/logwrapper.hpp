@@ -2,13 +2,20 @@
 #define __LOGWRAPPER__
 
 #include <string>
+#include <string_view>
 
 namespace anonlog {
 
-std::string anonymizeString(const std::string &str);
+// IMSIs are masked in a single pass over the text, replacing every other
+// character of the masked part by '*':
+//   imsi-123456789012345       -> imsi-*2*4*6*8*0*2*4*
+//   IMSI = 123456789012345     -> IMSI =*1*3*5*7*9*1*3*5 (all after the '=')
+//   "imsi" : "123456789012345" -> "imsi":"*2*4*6*8*0*2*4*"
+// anonymizeString() only masks the first style, anonymizeJson() all of them.
+std::string anonymizeString(std::string_view str);
 
-std::string anonymizeJson(const std::string &str);
+std::string anonymizeJson(std::string_view str);
 
 }  // namespace anonlog
 
-#endif  // __LOGWRAPPER__
\ No newline at end of file
+#endif  // __LOGWRAPPER__
@@ -0,0 +1,202 @@
+#include "PrometheusMetrics.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace port {
+namespace primary {
+
+namespace {
+
+constexpr std::uint64_t NANOS_PER_SECOND = 1000000000;
+
+// Exact, with no floating point on the way
+void appendSeconds(std::uint64_t nanos, std::string &out) {
+  auto fraction = std::to_string(nanos % NANOS_PER_SECOND);
+  out.append(std::to_string(nanos / NANOS_PER_SECOND))
+      .append(".")
+      .append(9 - fraction.size(), '0')
+      .append(fraction);
+}
+
+void appendHeader(std::string_view name, std::string_view type,
+                  std::string_view help, std::string &out) {
+  out.append("# HELP ").append(METRICS_PREFIX).append(name);
+  out.append(" ").append(help).append("\n");
+  out.append("# TYPE ").append(METRICS_PREFIX).append(name);
+  out.append(" ").append(type).append("\n");
+}
+
+// name{label="value"} or name when there is no label
+void appendSample(std::string_view name, std::string_view label,
+                  std::string_view value, std::uint64_t sample,
+                  std::string &out) {
+  out.append(METRICS_PREFIX).append(name);
+  if (not label.empty()) {
+    out.append("{").append(label).append("=\"");
+    appendLabelValue(value, out);
+    out.append("\"}");
+  }
+  out.append(" ").append(std::to_string(sample)).append("\n");
+}
+
+void appendStages(const entities::MetricsSnapshot &snapshot,
+                  std::string &out) {
+  constexpr std::string_view name = "stage_duration_seconds";
+  appendHeader(name, "histogram",
+               "Time spent on each stage of the validation of a document",
+               out);
+  for (std::size_t i = 0; i < entities::STAGE_NAMES.size(); ++i) {
+    const auto &stage = snapshot.stages[i];
+    std::string labels{"{stage=\""};
+    labels.append(entities::STAGE_NAMES[i]).append("\"");
+
+    std::uint64_t count = 0;
+    std::size_t bucket = 0;
+    for (auto exponent = MIN_LATENCY_EXPONENT;
+         exponent <= MAX_LATENCY_EXPONENT; ++exponent) {
+      std::uint64_t bound = std::uint64_t{1} << exponent;
+      while (bucket < stage.buckets.size() and
+             entities::LatencyHistogram::lowerBound(bucket + 1) <= bound) {
+        count += stage.buckets[bucket++];
+      }
+      out.append(METRICS_PREFIX).append(name).append("_bucket");
+      out.append(labels).append(",le=\"");
+      appendSeconds(bound, out);
+      out.append("\"} ").append(std::to_string(count)).append("\n");
+    }
+    out.append(METRICS_PREFIX).append(name).append("_bucket");
+    out.append(labels).append(",le=\"+Inf\"} ");
+    out.append(std::to_string(stage.count)).append("\n");
+
+    out.append(METRICS_PREFIX).append(name).append("_sum");
+    out.append(labels).append("} ");
+    appendSeconds(stage.sumNanos, out);
+    out.append("\n");
+    out.append(METRICS_PREFIX).append(name).append("_count");
+    out.append(labels).append("} ");
+    out.append(std::to_string(stage.count)).append("\n");
+  }
+}
+
+void appendOutcomes(const entities::MetricsSnapshot &snapshot,
+                    std::string &out) {
+  constexpr std::string_view name = "responses_total";
+  appendHeader(name, "counter", "Documents answered, by status code", out);
+  for (std::size_t i = 0; i < entities::OUTCOMES; ++i) {
+    appendSample(name, "code",
+                 i < entities::OUTCOME_CODES.size()
+                     ? std::to_string(entities::OUTCOME_CODES[i])
+                     : "other",
+                 snapshot.outcomes[i], out);
+  }
+}
+
+void appendViolations(const entities::MetricsSnapshot &snapshot,
+                      std::string &out) {
+  constexpr std::string_view name = "rule_violations_total";
+  appendHeader(name, "counter", "Validation errors found, by type", out);
+  for (const auto &[type, count] : snapshot.violations) {
+    out.append(METRICS_PREFIX).append(name).append("{error=\"");
+    appendLabelValue(type.first, out);
+    out.append("\",description=\"");
+    appendLabelValue(type.second, out);
+    out.append("\"} ").append(std::to_string(count)).append("\n");
+  }
+}
+
+}  // namespace
+
+void appendLabelValue(std::string_view value, std::string &out) {
+  for (auto c : value) {
+    switch (c) {
+      case '\\':
+        out.append("\\\\");
+        break;
+      case '"':
+        out.append("\\\"");
+        break;
+      case '\n':
+        out.append("\\n");
+        break;
+      default:
+        out.push_back(c);
+        break;
+    }
+  }
+}
+
+void metricsToPrometheus(const entities::MetricsSnapshot &snapshot,
+                         const ResponseValidationPolicy &policy,
+                         std::string &out) {
+  appendStages(snapshot, out);
+  appendOutcomes(snapshot, out);
+  appendViolations(snapshot, out);
+
+  appendHeader("response_validations_total", "counter",
+               "Responses checked against the schema, or not", out);
+  appendSample("response_validations_total", "result", "validated",
+               policy.validated(), out);
+  appendSample("response_validations_total", "result", "skipped",
+               policy.skipped(), out);
+  appendHeader("response_validation_failures_total", "counter",
+               "Responses that did not match the schema", out);
+  appendSample("response_validation_failures_total", {}, {},
+               policy.failures(), out);
+  appendHeader("sampled_response_validation_failures_total", "counter",
+               "Sampled responses that did not match the schema", out);
+  appendSample("sampled_response_validation_failures_total", {}, {},
+               policy.sampledFailures(), out);
+}
+
+void admissionToPrometheus(const AdmissionStates &states,
+                           std::string &out) {
+  auto labeled = [&out](std::string_view name, std::size_t priority) {
+    out.append(METRICS_PREFIX).append(name).append("{priority=\"");
+    out.append(entities::PRIORITY_NAMES[priority]).append("\"");
+  };
+  auto appendDuration = [&out, &labeled](std::string_view name,
+                                         std::size_t priority,
+                                         std::chrono::nanoseconds duration) {
+    labeled(name, priority);
+    out.append("} ");
+    appendSeconds(static_cast<std::uint64_t>(duration.count()), out);
+    out.append("\n");
+  };
+
+  appendHeader("admission_shedding", "gauge",
+               "Whether queued requests are being shed", out);
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    labeled("admission_shedding", i);
+    out.append("} ").append(states[i].dropping ? "1" : "0").append("\n");
+  }
+  appendHeader("admission_requests_total", "counter",
+               "Requests admitted to the workers, rejected before being "
+               "queued, or shed once queued",
+               out);
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    for (auto [result, count] :
+         {std::pair{"admitted", states[i].admitted},
+          std::pair{"rejected", states[i].rejected},
+          std::pair{"shed", states[i].shed}}) {
+      labeled("admission_requests_total", i);
+      out.append(",result=\"").append(result).append("\"} ");
+      out.append(std::to_string(count)).append("\n");
+    }
+  }
+
+  appendHeader("admission_queue_delay_seconds", "gauge",
+               "Time the last request left the queue after", out);
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    appendDuration("admission_queue_delay_seconds", i, states[i].queueDelay);
+  }
+  appendHeader("admission_service_time_seconds", "gauge",
+               "Moving average of the time a request runs on a worker", out);
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    appendDuration("admission_service_time_seconds", i, states[i].serviceTime);
+  }
+}
+
+}  // namespace primary
+}  // namespace port
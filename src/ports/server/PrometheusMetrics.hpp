@@ -0,0 +1,41 @@
+#ifndef __AUTHENTICATION_PROVISIONING_VALIDATOR_PROMETHEUS_METRICS__
+#define __AUTHENTICATION_PROVISIONING_VALIDATOR_PROMETHEUS_METRICS__
+
+#include <string>
+#include <string_view>
+
+#include "ResponseValidationPolicy.hpp"
+#include "entities/AdmissionController.hpp"
+#include "entities/Metrics.hpp"
+#include "entities/WorkerPool.hpp"
+
+namespace port {
+namespace primary {
+
+constexpr auto METRICS_PREFIX = "authprovvalidator_";
+
+// Stage latencies are exposed with a bucket for each power of two of
+// nanoseconds from 2^MIN_LATENCY_EXPONENT (about 1us) to
+// 2^MAX_LATENCY_EXPONENT (about 17s)
+constexpr unsigned MIN_LATENCY_EXPONENT = 10;
+constexpr unsigned MAX_LATENCY_EXPONENT = 34;
+
+// Label value with backslashes, double quotes and line feeds escaped
+void appendLabelValue(std::string_view, std::string &out);
+
+// Appends the metrics to out, in the Prometheus text exposition format
+void metricsToPrometheus(const entities::MetricsSnapshot &,
+                         const ResponseValidationPolicy &,
+                         std::string &out);
+
+// Admission control of each priority, in entities::Priority order
+using AdmissionStates =
+    std::array<entities::AdmissionState, entities::PRIORITY_NAMES.size()>;
+
+// Appends the state of the admission control to out
+void admissionToPrometheus(const AdmissionStates &, std::string &out);
+
+}  // namespace primary
+}  // namespace port
+
+#endif  // __AUTHENTICATION_PROVISIONING_VALIDATOR_PROMETHEUS_METRICS__
@@ -0,0 +1,102 @@
+#ifndef __AUTHENTICATION_PROVISIONING_VALIDATOR_RESPONSE_VALIDATION_POLICY__
+#define __AUTHENTICATION_PROVISIONING_VALIDATOR_RESPONSE_VALIDATION_POLICY__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace port {
+namespace primary {
+
+constexpr auto RESPONSE_VALIDATION_ALWAYS = "always";
+constexpr auto RESPONSE_VALIDATION_SAMPLED = "sampled";
+constexpr auto RESPONSE_VALIDATION_OFF = "off";
+
+// Decides which of the responses built by the encoder go through the OpenAPI
+// response validation:
+//   - always: every response. An invalid one is replaced by a 500.
+//   - sampled: one every sampleRate responses. An invalid one is still sent,
+//     it is only logged and counted, so regressions show up in production
+//     without paying the schema validation on every response.
+//   - off: none.
+class ResponseValidationPolicy final {
+ public:
+  enum class Mode { ALWAYS, SAMPLED, OFF };
+
+  ResponseValidationPolicy() = default;
+  ResponseValidationPolicy(Mode mode, std::size_t sampleRate)
+      : mode{mode}, sampleRate{sampleRate == 0 ? 1 : sampleRate} {}
+  ResponseValidationPolicy(std::string_view mode, std::size_t sampleRate)
+      : ResponseValidationPolicy(toMode(mode), sampleRate) {}
+  ResponseValidationPolicy(const ResponseValidationPolicy &) = delete;
+  ~ResponseValidationPolicy() = default;
+
+  // Unknown modes fall back to always
+  static inline Mode toMode(std::string_view mode) {
+    if (mode == RESPONSE_VALIDATION_SAMPLED) {
+      return Mode::SAMPLED;
+    }
+    if (mode == RESPONSE_VALIDATION_OFF) {
+      return Mode::OFF;
+    }
+    return Mode::ALWAYS;
+  }
+
+  inline bool shouldValidate() {
+    switch (mode) {
+      case Mode::ALWAYS:
+        break;
+      case Mode::OFF:
+        skippedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      case Mode::SAMPLED:
+        if (sequence.fetch_add(1, std::memory_order_relaxed) % sampleRate) {
+          skippedCount.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+        break;
+    }
+    validatedCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Whether an invalid response has to be replaced by an error
+  inline bool isEnforced() const { return mode == Mode::ALWAYS; }
+
+  inline void recordFailure() {
+    failureCount.fetch_add(1, std::memory_order_relaxed);
+    if (mode == Mode::SAMPLED) {
+      sampledFailureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  inline Mode getMode() const { return mode; }
+  inline std::size_t getSampleRate() const { return sampleRate; }
+  inline std::uint64_t validated() const {
+    return validatedCount.load(std::memory_order_relaxed);
+  }
+  inline std::uint64_t skipped() const {
+    return skippedCount.load(std::memory_order_relaxed);
+  }
+  inline std::uint64_t failures() const {
+    return failureCount.load(std::memory_order_relaxed);
+  }
+  inline std::uint64_t sampledFailures() const {
+    return sampledFailureCount.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const Mode mode{Mode::ALWAYS};
+  const std::size_t sampleRate{1};
+  std::atomic<std::uint64_t> sequence{0};
+  std::atomic<std::uint64_t> validatedCount{0};
+  std::atomic<std::uint64_t> skippedCount{0};
+  std::atomic<std::uint64_t> failureCount{0};
+  std::atomic<std::uint64_t> sampledFailureCount{0};
+};
+
+}  // namespace primary
+}  // namespace port
+
+#endif  // __AUTHENTICATION_PROVISIONING_VALIDATOR_RESPONSE_VALIDATION_POLICY__
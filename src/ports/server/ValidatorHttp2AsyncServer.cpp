@@ -1,11 +1,24 @@
 #include "ValidatorHttp2AsyncServer.hpp"
 
+#include "PrometheusMetrics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <vector>
+
 #include "domain/validation.hpp"
+#include "entities/ErrorText.hpp"
+#include "entities/StageTimer.hpp"
 #include "log/logout.hpp"
 #include "openapi3/HTTPinfo.hpp"
 #include "ports/HTTPcodes.hpp"
+#include "ports/json/JsonBatch.hpp"
 #include "ports/json/ValidatorRapidJsonEncoder.hpp"
 #include "ports/json/ValidatorRapidJsonParser.hpp"
+#include "ports/json/ValidatorRapidJsonSaxParser.hpp"
+#include "ports/logs/logcontrol.hpp"
 #include "ports/logs/logwrapper.hpp"
 #include "ports/oaivalidator/OaiValidatorInterface.hpp"
 #include "ports/ports.hpp"
@@ -14,167 +27,475 @@ namespace port {
 namespace primary {
 
 constexpr auto READINESS_PROBE_URI = "/healthz";
+constexpr auto METRICS_URI = "/metrics";
+constexpr auto BATCH_URI = "/validate/batch";
+// Batch items are validated as if posted to the batch path without it
+constexpr std::string_view BATCH_SUFFIX = "/batch";
 
 void handleHttp2RequestHealthy(std::shared_ptr<http2::Stream> stream) {
   stream->end(::port::HTTP_OK, {}, "");
 };
 
-static entities::Error composeError(
-    const std::string &message,
-    const std::initializer_list<std::pair<std::string, std::string>> args) {
-  entities::Error err;
-  err.errorMessage = message;
-  for (auto &i : args) {
-    err.errorDetails.insert(i);
+// Answered on the I/O thread, as the probe is: a scrape only merges the
+// counters of the workers, it does not wait for them
+void handleHttp2RequestMetrics(std::shared_ptr<http2::Stream> stream,
+                               const entities::Metrics &metrics,
+                               const ResponseValidationPolicy &policy,
+                               const ValidatorHttp2AsyncServer &server) {
+  std::string body;
+  metricsToPrometheus(metrics.snapshot(), policy, body);
+  if (server.getAdmission()) {
+    AdmissionStates states;
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      states[i] =
+          server.getAdmission(static_cast<entities::Priority>(i))->state();
+    }
+    admissionToPrometheus(states, body);
   }
-  return err;
+  http2::headers_t headers;
+  headers.emplace("content-type", CONTENT_TYPE_PROMETHEUS);
+  stream->end(::port::HTTP_OK, headers, std::move(body));
 }
 
-const http2::headers_t toHttp2Headers(const http2::headers_t &headers) {
-  http2::headers_t http2Headers;
-  for (const auto &[key, value] : headers) {
-    auto headName = key;
-    std::transform(headName.begin(), headName.end(), headName.begin(),
-                   ::tolower);
-    http2Headers.emplace(key, value);
-  }
-  return http2Headers;
+// Streams belong to the I/O thread of their connection, and an HTTP/2 session
+// is not safe to write to from another thread: the end of the stream is
+// posted back to that thread, whichever thread answers
+void endStream(const std::shared_ptr<http2::Stream> &stream,
+               std::uint32_t status, http2::headers_t &&headers,
+               std::string &&body) {
+  stream->post([stream, status, headers = std::move(headers),
+                body = std::move(body)]() mutable {
+    stream->end(status, headers, std::move(body));
+  });
 }
 
-void setHTTPInfoRequest(const std::shared_ptr<http2::Stream> &stream,
-                        ::httpinfo::Info &httpInfo) {
-  httpInfo.headers = toHttp2Headers(stream->requestHeaders());
-  httpInfo.json = stream->requestBody();
-  httpInfo.uri = stream->requestUri().path();
-  httpInfo.query = stream->requestUri().query();
-  httpInfo.method = stream->method();
+// Runs on the I/O thread. The request headers are read once: each one is
+// copied to httpInfo, and the tracing ones to the context as well. HTTP/2
+// header names are lowercase already, so they are copied as they are
+void setHTTPInfoRequest(const http2::Stream &stream, ::httpinfo::Info &httpInfo,
+                        entities::Context &context) {
+  context.copyTracingHeaders(
+      stream.requestHeaders(),
+      [&headers = httpInfo.headers](const auto &key, const auto &value) {
+        headers.emplace(key, value);
+      });
+  httpInfo.json = stream.requestBody();
+  httpInfo.uri = stream.requestUri().path();
+  httpInfo.query = stream.requestUri().query();
+  httpInfo.method = stream.method();
 }
 
+// The body and the headers are moved in, to be taken back once the response
+// is validated
 void setHTTPInfoResponse(std::uint32_t statusCode, const std::string &uri,
                          const std::string &method, const std::string &query,
-                         const std::string &bodyResponse,
-                         const http2::headers_t &headers,
+                         std::string &&bodyResponse,
+                         http2::headers_t &&headers,
                          httpinfo::Info &httpInfo) {
-  httpInfo.headers = toHttp2Headers(headers);
-  httpInfo.json = bodyResponse;
+  httpInfo.headers = std::move(headers);
+  httpInfo.json = std::move(bodyResponse);
   httpInfo.uri = uri;
   httpInfo.method = method;
   httpInfo.query = query;
   httpInfo.statusCode = statusCode;
 }
 
-bool checkInvalidRequest(const entities::Context &ctxResponse,
-                         const httpinfo::Info &httpInfo,
-                         const std::shared_ptr<http2::Stream> &stream) {
+// Status and body a validation document is answered with
+struct ValidationOutcome {
+  std::uint32_t status;
+  std::string body;
+  // Only answers to requests that match the schema are checked against it
+  bool validateResponse;
+};
+
+// The rules of a document are applied over the workers from
+// minParallelChanges changes on. What the validation takes and finds is
+// counted in the metrics, and the stages of traced requests are recorded in
+// spans, when there is a ring for them
+struct RuleExecution {
+  entities::WorkerPool &workers;
+  std::size_t minParallelChanges;
+  entities::Metrics &metrics;
+  entities::SpanRing *spans;
+};
+
+// The 400 answer is returned when the request is not valid
+std::optional<ValidationOutcome> checkInvalidRequest(
+    const httpinfo::Info &httpInfo, entities::Metrics &metrics,
+    const entities::Context &context, entities::RequestArena &arena) {
+  entities::StageTimer timer{metrics, entities::Stage::OAI_REQUEST, &context};
   ::port::secondary::validation_t resultError =
       ::domain::validation::validateRequest(httpInfo);
-  port::secondary::json::ValidatorRapidJsonEncoder encoder;
+  timer.stop();
 
-  if (resultError) {
-    entities::Error error = composeError(
-        "Malformed request", {{"description", resultError->reason}});
-    sendResponse(ctxResponse, stream, ::port::HTTP_BAD_REQUEST,
-                 encoder.errorResponseToJson(error).str(), false);
-    return true;
+  if (not resultError) {
+    return std::nullopt;
   }
-  return false;
+  port::secondary::json::ValidatorRapidJsonEncoder encoder(arena);
+  entities::Error error =
+      entities::requestError("Malformed request", resultError->reason);
+  ValidationOutcome outcome{::port::HTTP_BAD_REQUEST, {}, false};
+  encoder.errorResponseToJson(error, outcome.body);
+  return outcome;
 }
 
-bool checkInvalidResponse(const entities::Context &ctxResponse,
+bool checkInvalidResponse(const StreamRequest &request,
                           const httpinfo::Info &httpInfo,
-                          const std::shared_ptr<http2::Stream> &stream) {
+                          const std::shared_ptr<http2::Stream> &stream,
+                          ResponseValidationPolicy &policy,
+                          entities::Metrics *metrics) {
+  auto start = entities::StageTimer::clock_t::now();
   ::port::secondary::validation_t resultError =
       ::domain::validation::validateResponse(httpInfo);
-  port::secondary::json::ValidatorRapidJsonEncoder encoder;
+  auto elapsed = entities::StageTimer::clock_t::now() - start;
+  if (metrics) {
+    metrics->recordStage(entities::Stage::OAI_RESPONSE, elapsed);
+  }
+  request.context.recordSpan(entities::Stage::OAI_RESPONSE, elapsed);
 
   if (resultError) {
-    entities::Error error = composeError(
-        "Malformed response", {{"description", resultError->reason}});
-    sendResponse(ctxResponse, stream, ::port::HTTP_INTERNAL_SERVER_ERROR,
-                 encoder.errorResponseToJson(error).str(), false);
+    policy.recordFailure();
+    if (not policy.isEnforced()) {
+      LOG_ERR("Sampled response validation failed", "status_code",
+              std::to_string(httpInfo.statusCode), "description",
+              resultError->reason);
+      return false;
+    }
+    port::secondary::json::ValidatorRapidJsonEncoder encoder;
+    entities::Error error =
+        entities::requestError("Malformed response", resultError->reason);
+    sendResponse(request, stream, ::port::HTTP_INTERNAL_SERVER_ERROR,
+                 encoder.errorResponseToJson(error).str(), nullptr, metrics);
     return true;
   }
   return false;
 }
 
-void sendResponse(const entities::Context &ctxResponse,
+// Runs on a worker. Nothing of the stream is read here, the request is
+// described by its copy, and the stream is ended on its I/O thread
+void sendResponse(const StreamRequest &request,
                   std::shared_ptr<http2::Stream> stream,
-                  const std::uint32_t &status, const std::string &json,
-                  const bool validateResponse) {
-  http2::headers_t headers = ctxResponse.getTracingHeaders();
-
-  headers.emplace("content-type", "application/json");
+                  const std::uint32_t &status, std::string &&json,
+                  ResponseValidationPolicy *policy,
+                  entities::Metrics *metrics, std::string_view contentType) {
+  http2::headers_t headers = request.context.getTracingHeaders();
 
-  httpinfo::Info httpInfoRes;
-  setHTTPInfoResponse(status, stream->requestUri().path(), stream->method(),
-                      stream->requestUri().query(), json, headers, httpInfoRes);
+  headers.emplace("content-type", contentType);
 
-  if (validateResponse) {
-    if (checkInvalidResponse(ctxResponse, httpInfoRes, stream)) {
+  if (policy and policy->shouldValidate()) {
+    httpinfo::Info httpInfoRes;
+    setHTTPInfoResponse(status, request.info.uri, request.info.method,
+                        request.info.query, std::move(json), std::move(headers),
+                        httpInfoRes);
+    if (checkInvalidResponse(request, httpInfoRes, stream, *policy, metrics)) {
       LOG_ERR("Invalid Response. Could not be validated");
       return;
     }
+    json = std::move(httpInfoRes.json);
+    headers = std::move(httpInfoRes.headers);
+  }
+  if (::anonlog::isDebugEnabled()) {
+    LOG_DEBUG("filling sucessfull response", "status_code",
+              std::to_string(status), "data", ::anonlog::anonymizeJson(json));
+  }
+  if (metrics) {
+    metrics->recordOutcome(status);
   }
-  LOG_DEBUG("filling sucessfull response", "status_code",
-            std::to_string(status), "data", ::anonlog::anonymizeJson(json));
-  stream->end(status, headers, json);
+  endStream(stream, status, std::move(headers), std::move(json));
 }
 
-void handleHttp2Request(std::shared_ptr<http2::Stream> stream) {
-  httpinfo::Info httpInfo;
-  setHTTPInfoRequest(stream, httpInfo);
-
-  entities::Context contextRequest;
-  contextRequest.copyTracingHeaders(stream->requestHeaders());
+// Both parsers have the same interface. reqData may borrow from the parser,
+// so it is declared here, after it. parsed is the time the parser already
+// spent on the body
+template <typename Parser>
+ValidationOutcome validateParsedRequest(Parser &parser,
+                                        const RuleExecution &rules,
+                                        const entities::Context &context,
+                                        entities::RequestArena &arena,
+                                        std::chrono::nanoseconds parsed = {}) {
+  ::entities::ValidationData reqData;
+  port::secondary::json::ValidatorRapidJsonEncoder encoder(arena);
 
-  LOG_DEBUG("Handling validation request", "uri", httpInfo.uri, "method",
-            httpInfo.method, "data", ::anonlog::anonymizeJson(httpInfo.json));
+  // The response is written straight into its body, which is then handed
+  // over to the stream
+  ValidationOutcome outcome{::port::HTTP_OK, {}, true};
 
-  if (checkInvalidRequest(contextRequest, httpInfo, stream)) {
-    LOG_ERR("Invalid Request. Could not be validated");
-    return;
-  }
+  entities::StageTimer parse{rules.metrics, entities::Stage::PARSE, &context,
+                             parsed};
+  auto isParsed = parser.getValidationData(reqData);
+  parse.stop();
 
-  ::port::secondary::json::ValidatorRapidJsonParser parser(httpInfo.json);
-  ::entities::ValidationData reqData;
-  port::secondary::json::ValidatorRapidJsonEncoder encoder;
-
-  if (not parser.getValidationData(reqData)) {
+  if (not isParsed) {
     LOG_ERR("Could not parse json data");
 
-    entities::Error error = composeError(
-        "Malformed request", {{"description", parser.errorString()}});
-    sendResponse(contextRequest, stream, ::port::HTTP_BAD_REQUEST,
-                 encoder.errorResponseToJson(error).str(), true);
-    return;
+    entities::Error error =
+        entities::requestError("Malformed request", parser.errorString());
+    outcome.status = ::port::HTTP_BAD_REQUEST;
+    encoder.errorResponseToJson(error, outcome.body);
+    return outcome;
   }
 
   if (reqData.response.errors.size()) {
     LOG_ERR("Validation errors found on parsing data");
-    sendResponse(contextRequest, stream, ::port::HTTP_CONFLICT,
-                 encoder.validatorResponseToJson(reqData).str(), true);
-    return;
+    rules.metrics.recordViolations(reqData.response.errors);
+    outcome.status = ::port::HTTP_CONFLICT;
+    entities::StageTimer encode{rules.metrics, entities::Stage::ENCODE,
+                                &context};
+    encoder.validatorResponseToJson(reqData, outcome.body);
+    return outcome;
   }
 
-  auto resp = reqData.applyValidationRules();
+  entities::StageTimer applyRules{rules.metrics, entities::Stage::RULES,
+                                  &context};
+  auto resp = reqData.applyValidationRules(rules.workers,
+                                           rules.minParallelChanges);
+  applyRules.stop();
   auto isValidated = std::get<entities::VALIDATION>(resp);
   auto code = std::get<entities::CODE>(resp);
 
   if (not isValidated) {
     LOG_ERR("Validation not successful");
-    sendResponse(contextRequest, stream, code,
-                 encoder.validatorResponseToJson(reqData).str(), true);
+    outcome.status = code;
+  }
+  if (reqData.response.errors.size()) {
+    rules.metrics.recordViolations(reqData.response.errors);
+  }
+
+  entities::StageTimer encode{rules.metrics, entities::Stage::ENCODE, &context};
+  encoder.validatorResponseToJson(reqData, outcome.body);
+  return outcome;
+}
+
+// One validation document, from its OpenAPI validation to its encoded answer.
+// The body may be moved out of httpInfo. Its stages are traced in the context
+// of the request it came with
+ValidationOutcome validateDocument(httpinfo::Info &httpInfo,
+                                   JsonParser jsonParser,
+                                   const RuleExecution &rules,
+                                   const entities::Context &context,
+                                   entities::RequestArena &arena) {
+  if (auto invalid =
+          checkInvalidRequest(httpInfo, rules.metrics, context, arena)) {
+    LOG_ERR("Invalid Request. Could not be validated");
+    return std::move(*invalid);
+  }
+
+  // The body is not needed anymore: both parsers read it in situ, and the
+  // validation data borrows from it
+  if (jsonParser == JsonParser::SAX) {
+    ::port::secondary::json::ValidatorRapidJsonSaxParser parser(
+        std::move(httpInfo.json), arena);
+    return validateParsedRequest(parser, rules, context, arena);
+  }
+  auto parseStart = entities::StageTimer::clock_t::now();
+  ::port::secondary::json::ValidatorRapidJsonParser parser(
+      std::move(httpInfo.json), arena);
+  auto parsed = entities::StageTimer::clock_t::now() - parseStart;
+  return validateParsedRequest(parser, rules, context, arena, parsed);
+}
+
+void handleHttp2Request(std::shared_ptr<http2::Stream> stream,
+                        StreamRequest &request,
+                        ResponseValidationPolicy &responsePolicy,
+                        JsonParser jsonParser, const RuleExecution &rules) {
+  // Everything allocated for this request is released at once on return,
+  // after the response has been handed over to the I/O thread
+  entities::RequestArena arena;
+  request.context.traceInto(rules.spans);
+
+  if (::anonlog::isDebugEnabled()) {
+    LOG_DEBUG("Handling validation request", "uri", request.info.uri,
+              "method", request.info.method, "data",
+              ::anonlog::anonymizeJson(request.info.json));
+  }
+
+  auto outcome = validateDocument(request.info, jsonParser, rules,
+                                  request.context, arena);
+  sendResponse(request, stream, outcome.status, std::move(outcome.body),
+               outcome.validateResponse ? &responsePolicy : nullptr,
+               &rules.metrics);
+}
+
+// The priority the request asks for, byDefault when it does not
+entities::Priority requestPriority(const httpinfo::Info &httpInfo,
+                                   entities::Priority byDefault) {
+  const auto &headers = httpInfo.headers;
+  auto header = headers.find(PRIORITY_HEADER);
+  if (header == headers.end()) {
+    return byDefault;
+  }
+  return toPriority(header->second, byDefault);
+}
+
+httpinfo::Info batchItemInfo(const httpinfo::Info &batch,
+                             std::string_view item) {
+  httpinfo::Info info;
+  for (const auto &header : batch.headers) {
+    if (header.first != "content-type" and header.first != "content-length") {
+      info.headers.insert(header);
+    }
+  }
+  info.headers.emplace("content-type", CONTENT_TYPE_JSON);
+  info.json = item;
+  auto uri = std::string_view{batch.uri};
+  uri.remove_suffix(std::min(uri.size(), BATCH_SUFFIX.size()));
+  info.uri = uri;
+  info.query = batch.query;
+  info.method = batch.method;
+  return info;
+}
+
+// The items are validated as independent documents, posted to the path the
+// batch path extends, spread over the workers and answered in their order.
+// The batch answer is not part of the schema, so it is not checked against it.
+// Each item is counted in the metrics, the batch answer is not. A batch of
+// more than maxBatchItems items is answered 413, with none validated
+void handleHttp2BatchRequest(std::shared_ptr<http2::Stream> stream,
+                             StreamRequest &request, JsonParser jsonParser,
+                             std::size_t maxBatchItems,
+                             const RuleExecution &rules) {
+  const auto &httpInfo = request.info;
+  request.context.traceInto(rules.spans);
+
+  if (::anonlog::isDebugEnabled()) {
+    LOG_DEBUG("Handling batch validation request", "uri", httpInfo.uri,
+              "method", httpInfo.method, "data",
+              ::anonlog::anonymizeJson(httpInfo.json));
+  }
+
+  port::secondary::json::BatchFormat format;
+  std::vector<std::string_view> items;
+  port::secondary::json::ValidatorRapidJsonEncoder encoder;
+  std::string body;
+
+  if (not port::secondary::json::splitBatch(httpInfo.json, format, items)) {
+    LOG_ERR("Invalid batch request. Could not be split");
+    entities::Error error = entities::requestError(
+        "Malformed request",
+        "Batch array is not closed, or is followed by data");
+    encoder.errorResponseToJson(error, body);
+    sendResponse(request, stream, ::port::HTTP_BAD_REQUEST, std::move(body),
+                 nullptr, &rules.metrics);
     return;
   }
 
-  sendResponse(contextRequest, stream, ::port::HTTP_OK,
-               encoder.validatorResponseToJson(reqData).str(), true);
-  return;
+  if (items.size() > maxBatchItems) {
+    LOG_ERR("Batch request too large. Request rejected", "items",
+            std::to_string(items.size()));
+    entities::Error error = entities::requestError(
+        "Payload too large", "Batch has " + std::to_string(items.size()) +
+                                 " items, more than the " +
+                                 std::to_string(maxBatchItems) + " accepted");
+    encoder.errorResponseToJson(error, body);
+    sendResponse(request, stream, ::port::HTTP_PAYLOAD_TOO_LARGE,
+                 std::move(body), nullptr, &rules.metrics);
+    return;
+  }
+
+  std::vector<port::secondary::json::batch_result_t> results(items.size());
+  rules.workers.parallelFor(items.size(), [&](std::size_t i) {
+    entities::RequestArena arena;
+    auto item = batchItemInfo(httpInfo, items[i]);
+    auto outcome =
+        validateDocument(item, jsonParser, rules, request.context, arena);
+    rules.metrics.recordOutcome(outcome.status);
+    results[i] = {outcome.status, std::move(outcome.body)};
+  });
+
+  auto ndjson = format == port::secondary::json::BatchFormat::NDJSON;
+  encoder.batchResponseToJson(results, ndjson, body);
+  sendResponse(request, stream, ::port::HTTP_OK, std::move(body), nullptr,
+               nullptr, ndjson ? CONTENT_TYPE_NDJSON : CONTENT_TYPE_JSON);
+}
+
+// Runs on the I/O thread: the request is copied off the stream there, and its
+// validation is handed over to the workers. It is rejected right away when
+// they cannot keep up. With admission
+// control, requests are also rejected by the latency their queue predicts,
+// and shed by a worker when the queue keeps them too long. Interactive
+// requests only wait for the interactive ones, bulk requests for both
+void ValidatorHttp2AsyncServer::dispatch(std::shared_ptr<http2::Stream> stream,
+                                         entities::Priority byDefault,
+                                         task_t &&task) {
+  using clock_t = entities::AdmissionController::clock_t;
+  auto request = std::make_shared<StreamRequest>();
+  setHTTPInfoRequest(*stream, request->info, request->context);
+  auto priority = requestPriority(request->info, byDefault);
+  if (auto *controller = admission[static_cast<std::size_t>(priority)].get()) {
+    auto waiting = waitingFor(priority);
+    if (not controller->admit(waiting, workers.threads())) {
+      LOG_ERR("Validation latency over its objective. Request rejected",
+              "pending", std::to_string(waiting));
+      reject(stream, request->context, priority,
+             "Validation latency over its objective");
+      return;
+    }
+    task = [this, stream, priority, controller, task = std::move(task),
+            queued = clock_t::now()](StreamRequest &request) {
+      auto started = clock_t::now();
+      if (controller->onDequeue(started - queued, started)) {
+        LOG_ERR("Validation queue is standing. Request shed", "pending",
+                std::to_string(workers.pending()));
+        reject(stream, request.context, priority,
+               "Validation queue is standing");
+        return;
+      }
+      task(request);
+      controller->onComplete(clock_t::now() - started);
+    };
+  }
+  if (workers.submit([task = std::move(task), request]() { task(*request); },
+                     priority)) {
+    return;
+  }
+  LOG_ERR("Validation queue is full. Request rejected", "pending",
+          std::to_string(workers.pending()));
+  reject(stream, request->context, priority, "Validation queue is full");
+}
+
+// Runs on the I/O thread or on a worker, so the tracing headers are taken
+// from the copy of the request, not from the stream
+void ValidatorHttp2AsyncServer::reject(
+    const std::shared_ptr<http2::Stream> &stream,
+    const entities::Context &contextRequest, entities::Priority priority,
+    const char *description) {
+  http2::headers_t headers = contextRequest.getTracingHeaders();
+  headers.emplace("content-type", CONTENT_TYPE_JSON);
+  const auto *controller = getAdmission(priority);
+  auto retryAfter = controller ? controller->retryAfter(waitingFor(priority),
+                                                       workers.threads())
+                               : std::chrono::seconds{1};
+  headers.emplace("retry-after", std::to_string(retryAfter.count()));
+  port::secondary::json::ValidatorRapidJsonEncoder encoder;
+  entities::Error error =
+      entities::requestError("Service unavailable", description);
+  metrics.recordOutcome(::port::HTTP_SERVICE_UNAVAILABLE);
+  endStream(stream, ::port::HTTP_SERVICE_UNAVAILABLE, std::move(headers),
+            encoder.errorResponseToJson(error).str());
 }
 
 std::uint32_t ValidatorHttp2AsyncServer::start(const std::string &port) {
   server.handle(READINESS_PROBE_URI, handleHttp2RequestHealthy);
-  server.handle("/", handleHttp2Request);
+  server.handle(METRICS_URI, [this](std::shared_ptr<http2::Stream> stream) {
+    handleHttp2RequestMetrics(std::move(stream), metrics, responsePolicy,
+                              *this);
+  });
+  server.handle("/", [this](std::shared_ptr<http2::Stream> stream) {
+    dispatch(stream, entities::Priority::INTERACTIVE,
+             [this, stream](StreamRequest &request) {
+               handleHttp2Request(
+                   stream, request, responsePolicy, jsonParser,
+                   {workers, minParallelChanges, metrics, spans});
+             });
+  });
+  server.handle(BATCH_URI, [this](std::shared_ptr<http2::Stream> stream) {
+    dispatch(stream, entities::Priority::BULK,
+             [this, stream](StreamRequest &request) {
+               handleHttp2BatchRequest(
+                   stream, request, jsonParser, maxBatchItems,
+                   {workers, minParallelChanges, metrics, spans});
+             });
+  });
   auto startError = server.listenAndServe(port);
   if (startError) {
     LOG_ERR("Unable to start server", "port", port);
@@ -1,27 +1,196 @@
 #ifndef __AUTHENTICATION_PROVISIONING_VALIDATOR_HTTP2_ASYNC_SERVER__
 #define __AUTHENTICATION_PROVISIONING_VALIDATOR_HTTP2_ASYNC_SERVER__
 
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+
 #include "IfaceServer.hpp"
+#include "ResponseValidationPolicy.hpp"
 #include "cpph2/server.hpp"
 #include "cpph2/stream.hpp"
+#include "entities/AdmissionController.hpp"
 #include "entities/Context.hpp"
+#include "entities/Metrics.hpp"
+#include "entities/Tracing.hpp"
+#include "entities/WorkerPool.hpp"
+#include "openapi3/HTTPinfo.hpp"
 
 namespace port {
 namespace primary {
 
-void sendResponse(const entities::Context &, std::shared_ptr<http2::Stream>,
-                  const std::uint32_t &, const std::string &, const bool);
+constexpr auto CONTENT_TYPE_JSON = "application/json";
+constexpr auto CONTENT_TYPE_NDJSON = "application/x-ndjson";
+constexpr auto CONTENT_TYPE_PROMETHEUS = "text/plain; version=0.0.4";
+
+// Changes of a request from which its rules are applied over the workers
+constexpr std::size_t MIN_PARALLEL_CHANGES = 64;
+// Documents a batch request may hold, it is answered 413 above
+constexpr std::size_t MAX_BATCH_ITEMS = 1000;
+
+constexpr auto JSON_PARSER_DOM = "dom";
+constexpr auto JSON_PARSER_SAX = "sax";
+
+// How request bodies are read:
+//   - dom: parsed in situ into a rapidjson::Document the validation data
+//     borrows from.
+//   - sax: the validation data is extracted by ValidatorRapidJsonSaxParser
+//     while the body is read, with no document built.
+// Either way the OpenAPI request validation works on the body text first.
+enum class JsonParser { DOM, SAX };
+
+// Traffic class a request asks for, by one of entities::PRIORITY_NAMES.
+// Validation requests are interactive unless they ask otherwise, batch ones
+// are bulk
+constexpr auto PRIORITY_HEADER = "x-provisioning-priority";
+
+// Unknown priorities fall back to byDefault
+inline entities::Priority toPriority(std::string_view priority,
+                                     entities::Priority byDefault) {
+  for (std::size_t i = 0; i < entities::PRIORITY_NAMES.size(); ++i) {
+    if (priority == entities::PRIORITY_NAMES[i]) {
+      return static_cast<entities::Priority>(i);
+    }
+  }
+  return byDefault;
+}
+
+// Unknown parsers fall back to dom
+inline JsonParser toJsonParser(std::string_view parser) {
+  return parser == JSON_PARSER_SAX ? JsonParser::SAX : JsonParser::DOM;
+}
+
+// What a worker needs of a request, copied on the I/O thread when it is
+// dispatched: workers never read the stream, they only post its end
+struct StreamRequest {
+  httpinfo::Info info;
+  entities::Context context;
+};
+
+// The response is validated against the schema when the policy asks for it.
+// No validation at all with a null policy. The status sent is counted in the
+// metrics, when given. The body is handed over to the stream
+void sendResponse(const StreamRequest &, std::shared_ptr<http2::Stream>,
+                  const std::uint32_t &, std::string &&,
+                  ResponseValidationPolicy *, entities::Metrics *,
+                  std::string_view contentType = CONTENT_TYPE_JSON);
+
+// A batch item as the request it stands for: a JSON document posted to the
+// path the batch path extends. It keeps the other headers of the batch, but
+// not its content type and length, which describe the whole batch
+httpinfo::Info batchItemInfo(const httpinfo::Info &batch,
+                             std::string_view item);
+
+// Left as they are, the settings give a server with the defaults of the
+// environment
+struct ServerSettings {
+  std::size_t workerThreads{entities::WorkerPool::DEFAULT_THREADS};
+  std::size_t workerQueueSize{entities::WorkerPool::DEFAULT_QUEUE_SIZE};
+  // Workers take a bulk task every interactiveWeight interactive ones, when
+  // both are waiting
+  std::size_t interactiveWeight{
+      entities::WorkerPool::DEFAULT_INTERACTIVE_WEIGHT};
+  std::string_view responseValidation{RESPONSE_VALIDATION_ALWAYS};
+  std::size_t responseSampleRate{1};
+  std::string_view jsonParser{JSON_PARSER_DOM};
+  std::size_t minParallelChanges{MIN_PARALLEL_CHANGES};
+  std::size_t maxBatchItems{MAX_BATCH_ITEMS};
+  // The stages of traced requests are recorded in spans, which must outlive
+  // the server. No tracing when null
+  entities::SpanRing *spans{nullptr};
+  // Requests are admitted to the workers by their queue latency, when there
+  // are admission settings
+  std::optional<entities::AdmissionSettings> admission;
+};
 
 class ValidatorHttp2AsyncServer final : public IfaceServer {
  public:
   ValidatorHttp2AsyncServer() = default;
+  explicit ValidatorHttp2AsyncServer(const ServerSettings &settings)
+      : jsonParser{toJsonParser(settings.jsonParser)},
+        minParallelChanges{settings.minParallelChanges},
+        maxBatchItems{settings.maxBatchItems},
+        responsePolicy{settings.responseValidation,
+                       settings.responseSampleRate},
+        spans{settings.spans},
+        admission{makeAdmission(settings.admission)},
+        workers{settings.workerThreads, settings.workerQueueSize,
+                settings.interactiveWeight} {}
   ValidatorHttp2AsyncServer(ValidatorHttp2AsyncServer &&) = delete;
   ~ValidatorHttp2AsyncServer() = default;
   std::uint32_t start(const std::string &) override;
-  inline void stop() override { server.stop(); }
+  inline void stop() override {
+    server.stop();
+    workers.stop();
+  }
+
+  inline const ResponseValidationPolicy &getResponsePolicy() const {
+    return responsePolicy;
+  }
+  inline const entities::Metrics &getMetrics() const { return metrics; }
+  // Null without admission control
+  inline const entities::AdmissionController *getAdmission(
+      entities::Priority priority = entities::Priority::INTERACTIVE) const {
+    return admission[static_cast<std::size_t>(priority)].get();
+  }
+  inline JsonParser getJsonParser() const { return jsonParser; }
+  inline std::size_t getMinParallelChanges() const {
+    return minParallelChanges;
+  }
+  inline std::size_t getMaxBatchItems() const { return maxBatchItems; }
 
  private:
+  using admission_t = std::array<std::unique_ptr<entities::AdmissionController>,
+                                  entities::PRIORITY_NAMES.size()>;
+
+  // A controller for each priority, so bulk work waiting does not get
+  // interactive requests rejected
+  static admission_t makeAdmission(
+      const std::optional<entities::AdmissionSettings> &settings) {
+    admission_t admission;
+    if (settings) {
+      for (auto &controller : admission) {
+        controller = std::make_unique<entities::AdmissionController>(*settings);
+      }
+    }
+    return admission;
+  }
+
+  // Tasks a new one of the priority waits for: interactive ones jump ahead
+  // of the bulk ones
+  inline std::size_t waitingFor(entities::Priority priority) const {
+    return priority == entities::Priority::BULK ? workers.pending()
+                                                : workers.pending(priority);
+  }
+  // Handles the copy of a request on a worker
+  using task_t = std::function<void(StreamRequest &)>;
+
+  // The request is copied off the stream, and the task handles the copy on a
+  // worker, with the priority the request asks for
+  void dispatch(std::shared_ptr<http2::Stream>, entities::Priority byDefault,
+                task_t &&);
+  // 503 answer, with the time the queue is expected to drain in
+  void reject(const std::shared_ptr<http2::Stream> &,
+              const entities::Context &, entities::Priority,
+              const char *description);
+
   http2::Server server;
+  const JsonParser jsonParser{JsonParser::DOM};
+  const std::size_t minParallelChanges{MIN_PARALLEL_CHANGES};
+  const std::size_t maxBatchItems{MAX_BATCH_ITEMS};
+  ResponseValidationPolicy responsePolicy;
+  entities::Metrics metrics;
+  // No tracing when null
+  entities::SpanRing *const spans{nullptr};
+  // No admission control when null
+  const admission_t admission;
+  // Declared last: pending validations are finished, and the end of their
+  // streams posted, before the metrics, the policy and the server are
+  // destroyed
+  entities::WorkerPool workers;
 };
 
 }  // namespace primary
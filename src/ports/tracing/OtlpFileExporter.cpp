@@ -0,0 +1,221 @@
+#include "OtlpFileExporter.hpp"
+
+#include <filesystem>
+#include <rapidjson/writer.h>
+#include <system_error>
+
+#include "log/logout.hpp"
+
+namespace port {
+namespace secondary {
+namespace tracing {
+
+namespace {
+
+// SPAN_KIND_INTERNAL: the stages do not cross the process
+constexpr int SPAN_KIND_INTERNAL = 1;
+
+// rapidjson output stream appending to a string owned by the caller
+class StringOutputStream final {
+ public:
+  using Ch = char;
+  explicit StringOutputStream(std::string &out) : out{out} {}
+  void Put(Ch c) { out.push_back(c); }
+  void Flush() {}
+
+ private:
+  std::string &out;
+};
+
+using writer_t = rapidjson::Writer<StringOutputStream>;
+
+void appendHex(std::uint64_t value, std::string &out) {
+  constexpr auto DIGITS = "0123456789abcdef";
+  for (int shift = 60; shift >= 0; shift -= 4) {
+    out.push_back(DIGITS[(value >> shift) & 0xf]);
+  }
+}
+
+void writeHex(writer_t &writer, const char *key, std::uint64_t high,
+              std::uint64_t low, bool wide) {
+  std::string hex;
+  if (wide) {
+    appendHex(high, hex);
+  }
+  appendHex(low, hex);
+  writer.Key(key);
+  writer.String(hex.c_str(), static_cast<rapidjson::SizeType>(hex.size()));
+}
+
+// 64 bit integers are strings in the protobuf JSON mapping
+void writeNanos(writer_t &writer, const char *key, std::uint64_t nanos) {
+  auto text = std::to_string(nanos);
+  writer.Key(key);
+  writer.String(text.c_str(), static_cast<rapidjson::SizeType>(text.size()));
+}
+
+void writeSpan(writer_t &writer, const entities::Span &span) {
+  const auto &context = span.context;
+  auto name = entities::STAGE_NAMES[static_cast<std::size_t>(span.stage)];
+  writer.StartObject();
+  // 64 bit trace ids are sent as 128 bit ones, with zeros first
+  writeHex(writer, "traceId", context.traceIdHigh, context.traceIdLow, true);
+  writeHex(writer, "spanId", 0, span.spanId, false);
+  if (context.parentSpanId) {
+    writeHex(writer, "parentSpanId", 0, context.parentSpanId, false);
+  }
+  writer.Key("name");
+  writer.String(name.data(), static_cast<rapidjson::SizeType>(name.size()));
+  writer.Key("kind");
+  writer.Int(SPAN_KIND_INTERNAL);
+  writeNanos(writer, "startTimeUnixNano", span.startUnixNanos);
+  writeNanos(writer, "endTimeUnixNano",
+             span.startUnixNanos + span.durationNanos);
+  writer.EndObject();
+}
+
+}  // namespace
+
+void spansToOtlpJson(const std::vector<entities::Span> &spans,
+                     std::string_view serviceName, std::string &out) {
+  StringOutputStream stream{out};
+  writer_t writer{stream};
+  writer.StartObject();
+  writer.Key("resourceSpans");
+  writer.StartArray();
+  writer.StartObject();
+
+  writer.Key("resource");
+  writer.StartObject();
+  writer.Key("attributes");
+  writer.StartArray();
+  writer.StartObject();
+  writer.Key("key");
+  writer.String("service.name");
+  writer.Key("value");
+  writer.StartObject();
+  writer.Key("stringValue");
+  writer.String(serviceName.data(),
+                static_cast<rapidjson::SizeType>(serviceName.size()));
+  writer.EndObject();
+  writer.EndObject();
+  writer.EndArray();
+  writer.EndObject();
+
+  writer.Key("scopeSpans");
+  writer.StartArray();
+  writer.StartObject();
+  writer.Key("scope");
+  writer.StartObject();
+  writer.Key("name");
+  writer.String(OTLP_SCOPE_NAME);
+  writer.EndObject();
+  writer.Key("spans");
+  writer.StartArray();
+  for (const auto &span : spans) {
+    writeSpan(writer, span);
+  }
+  writer.EndArray();
+  writer.EndObject();
+  writer.EndArray();
+
+  writer.EndObject();
+  writer.EndArray();
+  writer.EndObject();
+}
+
+OtlpFileExporter::OtlpFileExporter(entities::SpanRing &spans,
+                                   const std::string &path,
+                                   std::string_view serviceName,
+                                   std::chrono::milliseconds interval,
+                                   std::uint64_t maxFileSize)
+    : spans{spans},
+      serviceName{serviceName},
+      interval{interval},
+      path{path},
+      maxFileSize{maxFileSize},
+      file{path, std::ios::out | std::ios::app} {
+  if (not file.is_open()) {
+    LOG_ERR("Unable to open trace file. Spans are not exported", "file",
+            path);
+    return;
+  }
+  std::error_code error;
+  fileSize = std::filesystem::file_size(path, error);
+  if (error) {
+    fileSize = 0;
+  }
+  batch.reserve(MAX_SPANS_PER_EXPORT);
+  thread = std::thread([this]() { run(); });
+}
+
+OtlpFileExporter::~OtlpFileExporter() { stop(); }
+
+void OtlpFileExporter::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeUp.notify_one();
+  if (thread.joinable()) {
+    thread.join();
+  }
+}
+
+void OtlpFileExporter::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  bool last = false;
+  while (not last) {
+    wakeUp.wait_for(lock, interval, [this]() { return stopping; });
+    last = stopping;
+    lock.unlock();
+    while (exportSpans()) {
+    }
+    lock.lock();
+  }
+}
+
+bool OtlpFileExporter::exportSpans() {
+  batch.clear();
+  if (spans.drain(batch, MAX_SPANS_PER_EXPORT) == 0) {
+    return false;
+  }
+  line.clear();
+  spansToOtlpJson(batch, serviceName, line);
+  line.push_back('\n');
+  if (fileSize and fileSize + line.size() > maxFileSize) {
+    rotate();
+  }
+  file.write(line.data(), static_cast<std::streamsize>(line.size()));
+  file.flush();
+  fileSize += line.size();
+  exportedCount.fetch_add(batch.size(), std::memory_order_relaxed);
+
+  auto dropped = spans.dropped();
+  if (dropped != reportedDrops) {
+    LOG_ERR("Span ring was full. Spans dropped", "dropped",
+            std::to_string(dropped - reportedDrops));
+    reportedDrops = dropped;
+  }
+  return true;
+}
+
+void OtlpFileExporter::rotate() {
+  file.close();
+  std::error_code error;
+  std::filesystem::rename(path, path + ROTATED_TRACE_FILE_SUFFIX, error);
+  if (error) {
+    LOG_ERR("Unable to rotate trace file. It is started again", "file", path,
+            "error", error.message());
+  }
+  file.open(path, std::ios::out | std::ios::trunc);
+  fileSize = 0;
+  if (not file.is_open()) {
+    LOG_ERR("Unable to open trace file. Spans are not exported", "file",
+            path);
+  }
+}
+
+}  // namespace tracing
+}  // namespace secondary
+}  // namespace port
@@ -0,0 +1,87 @@
+#ifndef __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_OTLP_FILE_EXPORTER__
+#define __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_OTLP_FILE_EXPORTER__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "entities/Tracing.hpp"
+
+namespace port {
+namespace secondary {
+namespace tracing {
+
+constexpr auto OTLP_SCOPE_NAME = "authprovvalidator";
+// Spans written at most in one line
+constexpr std::size_t MAX_SPANS_PER_EXPORT = 512;
+// Size of the file from which it is rotated
+constexpr std::uint64_t MAX_TRACE_FILE_SIZE = 64ull << 20;
+// The rotated file is the path with this suffix
+constexpr auto ROTATED_TRACE_FILE_SUFFIX = ".1";
+
+// Appends the spans to out as one OTLP-JSON ExportTraceServiceRequest, with
+// no line feed. Ids are lowercase hex and times are nanoseconds since the
+// epoch, as the OTLP-JSON encoding has them
+void spansToOtlpJson(const std::vector<entities::Span> &,
+                     std::string_view serviceName, std::string &out);
+
+// Drains the span ring every interval, on a thread of its own, and appends
+// the spans to a file, one ExportTraceServiceRequest per line, as the
+// OpenTelemetry file exporter writes them. What is left in the ring is
+// written when it stops. A line that would take the file over maxFileSize
+// starts a new one, the former replacing the last rotated file, so the spans
+// take at most twice maxFileSize on disk
+class OtlpFileExporter final {
+ public:
+  OtlpFileExporter(entities::SpanRing &, const std::string &path,
+                   std::string_view serviceName,
+                   std::chrono::milliseconds interval,
+                   std::uint64_t maxFileSize = MAX_TRACE_FILE_SIZE);
+  OtlpFileExporter(const OtlpFileExporter &) = delete;
+  ~OtlpFileExporter();
+
+  // It is idempotent
+  void stop();
+
+  inline bool isOpen() const { return file.is_open(); }
+  inline std::uint64_t exported() const {
+    return exportedCount.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void run();
+  // Returns whether the ring had spans
+  bool exportSpans();
+  void rotate();
+
+  entities::SpanRing &spans;
+  const std::string serviceName;
+  const std::chrono::milliseconds interval;
+  const std::string path;
+  const std::uint64_t maxFileSize;
+  std::ofstream file;
+  std::uint64_t fileSize{0};
+  std::vector<entities::Span> batch;
+  std::string line;
+  std::atomic<std::uint64_t> exportedCount{0};
+  std::uint64_t reportedDrops{0};
+
+  std::mutex mutex;
+  std::condition_variable wakeUp;
+  bool stopping{false};
+  std::thread thread;
+};
+
+}  // namespace tracing
+}  // namespace secondary
+}  // namespace port
+
+#endif  // __UDM_AUTHENTICATION_PROVISIONING_VALIDATOR_OTLP_FILE_EXPORTER__
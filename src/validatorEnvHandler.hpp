@@ -1,6 +1,7 @@
 #ifndef __AUTHENTICATION_PROVISIONING_VALIDATOR_ENV_HANDLER__
 #define __AUTHENTICATION_PROVISIONING_VALIDATOR_ENV_HANDLER__
 
+#include <cstddef>
 #include <cstdlib>
 #include <map>
 #include <string>
@@ -28,6 +29,56 @@ constexpr auto DEFAULT_CPU_REQUEST_INFO = "/etc/podinfo/main_cpu_request";
 constexpr auto ENABLED = "on";
 constexpr auto DEFAULT_OVERLOAD_PROTECTION_VALUE = ENABLED;
 constexpr auto ENV_OVERLOAD_PROTECTION = "OVERLOADPROTECTION";
+// latency | cpu
+constexpr auto ENV_OVERLOAD_CONTROL = "OVERLOADCONTROL";
+constexpr auto OVERLOAD_CONTROL_LATENCY = "latency";
+constexpr auto OVERLOAD_CONTROL_CPU = "cpu";
+constexpr auto DEFAULT_OVERLOAD_CONTROL = OVERLOAD_CONTROL_LATENCY;
+// Milliseconds, of the latency overload control
+constexpr auto ENV_OVERLOAD_TARGET = "OVERLOADTARGET";
+constexpr std::size_t DEFAULT_OVERLOAD_TARGET_MS = 5;
+constexpr auto ENV_OVERLOAD_INTERVAL = "OVERLOADINTERVAL";
+constexpr std::size_t DEFAULT_OVERLOAD_INTERVAL_MS = 100;
+constexpr auto ENV_OVERLOAD_LATENCY_OBJECTIVE = "OVERLOADLATENCYOBJECTIVE";
+constexpr std::size_t DEFAULT_OVERLOAD_LATENCY_OBJECTIVE_MS = 200;
+
+constexpr auto ENV_WORKER_THREADS = "WORKERTHREADS";
+constexpr std::size_t DEFAULT_WORKER_THREADS = 2;
+constexpr auto ENV_WORKER_QUEUE_SIZE = "WORKERQUEUESIZE";
+constexpr std::size_t DEFAULT_WORKER_QUEUE_SIZE = 1024;
+// Changes of a request from which its rules are applied over the workers
+constexpr auto ENV_PARALLEL_CHANGES = "PARALLELCHANGES";
+constexpr std::size_t DEFAULT_PARALLEL_CHANGES = 64;
+// Interactive tasks a worker takes for a bulk one, when both are waiting
+constexpr auto ENV_INTERACTIVE_WEIGHT = "INTERACTIVEWEIGHT";
+constexpr std::size_t DEFAULT_INTERACTIVE_WEIGHT = 16;
+// Documents a batch request may hold
+constexpr auto ENV_MAX_BATCH_ITEMS = "MAXBATCHITEMS";
+constexpr std::size_t DEFAULT_MAX_BATCH_ITEMS = 1000;
+
+// always | sampled | off
+constexpr auto ENV_RESPONSE_VALIDATION = "RESPONSEVALIDATION";
+constexpr auto DEFAULT_RESPONSE_VALIDATION = "always";
+constexpr auto ENV_RESPONSE_VALIDATION_SAMPLE = "RESPONSEVALIDATIONSAMPLE";
+constexpr std::size_t DEFAULT_RESPONSE_VALIDATION_SAMPLE = 100;
+
+// dom | sax
+constexpr auto ENV_JSON_PARSER = "JSONPARSER";
+constexpr auto DEFAULT_JSON_PARSER = "dom";
+
+// logControl.json file of cpplog, the debug level is read from as well
+constexpr auto ENV_LOG_CONTROL_PATH = "LOGCONTROLPATH";
+
+// OTLP-JSON file the spans of traced requests are appended to. No tracing
+// when unset or empty
+constexpr auto ENV_TRACE_FILE = "TRACEFILE";
+constexpr auto ENV_TRACE_RING_SIZE = "TRACERINGSIZE";
+constexpr std::size_t DEFAULT_TRACE_RING_SIZE = 8192;
+constexpr auto ENV_TRACE_EXPORT_INTERVAL = "TRACEEXPORTINTERVAL";
+constexpr std::size_t DEFAULT_TRACE_EXPORT_INTERVAL_MS = 1000;
+// Megabytes of the trace file from which it is rotated
+constexpr auto ENV_TRACE_FILE_SIZE = "TRACEFILESIZE";
+constexpr std::size_t DEFAULT_TRACE_FILE_SIZE_MB = 64;
 
 std::map<std::string, std::string> defaultValues = {
     {ENV_HEALTHPROXY_ENDPOINT, DEFAULT_HEALTHPROXY_ENDPOINT}};
@@ -66,5 +117,117 @@ static inline const bool isOverloadProtected() {
   return ENABLED == overloadEnabled;
 }
 
+static inline const std::string getOverloadControl() {
+  const char *pValue = std::getenv(ENV_OVERLOAD_CONTROL);
+  if (nullptr == pValue) {
+    return std::string(DEFAULT_OVERLOAD_CONTROL);
+  }
+  return std::string(pValue);
+}
+
+// Positive integer read from the environment, or defaultValue when unset or
+// not valid
+static inline std::size_t getPositiveNumber(const char *envName,
+                                            const std::size_t defaultValue) {
+  const char *pValue = std::getenv(envName);
+  if (nullptr == pValue or *pValue < '0' or *pValue > '9') {
+    return defaultValue;
+  }
+  char *end = nullptr;
+  auto value = std::strtoull(pValue, &end, 10);
+  if (end == pValue or *end != '\0' or value == 0) {
+    return defaultValue;
+  }
+  return static_cast<std::size_t>(value);
+}
+
+static inline std::size_t getWorkerThreads() {
+  return getPositiveNumber(ENV_WORKER_THREADS, DEFAULT_WORKER_THREADS);
+}
+
+static inline std::size_t getWorkerQueueSize() {
+  return getPositiveNumber(ENV_WORKER_QUEUE_SIZE, DEFAULT_WORKER_QUEUE_SIZE);
+}
+
+static inline std::size_t getParallelChanges() {
+  return getPositiveNumber(ENV_PARALLEL_CHANGES, DEFAULT_PARALLEL_CHANGES);
+}
+
+static inline std::size_t getInteractiveWeight() {
+  return getPositiveNumber(ENV_INTERACTIVE_WEIGHT, DEFAULT_INTERACTIVE_WEIGHT);
+}
+
+static inline std::size_t getMaxBatchItems() {
+  return getPositiveNumber(ENV_MAX_BATCH_ITEMS, DEFAULT_MAX_BATCH_ITEMS);
+}
+
+static inline const std::string getResponseValidation() {
+  const char *pValue = std::getenv(ENV_RESPONSE_VALIDATION);
+  if (nullptr == pValue) {
+    return std::string(DEFAULT_RESPONSE_VALIDATION);
+  }
+  return std::string(pValue);
+}
+
+// One response validated every N when response validation is sampled
+static inline std::size_t getResponseValidationSample() {
+  return getPositiveNumber(ENV_RESPONSE_VALIDATION_SAMPLE,
+                           DEFAULT_RESPONSE_VALIDATION_SAMPLE);
+}
+
+static inline const std::string getJsonParser() {
+  const char *pValue = std::getenv(ENV_JSON_PARSER);
+  if (nullptr == pValue) {
+    return std::string(DEFAULT_JSON_PARSER);
+  }
+  return std::string(pValue);
+}
+
+static inline const std::string getLogControlPath() {
+  const char *pValue = std::getenv(ENV_LOG_CONTROL_PATH);
+  if (nullptr == pValue) {
+    return std::string();
+  }
+  return std::string(pValue);
+}
+
+static inline const std::string getTraceFile() {
+  const char *pValue = std::getenv(ENV_TRACE_FILE);
+  if (nullptr == pValue) {
+    return std::string();
+  }
+  return std::string(pValue);
+}
+
+static inline std::size_t getTraceRingSize() {
+  return getPositiveNumber(ENV_TRACE_RING_SIZE, DEFAULT_TRACE_RING_SIZE);
+}
+
+// Milliseconds between two exports of the spans
+static inline std::size_t getTraceExportInterval() {
+  return getPositiveNumber(ENV_TRACE_EXPORT_INTERVAL,
+                           DEFAULT_TRACE_EXPORT_INTERVAL_MS);
+}
+
+static inline std::size_t getTraceFileSize() {
+  return getPositiveNumber(ENV_TRACE_FILE_SIZE, DEFAULT_TRACE_FILE_SIZE_MB);
+}
+
+// Time in the worker queue above which requests start being shed
+static inline std::size_t getOverloadTarget() {
+  return getPositiveNumber(ENV_OVERLOAD_TARGET, DEFAULT_OVERLOAD_TARGET_MS);
+}
+
+static inline std::size_t getOverloadInterval() {
+  return getPositiveNumber(ENV_OVERLOAD_INTERVAL,
+                           DEFAULT_OVERLOAD_INTERVAL_MS);
+}
+
+// Predicted latency above which requests are rejected
+static inline std::size_t getOverloadLatencyObjective() {
+  return getPositiveNumber(ENV_OVERLOAD_LATENCY_OBJECTIVE,
+                           DEFAULT_OVERLOAD_LATENCY_OBJECTIVE_MS);
+}
+
 }  // namespace envHandler
 #endif  // __AUTHENTICATION_PROVISIONING_VALIDATOR_ENV_HANDLER__
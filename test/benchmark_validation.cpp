@@ -0,0 +1,650 @@
+#include <benchmark/benchmark.h>
+#include <boost/regex.hpp>
+#include <boost/variant.hpp>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "domain/validation.hpp"
+#include "entities/CharClass.hpp"
+#include "entities/RequestArena.hpp"
+#include "entities/ValidationData.hpp"
+#include "entities/mpmcqueue.hpp"
+#include "entities/types.hpp"
+#include "openapi3/HTTPinfo.hpp"
+#include "ports/json/JsonConstants.hpp"
+#include "ports/json/ValidatorRapidJsonEncoder.hpp"
+#include "ports/json/ValidatorRapidJsonParser.hpp"
+#include "ports/json/ValidatorRapidJsonSaxParser.hpp"
+#include "ports/logs/logwrapper.hpp"
+#include "ports/oaivalidator/OaiValidator.hpp"
+#include "ports/ports.hpp"
+#include "validatorEnvHandler.hpp"
+
+// Every stage of a validation request, and the whole of it, over requests
+// made from scripts/perf/authprovdata.json. Each benchmark takes the number
+// of changes of the request and the number of related resources it carries
+// besides the ones of its changes. The structures a request goes through
+// are measured on their own after them. Results are written as JSON with
+// --benchmark_out=<file> --benchmark_out_format=json
+
+namespace {
+
+std::atomic<std::size_t> heapAllocations{0};
+
+}  // namespace
+
+// Heap allocations are counted, to report how many a request makes beyond
+// its arena
+void *operator new(std::size_t size) {
+  heapAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  ::operator delete(ptr);
+}
+
+namespace {
+
+constexpr auto VALIDATE_URI = "/validation/v1/validate/validate";
+constexpr auto TEMPLATE_MSC_ID = "123abc";
+constexpr auto TEMPLATE_IMSI = "123456789012345";
+constexpr auto EXTRA_LEGACY =
+    "{\"FSETIND\":0,\"EKI\":\"1032547698BADCFE\",\"KIND\":11,\"A4IND\":2,"
+    "\"AMFVALUE\":1,\"EOPC\":\"32\",\"SEQHE\":\"20\",\"VNUMBER\":16,"
+    "\"AKAALGIND\":0}";
+
+std::string sourceFile(const char *env, const std::string &path) {
+  if (const char *file = std::getenv(env)) {
+    return file;
+  }
+  return std::string{AUTHPROVVALIDATOR_SOURCE_DIR} + "/" + path;
+}
+
+std::string readFile(const std::string &path) {
+  std::ifstream file{path};
+  if (not file) {
+    throw std::runtime_error{"Unable to read " + path};
+  }
+  std::ostringstream text;
+  text << file.rdbuf();
+  return text.str();
+}
+
+std::string toString(const rapidjson::Value &value) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  value.Accept(writer);
+  return buffer.GetString();
+}
+
+std::string replaceAll(std::string text, const std::string &from,
+                       const std::string &to) {
+  for (auto pos = text.find(from); pos != std::string::npos;
+       pos = text.find(from, pos + to.size())) {
+    text.replace(pos, from.size(), to);
+  }
+  return text;
+}
+
+std::string imsiOf(std::size_t prefix, std::size_t n) {
+  auto digits = std::to_string(n);
+  return std::to_string(prefix) + std::string(14 - digits.size(), '0') +
+         digits;
+}
+
+// The change of authprovdata.json and its related authSubscription, made
+// for one subscriber after the other. The extra related resources are
+// legacy subscriptions of other subscribers
+class CorpusTemplate final {
+ public:
+  CorpusTemplate() {
+    rapidjson::Document document;
+    auto text = readFile(
+        sourceFile("AUTHPROVDATA", "scripts/perf/authprovdata.json"));
+    document.Parse(text.c_str(), text.size());
+    if (document.HasParseError() or not document.HasMember(JSON_CHANGES) or
+        not document.HasMember(JSON_RELATED_RESOURCES)) {
+      throw std::runtime_error{"authprovdata.json is not a validation request"};
+    }
+    change = toString(document[JSON_CHANGES][rapidjson::SizeType{0}]);
+    const auto &related = document[JSON_RELATED_RESOURCES];
+    auto resource = related.MemberBegin();
+    relatedPath = resource->name.GetString();
+    relatedValue = toString(resource->value);
+  }
+
+  std::string request(std::size_t changes, std::size_t related) const {
+    std::string body{"{\""};
+    body.append(JSON_CHANGES).append("\":[");
+    for (std::size_t n = 0; n < changes; ++n) {
+      body.append(n ? "," : "").append(forSubscriber(change, n));
+    }
+    body.append("],\"").append(JSON_RELATED_RESOURCES).append("\":{");
+    for (std::size_t n = 0; n < changes; ++n) {
+      body.append(n ? ",\"" : "\"")
+          .append(forSubscriber(relatedPath, n))
+          .append("\":")
+          .append(forSubscriber(relatedValue, n));
+    }
+    for (std::size_t n = 0; n < related; ++n) {
+      body.append(changes + n ? ",\"" : "\"")
+          .append(entities::LEGACY_BASE_PATH)
+          .append(imsiOf(2, n))
+          .append("\":")
+          .append(EXTRA_LEGACY);
+    }
+    return body.append("}}");
+  }
+
+ private:
+  static std::string forSubscriber(const std::string &text, std::size_t n) {
+    return replaceAll(
+        replaceAll(text, TEMPLATE_MSC_ID, "msc" + std::to_string(n)),
+        TEMPLATE_IMSI, imsiOf(1, n));
+  }
+
+  std::string change;
+  std::string relatedPath;
+  std::string relatedValue;
+};
+
+const std::string &corpus(const benchmark::State &state) {
+  static const CorpusTemplate corpusTemplate;
+  static std::map<std::pair<std::int64_t, std::int64_t>, std::string> requests;
+  auto key = std::make_pair(state.range(0), state.range(1));
+  auto found = requests.find(key);
+  if (found == requests.end()) {
+    found = requests
+                .emplace(key, corpusTemplate.request(key.first, key.second))
+                .first;
+  }
+  return found->second;
+}
+
+httpinfo::Info requestOf(const std::string &body) {
+  httpinfo::Info info;
+  info.headers.emplace("content-type", "application/json");
+  info.json = body;
+  info.uri = VALIDATE_URI;
+  info.method = "POST";
+  return info;
+}
+
+void registerOaiValidator() {
+  static const bool registered = [] {
+    ::port::secondary::registerInterface<
+        ::port::secondary::OaiValidatorInterface,
+        ::port::secondary::OaiValidator>(
+        sourceFile(envHandler::ENV_OAISCHEMA_FILE,
+                   "schema/authprovvalidator.yaml"));
+    return true;
+  }();
+  benchmark::DoNotOptimize(registered);
+}
+
+// Heap allocations and bytes of request per iteration
+class Counters final {
+ public:
+  explicit Counters(benchmark::State &state)
+      : state{state},
+        allocations{heapAllocations.load(std::memory_order_relaxed)} {}
+  ~Counters() {
+    state.counters["allocs"] = benchmark::Counter(
+        heapAllocations.load(std::memory_order_relaxed) - allocations,
+        benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<std::int64_t>(corpus(state).size()));
+  }
+
+ private:
+  benchmark::State &state;
+  std::size_t allocations;
+};
+
+// The corpus must go all the way through, or the figures would be those of
+// an early error
+bool checkCorpus(benchmark::State &state) {
+  registerOaiValidator();
+  auto info = requestOf(corpus(state));
+  if (::domain::validation::validateRequest(info)) {
+    state.SkipWithError("Corpus rejected by the OpenAPI validation");
+    return false;
+  }
+  ::port::secondary::json::ValidatorRapidJsonParser parser(info.json);
+  entities::ValidationData data;
+  if (not parser.getValidationData(data) or data.hasErrors() or
+      not std::get<entities::VALIDATION>(data.applyValidationRules())) {
+    state.SkipWithError("Corpus rejected by the validation rules");
+    return false;
+  }
+  return true;
+}
+
+void BM_OpenApiValidate(benchmark::State &state) {
+  if (not checkCorpus(state)) {
+    return;
+  }
+  auto info = requestOf(corpus(state));
+  Counters counters{state};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(::domain::validation::validateRequest(info));
+  }
+}
+
+void BM_ParseDom(benchmark::State &state) {
+  if (not checkCorpus(state)) {
+    return;
+  }
+  const auto &body = corpus(state);
+  Counters counters{state};
+  for (auto _ : state) {
+    entities::RequestArena arena;
+    ::port::secondary::json::ValidatorRapidJsonParser parser(
+        std::string{body}, arena);
+    entities::ValidationData data;
+    benchmark::DoNotOptimize(parser.getValidationData(data));
+  }
+}
+
+void BM_ParseSax(benchmark::State &state) {
+  if (not checkCorpus(state)) {
+    return;
+  }
+  const auto &body = corpus(state);
+  Counters counters{state};
+  for (auto _ : state) {
+    entities::RequestArena arena;
+    ::port::secondary::json::ValidatorRapidJsonSaxParser parser(
+        std::string{body}, arena);
+    entities::ValidationData data;
+    benchmark::DoNotOptimize(parser.getValidationData(data));
+  }
+}
+
+// The rules change the data they are applied to, so it is parsed again,
+// with the timer paused, before each iteration
+void BM_ApplyValidationRules(benchmark::State &state) {
+  if (not checkCorpus(state)) {
+    return;
+  }
+  const auto &body = corpus(state);
+  std::optional<::port::secondary::json::ValidatorRapidJsonParser> parser;
+  std::optional<entities::ValidationData> data;
+  std::size_t allocations = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    data.reset();
+    parser.reset();
+    parser.emplace(body);
+    data.emplace();
+    parser->getValidationData(*data);
+    auto before = heapAllocations.load(std::memory_order_relaxed);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(data->applyValidationRules());
+    allocations += heapAllocations.load(std::memory_order_relaxed) - before;
+  }
+  state.counters["allocs"] =
+      benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+}
+
+void BM_EncodeResponse(benchmark::State &state) {
+  if (not checkCorpus(state)) {
+    return;
+  }
+  ::port::secondary::json::ValidatorRapidJsonParser parser(corpus(state));
+  entities::ValidationData data;
+  parser.getValidationData(data);
+  data.applyValidationRules();
+  std::string out;
+  Counters counters{state};
+  for (auto _ : state) {
+    entities::RequestArena arena;
+    ::port::secondary::json::ValidatorRapidJsonEncoder encoder(arena);
+    encoder.validatorResponseToJson(data, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+}
+
+void BM_AnonymizeJson(benchmark::State &state) {
+  if (not checkCorpus(state)) {
+    return;
+  }
+  const auto &body = corpus(state);
+  Counters counters{state};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(::anonlog::anonymizeJson(body));
+  }
+}
+
+// As validateDocument() does it with the DOM parser, from the body received
+// to the response encoded
+void BM_EndToEnd(benchmark::State &state) {
+  if (not checkCorpus(state)) {
+    return;
+  }
+  const auto &body = corpus(state);
+  Counters counters{state};
+  for (auto _ : state) {
+    entities::RequestArena arena;
+    auto info = requestOf(body);
+    benchmark::DoNotOptimize(::domain::validation::validateRequest(info));
+    ::port::secondary::json::ValidatorRapidJsonParser parser(
+        std::move(info.json), arena);
+    entities::ValidationData data;
+    ::port::secondary::json::ValidatorRapidJsonEncoder encoder(arena);
+    std::string out;
+    parser.getValidationData(data);
+    benchmark::DoNotOptimize(data.applyValidationRules());
+    encoder.validatorResponseToJson(data, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+}
+
+// Baseline of the queue benchmarks: a queue behind a mutex, as the workers
+// were first fed through
+template <typename T>
+class MutexQueue final {
+ public:
+  void push(T item) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push(std::move(item));
+    }
+    cond.notify_one();
+  }
+
+  T pop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this]() { return not queue.empty(); });
+    auto item = std::move(queue.front());
+    queue.pop();
+    return item;
+  }
+
+ private:
+  std::queue<T> queue;
+  std::mutex mutex;
+  std::condition_variable cond;
+};
+
+constexpr long QUEUE_ITEMS_PER_PRODUCER = 100000;
+
+// As many producers as consumers, given by the argument, go through the
+// queue with QUEUE_ITEMS_PER_PRODUCER items each
+template <typename Push, typename Pop>
+void produceAndConsume(benchmark::State &state, Push push, Pop pop) {
+  auto threads = state.range(0);
+  for (auto _ : state) {
+    std::vector<std::thread> workers;
+    for (long t = 0; t < threads; ++t) {
+      workers.emplace_back([&push]() {
+        for (long n = 0; n < QUEUE_ITEMS_PER_PRODUCER; ++n) {
+          push(n);
+        }
+      });
+      workers.emplace_back([&pop]() {
+        for (long n = 0; n < QUEUE_ITEMS_PER_PRODUCER; ++n) {
+          pop();
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * threads *
+                          QUEUE_ITEMS_PER_PRODUCER);
+}
+
+void BM_MutexQueue(benchmark::State &state) {
+  MutexQueue<long> queue;
+  produceAndConsume(
+      state, [&queue](long n) { queue.push(n); },
+      [&queue]() { benchmark::DoNotOptimize(queue.pop()); });
+}
+
+void BM_BlockingMpmcQueue(benchmark::State &state) {
+  entities::BlockingMpmcQueue<long> queue(1024);
+  produceAndConsume(
+      state, [&queue](long n) { queue.push(std::move(n)); },
+      [&queue]() {
+        long item = 0;
+        queue.pop(item);
+        benchmark::DoNotOptimize(item);
+      });
+}
+
+void queueThreads(benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgName("threads")->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+}
+
+bool regexMatches(const boost::regex &pattern, const std::string &value) {
+  boost::cmatch cm;
+  return boost::regex_match(value.c_str(), cm, pattern);
+}
+
+// As the static data fields were checked before entities::charclass: the
+// digits pattern, then std::stoi
+bool regexInRange(const std::string &value, int min, int max) {
+  static const boost::regex digits{entities::ALGORITHM_ID_PATTERN};
+  if (not regexMatches(digits, value)) {
+    return false;
+  }
+  try {
+    auto number = std::stoi(value);
+    return number >= min and number <= max;
+  } catch (...) {
+    return false;
+  }
+}
+
+// A valid value of a static data field, with its former check and the
+// entities::charclass one
+struct FieldCheck {
+  const char *field;
+  std::string value;
+  std::function<bool(const std::string &)> regexCheck;
+  std::function<bool(const std::string &)> charClassCheck;
+};
+
+const std::vector<FieldCheck> &fieldChecks() {
+  using namespace entities;
+  static const boost::regex hex{ENC_PERMANENT_KEY_PATTERN};
+  static const boost::regex amf{AUTHENTICATION_MANAGEMENT_FIELD_PATTERN};
+  static const boost::regex a4KeyV{A4_KEY_V_PATTERN};
+  static const boost::regex akaAlgorithmInd{AKA_ALGORITHM_IND_PATTERN};
+  static const std::vector<FieldCheck> checks = {
+      {"encPermanentKey", "0123456789abcdefABCDEF0123456789",
+       [](const std::string &v) { return regexMatches(hex, v); },
+       [](const std::string &v) { return charclass::isHex(v); }},
+      {"authenticationManagementField", "0aF9",
+       [](const std::string &v) { return regexMatches(amf, v); },
+       [](const std::string &v) {
+         return charclass::isHex(v, AUTHENTICATION_MANAGEMENT_FIELD_LENGTH);
+       }},
+      {"algorithmId", "12",
+       [](const std::string &v) {
+         return regexInRange(v, MIN_ALGORITHM_ID, MAX_ALGORITHM_ID);
+       },
+       [](const std::string &v) {
+         return charclass::toBoundedInt(v, MIN_ALGORITHM_ID, MAX_ALGORITHM_ID)
+             .has_value();
+       }},
+      {"a4KeyInd", "511",
+       [](const std::string &v) {
+         return regexInRange(v, A4_KEY_IND_MIN, A4_KEY_IND_MAX);
+       },
+       [](const std::string &v) {
+         return charclass::toBoundedInt(v, A4_KEY_IND_MIN, A4_KEY_IND_MAX)
+             .has_value();
+       }},
+      {"a4Ind", "2",
+       [](const std::string &v) {
+         return regexInRange(v, A4_IND_MIN, A4_IND_MAX);
+       },
+       [](const std::string &v) {
+         return charclass::toBoundedInt(v, A4_IND_MIN, A4_IND_MAX).has_value();
+       }},
+      {"a4KeyV", "27",
+       [](const std::string &v) { return regexMatches(a4KeyV, v); },
+       [](const std::string &v) {
+         return charclass::toCanonicalInt(v, A4_KEY_V_MIN, A4_KEY_V_MAX)
+             .has_value();
+       }},
+      {"akaAlgorithmInd", "1",
+       [](const std::string &v) { return regexMatches(akaAlgorithmInd, v); },
+       [](const std::string &v) {
+         return charclass::toCanonicalInt(v, AKA_ALGORITHM_IND_MIN,
+                                          AKA_ALGORITHM_IND_MAX)
+             .has_value();
+       }},
+  };
+  return checks;
+}
+
+// The field of the argument, labelled with its name. Its value must pass the
+// check, or the figures would be those of an early rejection
+template <typename Check>
+void benchmarkFieldCheck(benchmark::State &state, Check check) {
+  const auto &field = fieldChecks()[state.range(0)];
+  state.SetLabel(field.field);
+  if (not check(field)) {
+    state.SkipWithError("Field value rejected");
+    return;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(check(field));
+  }
+}
+
+void BM_FieldCheckRegex(benchmark::State &state) {
+  benchmarkFieldCheck(state, [](const FieldCheck &field) {
+    return field.regexCheck(field.value);
+  });
+}
+
+void BM_FieldCheckCharClass(benchmark::State &state) {
+  benchmarkFieldCheck(state, [](const FieldCheck &field) {
+    return field.charClassCheck(field.value);
+  });
+}
+
+void fieldIndexes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgName("field")->DenseRange(
+      0, static_cast<int>(fieldChecks().size()) - 1);
+}
+
+// As many legacy subscriptions as the argument, looked up one after the
+// other by IMSI as the rules do it. A lookup must find its resource, or the
+// figures would be those of a miss
+template <typename Insert, typename Find>
+void benchmarkLegacyLookup(benchmark::State &state, Insert insert,
+                           Find find) {
+  std::vector<std::string> imsis;
+  for (long i = 0; i < state.range(0); ++i) {
+    imsis.push_back(imsiOf(2, static_cast<std::size_t>(i) * 7919));
+    entities::auth_subscription_legacy_t legacy;
+    legacy.akaType = 1;
+    insert(std::string{entities::LEGACY_BASE_PATH}.append(imsis.back()),
+           legacy);
+  }
+  if (not find(imsis.front())) {
+    state.SkipWithError("Legacy subscription not found");
+    return;
+  }
+  std::size_t n = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(find(imsis[n++ % imsis.size()]));
+  }
+}
+
+// The related resources as they were held before the path index: the path
+// is built, then looked up by count() and at()
+void BM_LegacyLookupMap(benchmark::State &state) {
+  using former_resource_t =
+      boost::variant<entities::auth_subscription_t, entities::prov_journal_t,
+                     entities::auth_subscription_legacy_t,
+                     entities::prov_journal_view_t>;
+  std::map<std::string, former_resource_t> former;
+  benchmarkLegacyLookup(
+      state,
+      [&former](std::string path,
+                const entities::auth_subscription_legacy_t &legacy) {
+        former.insert({std::move(path), legacy});
+      },
+      [&former](const std::string &imsi) {
+        auto path = std::string{entities::LEGACY_BASE_PATH}.append(imsi);
+        if (not former.count(path)) {
+          return false;
+        }
+        return boost::get<entities::auth_subscription_legacy_t>(
+                   former.at(path))
+            .akaType.has_value();
+      });
+}
+
+void BM_LegacyLookupPathIndex(benchmark::State &state) {
+  entities::related_resources_t index;
+  benchmarkLegacyLookup(
+      state,
+      [&index](std::string path,
+               const entities::auth_subscription_legacy_t &legacy) {
+        index.insert({std::move(path), legacy});
+      },
+      [&index](const std::string &imsi) {
+        auto legacy = index.findAs<entities::auth_subscription_legacy_t>(
+            entities::LEGACY_BASE_PATH, imsi);
+        return legacy and legacy->akaType.has_value();
+      });
+}
+
+void legacyResources(benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgName("resources")->Arg(1)->Arg(10)->Arg(100)->Arg(500);
+}
+
+void corpusShapes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgNames({"changes", "related"})
+      ->ArgsProduct({{1, 16, 256}, {0, 256}});
+}
+
+}  // namespace
+
+BENCHMARK(BM_OpenApiValidate)->Apply(corpusShapes);
+BENCHMARK(BM_ParseDom)->Apply(corpusShapes);
+BENCHMARK(BM_ParseSax)->Apply(corpusShapes);
+BENCHMARK(BM_ApplyValidationRules)->Apply(corpusShapes);
+BENCHMARK(BM_EncodeResponse)->Apply(corpusShapes);
+BENCHMARK(BM_AnonymizeJson)->Apply(corpusShapes);
+BENCHMARK(BM_EndToEnd)->Apply(corpusShapes);
+
+BENCHMARK(BM_MutexQueue)->Apply(queueThreads);
+BENCHMARK(BM_BlockingMpmcQueue)->Apply(queueThreads);
+BENCHMARK(BM_FieldCheckRegex)->Apply(fieldIndexes);
+BENCHMARK(BM_FieldCheckCharClass)->Apply(fieldIndexes);
+BENCHMARK(BM_LegacyLookupMap)->Apply(legacyResources);
+BENCHMARK(BM_LegacyLookupPathIndex)->Apply(legacyResources);
+
+BENCHMARK_MAIN();
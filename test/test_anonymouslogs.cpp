@@ -1,7 +1,13 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
 
 #include "gtest/gtest.h"
+#include "ports/logs/logcontrol.hpp"
 #include "ports/logs/logwrapper.hpp"
 
 TEST(ImsiAnonPositiveTest, StringAnonimizationTests) {
@@ -33,4 +39,96 @@ TEST(ImsiInUrlAnonPositiveTest, StringAnonimizationTests) {
   std::string imsi_may = "/this/is/a/IMSI=123456789012345";
   std::string anon_imsi_may = ::anonlog::anonymizeJson(imsi_may);
   ASSERT_STREQ("/this/is/a/IMSI=*2*4*6*8*0*2*4*", anon_imsi_may.c_str());
-}
\ No newline at end of file
+}
+TEST(ImsiInBodyAnonPositiveTest, StringAnonimizationTests) {
+  /* All the styles in one body, as logged for requests and responses */
+  std::string body =
+      "{\"resource_path\":\"/subscribers/a/authSubscription/"
+      "imsi-123456789012345\",\"imsi\": \"12345\",\"uri\":\"IMSI = "
+      "123456\",\"IMSI\":\"1234567890123456\",\"other\":\"imsi-1234\"}";
+  std::string anon_body = ::anonlog::anonymizeJson(body);
+  ASSERT_STREQ(
+      "{\"resource_path\":\"/subscribers/a/authSubscription/"
+      "imsi-*2*4*6*8*0*2*4*\",\"imsi\":\"*2*4*\",\"uri\":\"IMSI =*1*3*5*\","
+      "\"IMSI\":\"1234567890123456\",\"other\":\"imsi-1234\"}",
+      anon_body.c_str());
+  ASSERT_STREQ(
+      "{\"resource_path\":\"/subscribers/a/authSubscription/"
+      "imsi-*2*4*6*8*0*2*4*\",\"imsi\": \"12345\",\"uri\":\"IMSI = "
+      "123456\",\"IMSI\":\"1234567890123456\",\"other\":\"imsi-1234\"}",
+      ::anonlog::anonymizeString(body).c_str());
+}
+
+TEST(LogControlTest, DebugSeverityOfTheContainer) {
+  constexpr auto container = "eric-udm-authprovvalidator";
+  EXPECT_TRUE(::anonlog::isDebugSeverity(
+      "[\n  { \"container\": \"eric-udm-authprovvalidator\", "
+      "\"severity\": \"debug\" }\n]",
+      container));
+  // Only the members of the entry itself count
+  EXPECT_TRUE(::anonlog::isDebugSeverity(
+      "[{\"container\":\"eric-udm-authprovvalidator\",\"filter\":{"
+      "\"severity\":\"info\"},\"severity\":\"debug\"}]",
+      container));
+  EXPECT_TRUE(::anonlog::isDebugSeverity(
+      "[{\"container\":\"other\",\"severity\":\"info\"},"
+      "{\"severity\":\"debug\",\"container\":"
+      "\"eric-udm-authprovvalidator\"}]",
+      container));
+  EXPECT_FALSE(::anonlog::isDebugSeverity(
+      "[{\"container\":\"eric-udm-authprovvalidator\",\"severity\":"
+      "\"info\"}]",
+      container));
+  EXPECT_FALSE(::anonlog::isDebugSeverity(
+      "[{\"container\":\"other\",\"severity\":\"debug\"}]", container));
+  EXPECT_FALSE(::anonlog::isDebugSeverity("[\n]", container));
+  EXPECT_FALSE(::anonlog::isDebugSeverity("", container));
+  EXPECT_FALSE(::anonlog::isDebugSeverity(
+      "[\n{ container: eric-udm-authprovvalidator, severity: debug }\n]",
+      container));
+  EXPECT_FALSE(::anonlog::isDebugSeverity(
+      "{\"container\":\"eric-udm-authprovvalidator\",\"severity\":"
+      "\"debug\"}",
+      container));
+}
+
+TEST(LogControlTest, DebugIsReadFromTheWatchedFile) {
+  std::string path = ::testing::TempDir() + "logControl.json";
+  {
+    std::ofstream file(path);
+    file << "[ { \"container\": \"validator\", \"severity\": \"debug\" } ]";
+  }
+  ::anonlog::watchLogControl(path, "validator");
+  EXPECT_TRUE(::anonlog::isDebugEnabled());
+  {
+    std::ofstream file(path);
+    file << "[ ]";
+  }
+  ::anonlog::watchLogControl(path, "validator");
+  EXPECT_FALSE(::anonlog::isDebugEnabled());
+  std::remove(path.c_str());
+  ::anonlog::watchLogControl(path, "validator");
+  EXPECT_FALSE(::anonlog::isDebugEnabled());
+}
+
+TEST(LogControlTest, ChangesOfTheWatchedFileAreReadInTheBackground) {
+  std::string path = ::testing::TempDir() + "logControlRefresh.json";
+  {
+    std::ofstream file(path);
+    file << "[ { \"container\": \"validator\", \"severity\": \"debug\" } ]";
+  }
+  ::anonlog::watchLogControl(path, "validator");
+  EXPECT_TRUE(::anonlog::isDebugEnabled());
+  {
+    std::ofstream file(path);
+    file << "[ ]";
+  }
+  auto deadline =
+      std::chrono::steady_clock::now() + 3 * ::anonlog::LOG_CONTROL_REFRESH;
+  while (::anonlog::isDebugEnabled() and
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_FALSE(::anonlog::isDebugEnabled());
+  std::remove(path.c_str());
+}
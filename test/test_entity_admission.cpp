@@ -0,0 +1,143 @@
+#include <chrono>
+
+#include "entities/AdmissionController.hpp"
+#include "gtest/gtest.h"
+
+using ::entities::AdmissionController;
+using ::entities::AdmissionSettings;
+using namespace std::chrono_literals;
+
+namespace {
+
+const AdmissionSettings SETTINGS{5ms, 100ms, 200ms};
+
+}  // namespace
+
+TEST(EntityAdmission, ShedsOnceTheQueueStaysAboveTargetForAnInterval) {
+  AdmissionController admission(SETTINGS);
+  AdmissionController::clock_t::time_point now{};
+  now += 1s;
+
+  EXPECT_FALSE(admission.onDequeue(10ms, now));
+  EXPECT_FALSE(admission.onDequeue(10ms, now + 50ms));
+  EXPECT_FALSE(admission.state().dropping);
+  EXPECT_TRUE(admission.onDequeue(10ms, now + 100ms));
+  EXPECT_TRUE(admission.state().dropping);
+  EXPECT_EQ(admission.state().shed, 1);
+}
+
+TEST(EntityAdmission, ShortBurstsAreNotShed) {
+  AdmissionController admission(SETTINGS);
+  AdmissionController::clock_t::time_point now{};
+  now += 1s;
+
+  EXPECT_FALSE(admission.onDequeue(10ms, now));
+  EXPECT_FALSE(admission.onDequeue(1ms, now + 50ms));
+  EXPECT_FALSE(admission.onDequeue(10ms, now + 100ms));
+  EXPECT_FALSE(admission.onDequeue(10ms, now + 150ms));
+  EXPECT_EQ(admission.state().shed, 0);
+}
+
+TEST(EntityAdmission, ShedsAtShrinkingIntervalsUntilTheQueueDrains) {
+  AdmissionController admission(SETTINGS);
+  AdmissionController::clock_t::time_point now{};
+  now += 1s;
+  admission.onDequeue(10ms, now);
+  now += 100ms;
+  EXPECT_TRUE(admission.onDequeue(10ms, now));
+
+  // Next shed an interval later, then interval / sqrt(2) after it
+  EXPECT_FALSE(admission.onDequeue(10ms, now + 99ms));
+  EXPECT_TRUE(admission.onDequeue(10ms, now + 100ms));
+  EXPECT_FALSE(admission.onDequeue(10ms, now + 170ms));
+  EXPECT_TRUE(admission.onDequeue(10ms, now + 171ms));
+
+  EXPECT_FALSE(admission.onDequeue(1ms, now + 400ms));
+  EXPECT_FALSE(admission.state().dropping);
+  EXPECT_EQ(admission.state().shed, 3);
+}
+
+TEST(EntityAdmission, RejectsWhileSheddingOrOverTheLatencyObjective) {
+  AdmissionController admission(SETTINGS);
+  EXPECT_TRUE(admission.admit(1000, 2));
+
+  // 10ms per request over 2 threads: 200ms reached from 40 pending on
+  admission.onComplete(10ms);
+  EXPECT_TRUE(admission.admit(38, 2));
+  EXPECT_FALSE(admission.admit(40, 2));
+
+  AdmissionController::clock_t::time_point now{};
+  now += 1s;
+  admission.onDequeue(10ms, now);
+  admission.onDequeue(10ms, now + 100ms);
+  EXPECT_FALSE(admission.admit(1, 2));
+
+  auto state = admission.state();
+  EXPECT_EQ(state.admitted, 2);
+  EXPECT_EQ(state.rejected, 2);
+  EXPECT_EQ(state.queueDelay, 10ms);
+  EXPECT_EQ(state.serviceTime, 10ms);
+}
+
+TEST(EntityAdmission, AnEmptyQueueEndsTheShedding) {
+  AdmissionController admission(SETTINGS);
+  AdmissionController::clock_t::time_point now{};
+  now += 1s;
+  admission.onDequeue(10ms, now);
+  EXPECT_TRUE(admission.onDequeue(10ms, now + 100ms));
+  EXPECT_TRUE(admission.state().dropping);
+
+  // The standing queue drained with no task under target
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(admission.admit(0, 2));
+  }
+  EXPECT_FALSE(admission.state().dropping);
+  EXPECT_TRUE(admission.admit(1, 2));
+  // Delays above target start a new interval before anything is shed
+  EXPECT_FALSE(admission.onDequeue(10ms, now + 200ms));
+}
+
+TEST(EntityAdmission, ASlowTaskDoesNotLockTheQueueOut) {
+  AdmissionController admission(SETTINGS);
+  admission.onComplete(2s);
+  EXPECT_FALSE(admission.admit(1, 2));
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(admission.admit(0, 2));
+  }
+  // Requests of the usual cost bring the average back down
+  for (int i = 0; i < 100; ++i) {
+    admission.onComplete(1ms);
+  }
+  EXPECT_TRUE(admission.admit(10, 2));
+}
+
+TEST(EntityAdmission, TasksOfManyChangesArePredictedByTheirOwnTime) {
+  AdmissionController admission(SETTINGS);
+  // Batches of 1000 changes taking 100ms each: two queued per thread
+  // exceed the objective, however cheap each of their changes is
+  for (int i = 0; i < 10; ++i) {
+    admission.onComplete(100ms);
+  }
+  EXPECT_EQ(admission.state().serviceTime, 100ms);
+  EXPECT_TRUE(admission.admit(2, 2));
+  EXPECT_FALSE(admission.admit(4, 2));
+  EXPECT_EQ(admission.retryAfter(40, 2), 3s);
+  EXPECT_EQ(admission.retryAfter(400, 2), 21s);
+}
+
+TEST(EntityAdmission, ServiceTimeIsAMovingAverage) {
+  AdmissionController admission(SETTINGS);
+  admission.onComplete(8ms);
+  EXPECT_EQ(admission.state().serviceTime, 8ms);
+  admission.onComplete(16ms);
+  EXPECT_EQ(admission.state().serviceTime, 9ms);
+}
+
+TEST(EntityAdmission, RetryAfterIsTheTimeTheQueueTakesToDrain) {
+  AdmissionController admission(SETTINGS);
+  EXPECT_EQ(admission.retryAfter(0, 2), 1s);
+
+  admission.onComplete(100ms);
+  EXPECT_EQ(admission.retryAfter(10, 2), 1s);
+  EXPECT_EQ(admission.retryAfter(40, 2), 3s);
+}
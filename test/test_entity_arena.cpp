@@ -0,0 +1,41 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "entities/RequestArena.hpp"
+#include "gtest/gtest.h"
+
+TEST(EntityArena, AllocationsAreServedInline) {
+  ::entities::RequestArena arena;
+  auto p1 = arena.allocate(100);
+  auto p2 = arena.allocate(200);
+  EXPECT_TRUE(arena.isInline(p1));
+  EXPECT_TRUE(arena.isInline(p2));
+  EXPECT_NE(p1, p2);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p2) % alignof(std::max_align_t),
+            0);
+}
+
+TEST(EntityArena, GrowsBeyondInitialSize) {
+  ::entities::RequestArena arena;
+  arena.allocate(::entities::RequestArena::INITIAL_SIZE / 2);
+  auto big = arena.allocate(::entities::RequestArena::INITIAL_SIZE);
+  EXPECT_NE(big, nullptr);
+  EXPECT_FALSE(arena.isInline(big));
+}
+
+TEST(EntityArena, ReleaseReusesInitialBuffer) {
+  ::entities::RequestArena arena;
+  auto first = arena.allocate(64);
+  arena.allocate(::entities::RequestArena::INITIAL_SIZE);
+  arena.release();
+  EXPECT_EQ(arena.allocate(64), first);
+}
+
+TEST(EntityArena, PmrContainersUseArena) {
+  ::entities::RequestArena arena;
+  std::pmr::vector<std::pmr::string> v(arena.resource());
+  v.emplace_back("a string long enough to skip the small string buffer");
+  EXPECT_TRUE(arena.isInline(v.data()));
+  EXPECT_TRUE(arena.isInline(v[0].data()));
+}
@@ -0,0 +1,209 @@
+#include <boost/regex.hpp>
+#include <string>
+#include <vector>
+
+#include "entities/CharClass.hpp"
+#include "entities/ValidationData.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Static data field values around the corner cases of the field patterns
+const std::vector<std::string> FIELD_VALUES = {
+    "",
+    "0",
+    "1",
+    "2",
+    "3",
+    "9",
+    "00",
+    "01",
+    "05",
+    "09",
+    "10",
+    "15",
+    "16",
+    "19",
+    "20",
+    "29",
+    "30",
+    "31",
+    "32",
+    "39",
+    "40",
+    "99",
+    "100",
+    "510",
+    "511",
+    "512",
+    "0511",
+    "000000000000000000000000000000000000002",
+    "2147483647",
+    "2147483648",
+    "99999999999999999999",
+    "-1",
+    "+1",
+    " 1",
+    "1 ",
+    "1a",
+    "a",
+    "A",
+    "f",
+    "F",
+    "g",
+    "G",
+    "@",
+    "`",
+    "/",
+    ":",
+    "AAAA",
+    "aaaa",
+    "0aF9",
+    "AAA",
+    "AAAAA",
+    "AAAG",
+    "5G_AKA",
+    "1A1A1A1A1A1A1A1A",
+    "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA",
+    "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA",
+    "0123456789abcdefABCDEF0123456789abcdefABCDEF0123456789abcdefABCD",
+    "0123456789abcdefABCDEF0123456789abcdefABCDEF0123456789abcdefABCg",
+    "12345678901234567890123456789012345678901234567890",
+    "\xc3\xa9",
+    "\x80",
+    "\xff",
+    "A\nA",
+};
+
+bool regexMatch(const char *pattern, const std::string &value) {
+  boost::cmatch cm;
+  return boost::regex_match(value.c_str(), cm, boost::regex{pattern});
+}
+
+// Former check of the integer fields: the pattern, then std::stoi in range
+bool regexInRange(const char *pattern, const std::string &value, int min,
+                  int max) {
+  if (not regexMatch(pattern, value)) {
+    return false;
+  }
+  try {
+    auto number = std::stoi(value);
+    return number >= min and number <= max;
+  } catch (...) {
+    return false;
+  }
+}
+
+// Hex strings of the lengths around the vector widths, with one byte out of
+// the class at each position, so every lane and the tail are checked
+std::vector<std::string> corruptedHexValues() {
+  std::vector<std::string> values;
+  for (std::size_t length : {15, 16, 17, 31, 32, 33, 47, 48, 64, 65}) {
+    std::string hex;
+    for (std::size_t i = 0; i < length; ++i) {
+      hex.push_back("0123456789abcdefABCDEF"[i % 22]);
+    }
+    values.push_back(hex);
+    for (std::size_t pos = 0; pos < length; ++pos) {
+      for (char bad : {'g', 'G', '@', '`', '/', ':', '\x80', '\xe6'}) {
+        auto value = hex;
+        value[pos] = bad;
+        values.push_back(value);
+      }
+    }
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(CharClassTest, HexIsEquivalentToPatterns) {
+  auto values = FIELD_VALUES;
+  auto corrupted = corruptedHexValues();
+  values.insert(values.end(), corrupted.begin(), corrupted.end());
+  for (const auto &value : values) {
+    EXPECT_EQ(entities::charclass::isHex(value),
+              regexMatch(entities::ENC_PERMANENT_KEY_PATTERN, value))
+        << value;
+    EXPECT_EQ(entities::charclass::isHex(value),
+              regexMatch(entities::ENC_OPC_KEY_PATTERN, value))
+        << value;
+    EXPECT_EQ(entities::charclass::isHex(
+                  value, entities::AUTHENTICATION_MANAGEMENT_FIELD_LENGTH),
+              regexMatch(entities::AUTHENTICATION_MANAGEMENT_FIELD_PATTERN,
+                         value))
+        << value;
+  }
+}
+
+TEST(CharClassTest, DigitsAreEquivalentToPatterns) {
+  for (const auto &value : FIELD_VALUES) {
+    EXPECT_EQ(not value.empty() and entities::charclass::isDigits(value),
+              regexMatch(entities::ALGORITHM_ID_PATTERN, value))
+        << value;
+  }
+  std::string digits(100, '7');
+  EXPECT_TRUE(entities::charclass::isDigits(digits));
+  for (std::size_t pos = 0; pos < digits.size(); ++pos) {
+    auto value = digits;
+    value[pos] = 'a';
+    EXPECT_FALSE(entities::charclass::isDigits(value)) << value;
+  }
+}
+
+TEST(CharClassTest, BoundedIntsAreEquivalentToPatternsAndStoi) {
+  for (const auto &value : FIELD_VALUES) {
+    EXPECT_EQ(entities::charclass::toBoundedInt(
+                  value, entities::MIN_ALGORITHM_ID, entities::MAX_ALGORITHM_ID)
+                  .has_value(),
+              regexInRange(entities::ALGORITHM_ID_PATTERN, value,
+                           entities::MIN_ALGORITHM_ID,
+                           entities::MAX_ALGORITHM_ID))
+        << value;
+    EXPECT_EQ(entities::charclass::toBoundedInt(value, entities::A4_KEY_IND_MIN,
+                                                entities::A4_KEY_IND_MAX)
+                  .has_value(),
+              regexInRange(entities::A4_KEY_IND_PATTERN, value,
+                           entities::A4_KEY_IND_MIN, entities::A4_KEY_IND_MAX))
+        << value;
+    EXPECT_EQ(entities::charclass::toBoundedInt(value, entities::A4_IND_MIN,
+                                                entities::A4_IND_MAX)
+                  .has_value(),
+              regexInRange(entities::A4_IND_PATTERN, value,
+                           entities::A4_IND_MIN, entities::A4_IND_MAX))
+        << value;
+    EXPECT_EQ(entities::charclass::toCanonicalInt(value, entities::A4_KEY_V_MIN,
+                                                  entities::A4_KEY_V_MAX)
+                  .has_value(),
+              regexMatch(entities::A4_KEY_V_PATTERN, value))
+        << value;
+    EXPECT_EQ(entities::charclass::toCanonicalInt(
+                  value, entities::AKA_ALGORITHM_IND_MIN,
+                  entities::AKA_ALGORITHM_IND_MAX)
+                  .has_value(),
+              regexMatch(entities::AKA_ALGORITHM_IND_PATTERN, value))
+        << value;
+  }
+}
+
+TEST(CharClassTest, BoundedIntValues) {
+  EXPECT_EQ(entities::charclass::toBoundedInt("0", 0, 15), 0);
+  EXPECT_EQ(entities::charclass::toBoundedInt("15", 0, 15), 15);
+  EXPECT_EQ(entities::charclass::toBoundedInt("0007", 0, 15), 7);
+  EXPECT_EQ(entities::charclass::toBoundedInt("2147483647", 0, 2147483647),
+            2147483647);
+  EXPECT_FALSE(entities::charclass::toBoundedInt("2147483648", 0, 2147483647));
+  EXPECT_FALSE(entities::charclass::toBoundedInt("4", 5, 15));
+  EXPECT_EQ(entities::charclass::toCanonicalInt("0", 0, 31), 0);
+  EXPECT_EQ(entities::charclass::toCanonicalInt("31", 0, 31), 31);
+  EXPECT_FALSE(entities::charclass::toCanonicalInt("031", 0, 31));
+}
+
+TEST(CharClassTest, NullBytesAreNotInAnyClass) {
+  // The former patterns were matched on c_str(), which ended the value at
+  // its first null byte
+  std::string value{"AAAA\0AAAA", 9};
+  EXPECT_FALSE(entities::charclass::isHex(value));
+  EXPECT_FALSE(entities::charclass::isDigits(std::string{"1\0", 2}));
+  EXPECT_FALSE(entities::charclass::toBoundedInt(std::string{"1\0", 2}, 0, 9));
+}
@@ -0,0 +1,51 @@
+#include <cctype>
+#include <string>
+
+#include "entities/Context.hpp"
+#include "gtest/gtest.h"
+
+using ::entities::Context;
+using ::entities::TracingKey;
+
+TEST(EntityContext, EveryTracingKeyIsMatchedWhateverItsCase) {
+  for (std::size_t i = 0; i < ::entities::TRACING_KEYS.size(); ++i) {
+    std::string key{::entities::TRACING_KEYS[i]};
+    EXPECT_EQ(::entities::tracingKeyOf(key), static_cast<TracingKey>(i));
+    for (auto &c : key) {
+      c = static_cast<char>(std::toupper(c));
+    }
+    EXPECT_EQ(::entities::tracingKeyOf(key), static_cast<TracingKey>(i));
+  }
+}
+
+TEST(EntityContext, OtherHeadersAreNotMatched) {
+  for (auto name : {"", "x", "content-type", "x-b3-traceid ", "x-b3-traceie",
+                    "x-b3-spanid\n", "y-request-id", "x-b3-parentspanie",
+                    "x-b3_flags", "x-ot-span-contexts", "x-b3-sampleD!"}) {
+    EXPECT_FALSE(::entities::tracingKeyOf(name)) << name;
+  }
+}
+
+TEST(EntityContext, OnlyTracingHeadersAreKept) {
+  Context context;
+  context.copyTracingHeaders({{"X-Request-Id", "abc"},
+                              {"x-b3-flags", "1"},
+                              {"content-type", "application/json"}});
+  const auto &headers = context.getTracingHeaders();
+  EXPECT_EQ(headers.size(), 2);
+  EXPECT_EQ(headers.find("X-Request-Id")->second, "abc");
+  EXPECT_EQ(headers.find("x-b3-flags")->second, "1");
+}
+
+TEST(EntityContext, EveryHeaderIsHandedOverInTheSamePass) {
+  Context context;
+  Context::contextdata_t all;
+  context.copyTracingHeaders(
+      Context::contextdata_t{{"x-b3-traceid", "463ac35c9f6413ad"},
+                             {"content-type", "application/json"}},
+      [&all](const auto &key, const auto &value) { all.emplace(key, value); });
+  EXPECT_EQ(all.size(), 2);
+  EXPECT_EQ(context.getTracingHeaders().size(), 1);
+  ASSERT_TRUE(context.getSpanContext());
+  EXPECT_EQ(context.getSpanContext()->traceIdLow, 0x463ac35c9f6413adull);
+}
@@ -0,0 +1,178 @@
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "entities/ErrorText.hpp"
+#include "entities/Metrics.hpp"
+#include "entities/StageTimer.hpp"
+#include "gtest/gtest.h"
+
+using ::entities::LatencyHistogram;
+using ::entities::Metrics;
+using ::entities::Stage;
+
+namespace {
+
+std::size_t stageIndex(Stage stage) { return static_cast<std::size_t>(stage); }
+
+std::size_t outcomeIndex(std::uint32_t status) {
+  for (std::size_t i = 0; i < ::entities::OUTCOME_CODES.size(); ++i) {
+    if (::entities::OUTCOME_CODES[i] == status) {
+      return i;
+    }
+  }
+  return ::entities::OUTCOME_CODES.size();
+}
+
+}  // namespace
+
+TEST(EntityMetrics, SmallValuesHaveABucketEach) {
+  for (std::uint64_t nanos = 0; nanos < LatencyHistogram::SUB_BUCKETS;
+       ++nanos) {
+    EXPECT_EQ(LatencyHistogram::bucketOf(nanos), nanos);
+    EXPECT_EQ(LatencyHistogram::lowerBound(nanos), nanos);
+  }
+}
+
+TEST(EntityMetrics, ValuesAreKnownWithinTheirSubBucket) {
+  for (std::uint64_t nanos : {8ull, 9ull, 15ull, 16ull, 17ull, 1000ull,
+                              123456ull, 999999999ull, 1ull << 39}) {
+    auto bucket = LatencyHistogram::bucketOf(nanos);
+    ASSERT_LT(bucket + 1, LatencyHistogram::BUCKETS);
+    auto lower = LatencyHistogram::lowerBound(bucket);
+    auto upper = LatencyHistogram::lowerBound(bucket + 1);
+    EXPECT_LE(lower, nanos);
+    EXPECT_GT(upper, nanos);
+    EXPECT_LE(upper - lower, lower / LatencyHistogram::SUB_BUCKETS + 1);
+  }
+}
+
+TEST(EntityMetrics, BucketsFollowEachOther) {
+  for (std::size_t bucket = 0; bucket + 1 < LatencyHistogram::BUCKETS;
+       ++bucket) {
+    auto lower = LatencyHistogram::lowerBound(bucket);
+    EXPECT_EQ(LatencyHistogram::bucketOf(lower), bucket);
+    EXPECT_EQ(LatencyHistogram::bucketOf(
+                  LatencyHistogram::lowerBound(bucket + 1) - 1),
+              bucket);
+  }
+}
+
+TEST(EntityMetrics, HugeValuesShareTheLastBucket) {
+  EXPECT_EQ(LatencyHistogram::bucketOf(1ull << 40),
+            LatencyHistogram::BUCKETS - 1);
+  EXPECT_EQ(LatencyHistogram::bucketOf(~0ull), LatencyHistogram::BUCKETS - 1);
+}
+
+TEST(EntityMetrics, StagesAndOutcomesAreCounted) {
+  Metrics metrics;
+  metrics.recordStage(Stage::PARSE, std::chrono::microseconds{3});
+  metrics.recordStage(Stage::PARSE, std::chrono::microseconds{5});
+  metrics.recordStage(Stage::RULES, std::chrono::nanoseconds{-1});
+  metrics.recordOutcome(200);
+  metrics.recordOutcome(200);
+  metrics.recordOutcome(422);
+  metrics.recordOutcome(418);
+
+  auto snapshot = metrics.snapshot();
+  const auto &parse = snapshot.stages[stageIndex(Stage::PARSE)];
+  EXPECT_EQ(parse.count, 2);
+  EXPECT_EQ(parse.sumNanos, 8000);
+  EXPECT_EQ(parse.buckets[LatencyHistogram::bucketOf(3000)], 1);
+  EXPECT_EQ(parse.buckets[LatencyHistogram::bucketOf(5000)], 1);
+  EXPECT_EQ(snapshot.stages[stageIndex(Stage::RULES)].buckets[0], 1);
+  EXPECT_EQ(snapshot.stages[stageIndex(Stage::ENCODE)].count, 0);
+  EXPECT_EQ(snapshot.outcomes[outcomeIndex(200)], 2);
+  EXPECT_EQ(snapshot.outcomes[outcomeIndex(422)], 1);
+  EXPECT_EQ(snapshot.outcomes[outcomeIndex(418)], 1);
+  EXPECT_EQ(snapshot.outcomes[outcomeIndex(500)], 0);
+}
+
+TEST(EntityMetrics, ShardsOfEveryThreadAreMerged) {
+  Metrics metrics;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&metrics]() {
+      for (int i = 0; i < 1000; ++i) {
+        metrics.recordOutcome(409);
+        metrics.recordStage(Stage::ENCODE, std::chrono::nanoseconds{100});
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto snapshot = metrics.snapshot();
+  EXPECT_EQ(snapshot.outcomes[outcomeIndex(409)], 8000);
+  EXPECT_EQ(snapshot.stages[stageIndex(Stage::ENCODE)].count, 8000);
+  EXPECT_EQ(snapshot.stages[stageIndex(Stage::ENCODE)].sumNanos, 800000);
+}
+
+TEST(EntityMetrics, MetricsDoNotShareShards) {
+  auto first = std::make_unique<Metrics>();
+  first->recordOutcome(200);
+  first.reset();
+  Metrics second;
+  second.recordOutcome(400);
+  auto snapshot = second.snapshot();
+  EXPECT_EQ(snapshot.outcomes[outcomeIndex(200)], 0);
+  EXPECT_EQ(snapshot.outcomes[outcomeIndex(400)], 1);
+}
+
+TEST(EntityMetrics, StageTimerRecordsOnce) {
+  Metrics metrics;
+  {
+    ::entities::StageTimer timer{metrics, Stage::OAI_REQUEST, nullptr,
+                                 std::chrono::milliseconds{1}};
+    timer.stop();
+  }
+  auto snapshot = metrics.snapshot();
+  const auto &stage = snapshot.stages[stageIndex(Stage::OAI_REQUEST)];
+  EXPECT_EQ(stage.count, 1);
+  EXPECT_GE(stage.sumNanos, 1000000);
+}
+
+TEST(EntityMetrics, ViolationsAreCountedByType) {
+  Metrics metrics;
+  ::entities::errors_t errors{
+      ::entities::constraintViolation("/a/1/b", ::entities::INVALID_IMSI),
+      ::entities::constraintViolation("/a/2/b", ::entities::INVALID_IMSI),
+      ::entities::unprocessableEntity(
+          "/a/1/b/c", ::entities::ErrorKind::NO_RELATED_RESOURCE),
+      ::entities::unprocessableEntity(
+          "/a/2/b/c", ::entities::ErrorKind::NO_RELATED_RESOURCE),
+      ::entities::requestError("Malformed request", "not counted")};
+  metrics.recordViolations(errors);
+  std::thread other([&metrics, &errors]() {
+    metrics.recordViolations(errors);
+  });
+  other.join();
+
+  auto snapshot = metrics.snapshot();
+  ASSERT_EQ(snapshot.violations.size(), 2);
+  EXPECT_EQ((snapshot.violations[{::entities::ERROR_CONSTRAINT_VIOLATION,
+                                  ::entities::INVALID_IMSI}]),
+            4);
+  EXPECT_EQ((snapshot.violations[{::entities::ERROR_UNPROCESSABLE_ENTITY,
+                                  "There is no associated relatedResource"}]),
+            4);
+}
+
+TEST(EntityMetrics, ViolationTypesOverTheLimitAreOther) {
+  Metrics metrics;
+  std::vector<std::string> fields;
+  for (std::size_t i = 0; i < Metrics::VIOLATION_TYPES + 2; ++i) {
+    fields.push_back("field" + std::to_string(i));
+  }
+  ::entities::errors_t errors;
+  for (const auto &field : fields) {
+    errors.push_back(::entities::constraintViolation(
+        "/a", ::entities::ErrorKind::NOT_STRING_FIELD, field));
+  }
+  metrics.recordViolations(errors);
+
+  auto snapshot = metrics.snapshot();
+  EXPECT_EQ(snapshot.violations.size(), Metrics::VIOLATION_TYPES + 1);
+  EXPECT_EQ((snapshot.violations[{"", Metrics::OTHER_VIOLATION}]), 2);
+}
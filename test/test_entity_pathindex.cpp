@@ -0,0 +1,105 @@
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include "entities/PathIndex.hpp"
+#include "entities/ValidationData.hpp"
+#include "entities/types.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+using Index = entities::PathIndex<std::variant<int, std::string>>;
+
+std::string imsiOf(std::size_t n) {
+  auto digits = std::to_string(n);
+  return std::string(15 - digits.size(), '0') + digits;
+}
+
+}  // namespace
+
+TEST(PathIndexTest, FindsInsertedPaths) {
+  Index index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.find("/a"), nullptr);
+
+  EXPECT_TRUE(index.insert({"/a", 1}));
+  EXPECT_TRUE(index.insert({"/b", std::string{"two"}}));
+
+  EXPECT_EQ(index.size(), 2);
+  ASSERT_NE(index.find("/a"), nullptr);
+  EXPECT_EQ(std::get<int>(*index.find("/a")), 1);
+  EXPECT_EQ(std::get<std::string>(index.at("/b")), "two");
+  EXPECT_TRUE(index.contains("/b"));
+  EXPECT_FALSE(index.contains("/c"));
+  EXPECT_FALSE(index.contains("/"));
+  EXPECT_FALSE(index.contains("/a/"));
+  EXPECT_THROW(index.at("/c"), std::out_of_range);
+}
+
+TEST(PathIndexTest, KeepsTheFirstValueOfAPath) {
+  Index index;
+  EXPECT_TRUE(index.insert({"/a", 1}));
+  EXPECT_FALSE(index.insert({"/a", 2}));
+
+  EXPECT_EQ(index.size(), 1);
+  EXPECT_EQ(std::get<int>(index.at("/a")), 1);
+}
+
+TEST(PathIndexTest, FindsPathsByTheirParts) {
+  Index index{{"/subscribers/123abc/journal/provJournal", 1},
+              {"/legacy/serv=Auth/IMSI=123456789012345", 2}};
+
+  std::string mscId{"123abc"};
+  auto journal =
+      index.find(entities::PROV_JOURNAL_PATH_PREFIX, mscId,
+                 entities::PROV_JOURNAL_PATH_SUFFIX);
+  ASSERT_NE(journal, nullptr);
+  EXPECT_EQ(std::get<int>(*journal), 1);
+
+  auto legacy = index.find(entities::LEGACY_BASE_PATH,
+                           std::string_view{"123456789012345"});
+  ASSERT_NE(legacy, nullptr);
+  EXPECT_EQ(std::get<int>(*legacy), 2);
+
+  // However the path is split, only the whole of it matches
+  EXPECT_NE(index.find("/legacy/", "serv=Auth/IMSI=", "123456789012345"),
+            nullptr);
+  EXPECT_EQ(index.find(entities::LEGACY_BASE_PATH, "12345678901234"), nullptr);
+  EXPECT_EQ(index.find(entities::LEGACY_BASE_PATH, "1234567890123456"),
+            nullptr);
+}
+
+TEST(PathIndexTest, FindsTheAlternativeAsked) {
+  Index index{{"/a", 1}, {"/b", std::string{"two"}}};
+
+  ASSERT_NE(index.findAs<int>("/a"), nullptr);
+  EXPECT_EQ(*index.findAs<int>("/a"), 1);
+  EXPECT_EQ(index.findAs<std::string>("/a"), nullptr);
+  ASSERT_NE(index.findAs<std::string>("/b"), nullptr);
+  EXPECT_EQ(*index.findAs<std::string>("/b"), "two");
+  EXPECT_EQ(index.findAs<int>("/c"), nullptr);
+}
+
+TEST(PathIndexTest, GrowsAndKeepsInsertionOrder) {
+  Index index;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(index.insert({"/p/" + imsiOf(999 - i), static_cast<int>(i)}));
+  }
+
+  EXPECT_EQ(index.size(), 1000);
+  for (std::size_t i = 0; i < 1000; ++i) {
+    auto value = index.findAs<int>("/p/", imsiOf(999 - i));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, static_cast<int>(i));
+  }
+  int expected = 0;
+  for (const auto &[path, value] : index) {
+    EXPECT_EQ(path, "/p/" + imsiOf(999 - expected));
+    EXPECT_EQ(std::get<int>(value), expected++);
+  }
+
+  index.clear();
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.find("/p/", imsiOf(0)), nullptr);
+}
@@ -1,18 +1,259 @@
-#include "entities/lockqueue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "entities/mpmcqueue.hpp"
 #include "gtest/gtest.h"
 
-TEST(EntityQueue, LockQueueBasicTest) {
+TEST(EntityQueue, MpmcQueueBasicTest) {
+  ::entities::MpmcQueue<int> queue(3);
+  EXPECT_EQ(queue.capacity(), 4);
+  EXPECT_TRUE(queue.emptyApprox());
+
   int i = 0;
-  ::entities::LockQueue<int> queue;
-  EXPECT_EQ(queue.empty(), true);
+  EXPECT_FALSE(queue.tryPop(i));
+  for (int n = 1; n <= 4; ++n) {
+    EXPECT_TRUE(queue.tryPush(std::move(n)));
+  }
+  int extra = 5;
+  EXPECT_FALSE(queue.tryPush(std::move(extra)));
+  EXPECT_EQ(queue.sizeApprox(), 4);
 
-  queue.push(1);
-  EXPECT_EQ(queue.empty(), false);
-  i = queue.front();
-  EXPECT_EQ(i, 1);
-  EXPECT_EQ(queue.empty(), false);
+  for (int n = 1; n <= 4; ++n) {
+    EXPECT_TRUE(queue.tryPop(i));
+    EXPECT_EQ(i, n);
+  }
+  EXPECT_FALSE(queue.tryPop(i));
+  EXPECT_TRUE(queue.emptyApprox());
+}
+
+TEST(EntityQueue, MpmcQueueMoveOnlyElements) {
+  ::entities::MpmcQueue<std::unique_ptr<int>> queue(2);
+  auto item = std::make_unique<int>(7);
+  EXPECT_TRUE(queue.tryPush(std::move(item)));
+  EXPECT_EQ(item, nullptr);
+
+  auto rejected = std::make_unique<int>(8);
+  EXPECT_TRUE(queue.tryPush(std::make_unique<int>(9)));
+  EXPECT_FALSE(queue.tryPush(std::move(rejected)));
+  ASSERT_NE(rejected, nullptr);
+  EXPECT_EQ(*rejected, 8);
+
+  std::unique_ptr<int> popped;
+  EXPECT_TRUE(queue.tryPop(popped));
+  ASSERT_NE(popped, nullptr);
+  EXPECT_EQ(*popped, 7);
+}
+
+TEST(EntityQueue, MpmcQueueDestroysPendingElements) {
+  auto counter = std::make_shared<int>(0);
+  {
+    ::entities::MpmcQueue<std::shared_ptr<int>> queue(4);
+    EXPECT_TRUE(queue.tryPush(std::shared_ptr<int>(counter)));
+    EXPECT_TRUE(queue.tryPush(std::shared_ptr<int>(counter)));
+    std::shared_ptr<int> popped;
+    EXPECT_TRUE(queue.tryPop(popped));
+    EXPECT_EQ(counter.use_count(), 3);
+  }
+  EXPECT_EQ(counter.use_count(), 1);
+}
 
-  i = queue.pop();
-  EXPECT_EQ(queue.empty(), true);
+TEST(EntityQueue, MpmcQueuePopBulk) {
+  ::entities::MpmcQueue<int> queue(8);
+  for (int n = 0; n < 6; ++n) {
+    EXPECT_TRUE(queue.tryPush(std::move(n)));
+  }
+  std::vector<int> out;
+  EXPECT_EQ(queue.popBulk(std::back_inserter(out), 4), 4);
+  EXPECT_EQ(out, (std::vector<int>{0, 1, 2, 3}));
+  EXPECT_EQ(queue.popBulk(std::back_inserter(out), 4), 2);
+  EXPECT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+  EXPECT_EQ(queue.popBulk(std::back_inserter(out), 4), 0);
+
+  // Wraps around the ring
+  for (int n = 6; n < 14; ++n) {
+    EXPECT_TRUE(queue.tryPush(std::move(n)));
+  }
+  out.clear();
+  EXPECT_EQ(queue.popBulk(std::back_inserter(out), 16), 8);
+  EXPECT_EQ(out.front(), 6);
+  EXPECT_EQ(out.back(), 13);
+}
+
+TEST(EntityQueue, BlockingMpmcQueueClosedIsDrained) {
+  ::entities::BlockingMpmcQueue<int> queue(4);
+  EXPECT_TRUE(queue.tryPush(1));
+  queue.close();
+  EXPECT_TRUE(queue.isClosed());
+  EXPECT_FALSE(queue.tryPush(2));
+  EXPECT_FALSE(queue.push(3));
+
+  int i = 0;
+  EXPECT_TRUE(queue.pop(i));
   EXPECT_EQ(i, 1);
-}
\ No newline at end of file
+  EXPECT_FALSE(queue.pop(i));
+}
+
+TEST(EntityQueue, BlockingMpmcQueuePopForTimesOut) {
+  ::entities::BlockingMpmcQueue<int> queue(2);
+  int i = 0;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(queue.popFor(i, std::chrono::milliseconds(20)));
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+
+  std::thread producer([&queue]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    queue.push(4);
+  });
+  EXPECT_TRUE(queue.popFor(i, std::chrono::seconds(10)));
+  EXPECT_EQ(i, 4);
+  producer.join();
+}
+
+TEST(EntityQueue, BlockingMpmcQueueCloseWakesUpParkedThreads) {
+  ::entities::BlockingMpmcQueue<int> empty(2);
+  ::entities::BlockingMpmcQueue<int> full(2);
+  EXPECT_TRUE(full.tryPush(1));
+  EXPECT_TRUE(full.tryPush(2));
+
+  std::atomic<int> woken{0};
+  std::thread consumer([&empty, &woken]() {
+    int i = 0;
+    EXPECT_FALSE(empty.pop(i));
+    ++woken;
+  });
+  std::thread producer([&full, &woken]() {
+    EXPECT_FALSE(full.push(3));
+    ++woken;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  empty.close();
+  full.close();
+  consumer.join();
+  producer.join();
+  EXPECT_EQ(woken, 2);
+}
+
+namespace {
+
+constexpr int STRESS_ITEMS_PER_PRODUCER = 20000;
+
+// Every producer pushes an increasing sequence tagged with its id. Consumers
+// check that no item is lost or duplicated and that each producer's items
+// keep their order. finish is called once every producer is done.
+template <typename Push, typename Pop, typename Finish>
+void stressQueue(int producers, int consumers, Push push, Pop pop,
+                 Finish finish) {
+  const long total = static_cast<long>(producers) * STRESS_ITEMS_PER_PRODUCER;
+  std::atomic<long> consumed{0};
+  std::atomic<long> sum{0};
+  std::atomic<bool> inOrder{true};
+  std::vector<std::thread> consumerThreads;
+  std::vector<std::thread> producerThreads;
+
+  for (int c = 0; c < consumers; ++c) {
+    consumerThreads.emplace_back([&]() {
+      std::vector<long> last(producers, -1);
+      long value = 0;
+      while (consumed.load() < total) {
+        if (not pop(value)) {
+          continue;
+        }
+        auto producer = value / STRESS_ITEMS_PER_PRODUCER;
+        auto seq = value % STRESS_ITEMS_PER_PRODUCER;
+        if (seq <= last[producer]) {
+          inOrder = false;
+        }
+        last[producer] = seq;
+        sum += value;
+        ++consumed;
+      }
+    });
+  }
+  for (int p = 0; p < producers; ++p) {
+    producerThreads.emplace_back([&push, p]() {
+      for (long n = 0; n < STRESS_ITEMS_PER_PRODUCER; ++n) {
+        push(static_cast<long>(p) * STRESS_ITEMS_PER_PRODUCER + n);
+      }
+    });
+  }
+  for (auto &t : producerThreads) {
+    t.join();
+  }
+  finish();
+  for (auto &t : consumerThreads) {
+    t.join();
+  }
+
+  EXPECT_EQ(consumed, total);
+  EXPECT_EQ(sum, total * (total - 1) / 2);
+  EXPECT_TRUE(inOrder);
+}
+
+}  // namespace
+
+TEST(EntityQueue, MpmcQueueStress) {
+  for (auto threads : {1, 4, 16}) {
+    ::entities::MpmcQueue<long> queue(64);
+    stressQueue(
+        threads, threads,
+        [&queue](long value) {
+          while (not queue.tryPush(std::move(value))) {
+            std::this_thread::yield();
+          }
+        },
+        [&queue](long &value) {
+          if (queue.tryPop(value)) {
+            return true;
+          }
+          std::this_thread::yield();
+          return false;
+        },
+        []() {});
+  }
+}
+
+TEST(EntityQueue, MpmcQueueBulkStress) {
+  ::entities::MpmcQueue<long> queue(128);
+  stressQueue(
+      4, 4,
+      [&queue](long value) {
+        while (not queue.tryPush(std::move(value))) {
+          std::this_thread::yield();
+        }
+      },
+      [&queue](long &value) {
+        // Bulk pops keep the order within the batch, so a single item is
+        // handed out at a time from a per-thread batch
+        thread_local std::vector<long> batch;
+        thread_local std::size_t next = 0;
+        if (next == batch.size()) {
+          batch.clear();
+          next = 0;
+          if (queue.popBulk(std::back_inserter(batch), 16) == 0) {
+            std::this_thread::yield();
+            return false;
+          }
+        }
+        value = batch[next++];
+        return true;
+      },
+      []() {});
+}
+
+TEST(EntityQueue, BlockingMpmcQueueStress) {
+  for (auto threads : {1, 4, 16}) {
+    // A small ring keeps both sides parking. Consumers still waiting when
+    // everything has been consumed are released by close()
+    ::entities::BlockingMpmcQueue<long> queue(8);
+    stressQueue(
+        threads, threads,
+        [&queue](long value) { queue.push(std::move(value)); },
+        [&queue](long &value) { return queue.pop(value); },
+        [&queue]() { queue.close(); });
+  }
+}
@@ -0,0 +1,112 @@
+#include <chrono>
+#include <vector>
+
+#include "entities/Context.hpp"
+#include "entities/StageTimer.hpp"
+#include "entities/Tracing.hpp"
+#include "gtest/gtest.h"
+
+using ::entities::Context;
+using ::entities::Span;
+using ::entities::SpanRing;
+using ::entities::Stage;
+
+TEST(EntityTracing, TraceIdsOf64And128BitsAreParsed) {
+  auto wide = ::entities::traceIdOf("463ac35c9f6413ad48485a3953bb6124");
+  ASSERT_TRUE(wide);
+  EXPECT_EQ(wide->traceIdHigh, 0x463ac35c9f6413adull);
+  EXPECT_EQ(wide->traceIdLow, 0x48485a3953bb6124ull);
+
+  auto narrow = ::entities::traceIdOf("48485A3953BB6124");
+  ASSERT_TRUE(narrow);
+  EXPECT_EQ(narrow->traceIdHigh, 0);
+  EXPECT_EQ(narrow->traceIdLow, 0x48485a3953bb6124ull);
+}
+
+TEST(EntityTracing, InvalidIdsAreRejected) {
+  EXPECT_FALSE(::entities::traceIdOf(""));
+  EXPECT_FALSE(::entities::traceIdOf("48485a3953bb612"));
+  EXPECT_FALSE(::entities::traceIdOf("48485a3953bb612g"));
+  EXPECT_FALSE(::entities::traceIdOf("0000000000000000"));
+  EXPECT_FALSE(::entities::spanIdOf("463ac35c9f6413ad48485a3953bb6124"));
+  EXPECT_EQ(::entities::spanIdOf("00f067aa0ba902b7"), 0x00f067aa0ba902b7ull);
+}
+
+TEST(EntityTracing, SpanIdsAreNotZeroNorRepeated) {
+  auto first = ::entities::newSpanId();
+  auto second = ::entities::newSpanId();
+  EXPECT_NE(first, 0);
+  EXPECT_NE(second, 0);
+  EXPECT_NE(first, second);
+}
+
+TEST(EntityTracing, ContextIsTracedFromB3Headers) {
+  SpanRing spans(16);
+  Context context;
+  context.copyTracingHeaders({{"X-B3-TraceId", "463ac35c9f6413ad"},
+                              {"x-b3-spanid", "00f067aa0ba902b7"},
+                              {"content-type", "application/json"}});
+  EXPECT_FALSE(context.isTraced());
+  context.traceInto(&spans);
+  EXPECT_TRUE(context.isTraced());
+  EXPECT_EQ(context.getSpanContext()->traceIdLow, 0x463ac35c9f6413adull);
+  EXPECT_EQ(context.getSpanContext()->parentSpanId, 0x00f067aa0ba902b7ull);
+
+  context.recordSpan(Stage::RULES, std::chrono::microseconds{250});
+  std::vector<Span> out;
+  ASSERT_EQ(spans.drain(out, 16), 1);
+  EXPECT_EQ(out[0].stage, Stage::RULES);
+  EXPECT_EQ(out[0].durationNanos, 250000);
+  EXPECT_EQ(out[0].context.traceIdLow, 0x463ac35c9f6413adull);
+  EXPECT_NE(out[0].spanId, 0);
+  EXPECT_GT(out[0].startUnixNanos, 0);
+}
+
+TEST(EntityTracing, UnsampledOrUntracedRequestsRecordNoSpan) {
+  SpanRing spans(16);
+  Context unsampled;
+  unsampled.copyTracingHeaders(
+      {{"x-b3-traceid", "463ac35c9f6413ad"}, {"x-b3-sampled", "0"}});
+  unsampled.traceInto(&spans);
+  Context untraced;
+  untraced.copyTracingHeaders({{"x-request-id", "abc"}});
+  untraced.traceInto(&spans);
+  EXPECT_FALSE(unsampled.isTraced());
+  EXPECT_FALSE(untraced.isTraced());
+
+  ::entities::Metrics metrics;
+  {
+    ::entities::StageTimer timer{metrics, Stage::PARSE, &unsampled};
+  }
+  untraced.recordSpan(Stage::PARSE, std::chrono::microseconds{1});
+  std::vector<Span> out;
+  EXPECT_EQ(spans.drain(out, 16), 0);
+  EXPECT_EQ(metrics.snapshot().stages[1].count, 1);
+}
+
+TEST(EntityTracing, StageTimerRecordsASpan) {
+  SpanRing spans(16);
+  Context context;
+  context.copyTracingHeaders({{"x-b3-traceid", "463ac35c9f6413ad"}});
+  context.traceInto(&spans);
+  ::entities::Metrics metrics;
+  {
+    ::entities::StageTimer timer{metrics, Stage::ENCODE, &context,
+                                 std::chrono::microseconds{10}};
+  }
+  std::vector<Span> out;
+  ASSERT_EQ(spans.drain(out, 16), 1);
+  EXPECT_EQ(out[0].stage, Stage::ENCODE);
+  EXPECT_GE(out[0].durationNanos, 10000);
+  EXPECT_EQ(out[0].context.parentSpanId, 0);
+}
+
+TEST(EntityTracing, FullRingDropsSpans) {
+  SpanRing spans(4);
+  for (int i = 0; i < 10; ++i) {
+    spans.record(Span{});
+  }
+  EXPECT_EQ(spans.dropped(), 10 - spans.capacity());
+  std::vector<Span> out;
+  EXPECT_EQ(spans.drain(out, 100), spans.capacity());
+}
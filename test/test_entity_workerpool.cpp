@@ -0,0 +1,228 @@
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "entities/WorkerPool.hpp"
+#include "gtest/gtest.h"
+
+TEST(EntityWorkerPool, RunsEverySubmittedTask) {
+  std::atomic<int> done{0};
+  {
+    ::entities::WorkerPool pool(4, 1000);
+    EXPECT_EQ(pool.threads(), 4);
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_TRUE(pool.submit([&done]() { ++done; }));
+    }
+  }
+  EXPECT_EQ(done, 1000);
+}
+
+TEST(EntityWorkerPool, TasksRunOutOfTheSubmittingThread) {
+  std::thread::id worker;
+  {
+    ::entities::WorkerPool pool(1, 1);
+    EXPECT_TRUE(
+        pool.submit([&worker]() { worker = std::this_thread::get_id(); }));
+  }
+  EXPECT_NE(worker, std::thread::id{});
+  EXPECT_NE(worker, std::this_thread::get_id());
+}
+
+TEST(EntityWorkerPool, FullQueueIsReported) {
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool started = false;
+  bool release = false;
+
+  ::entities::WorkerPool pool(1, 2);
+  // The only worker is kept busy so the queue fills up
+  EXPECT_TRUE(pool.submit([&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    started = true;
+    cond.notify_all();
+    cond.wait(lock, [&release]() { return release; });
+  }));
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [&started]() { return started; });
+  }
+  EXPECT_TRUE(pool.submit([]() {}));
+  EXPECT_TRUE(pool.submit([]() {}));
+  EXPECT_FALSE(pool.submit([]() {}));
+  EXPECT_EQ(pool.pending(), 2);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  cond.notify_all();
+  pool.stop();
+  EXPECT_EQ(pool.pending(), 0);
+  EXPECT_FALSE(pool.submit([]() {}));
+}
+
+TEST(EntityWorkerPool, ZeroThreadsStartsOneWorker) {
+  ::entities::WorkerPool pool(0, 1);
+  EXPECT_EQ(pool.threads(), 1);
+}
+
+TEST(EntityWorkerPool, ParallelForRunsEveryIndexOnce) {
+  ::entities::WorkerPool pool(4, 16);
+  std::vector<std::atomic<int>> runs(1000);
+  pool.parallelFor(runs.size(), [&runs](std::size_t i) { ++runs[i]; });
+  for (const auto &count : runs) {
+    EXPECT_EQ(count, 1);
+  }
+  pool.parallelFor(0, [](std::size_t) { FAIL(); });
+}
+
+TEST(EntityWorkerPool, ParallelForFromTasksOfABusyPool) {
+  // Every worker runs a loop whose helpers cannot be queued, or only once the
+  // loops are over: the callers do all the work
+  std::atomic<int> done{0};
+  {
+    ::entities::WorkerPool pool(2, 2);
+    for (int t = 0; t < 2; ++t) {
+      EXPECT_TRUE(pool.submit([&pool, &done]() {
+        pool.parallelFor(100, [&done](std::size_t) { ++done; });
+      }));
+    }
+  }
+  EXPECT_EQ(done, 200);
+}
+
+TEST(EntityWorkerPool, ParallelForOnAStoppedPool) {
+  ::entities::WorkerPool pool(2, 2);
+  pool.stop();
+  int done = 0;
+  pool.parallelFor(10, [&done](std::size_t) { ++done; });
+  EXPECT_EQ(done, 10);
+}
+
+namespace {
+
+// Keeps the only worker of a pool busy until released. The pool must be
+// stopped before it is destroyed
+class BusyWorker final {
+ public:
+  explicit BusyWorker(::entities::WorkerPool &pool) {
+    EXPECT_TRUE(pool.submit([this]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      started = true;
+      cond.notify_all();
+      cond.wait(lock, [this]() { return released; });
+    }));
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this]() { return started; });
+  }
+
+  void release() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      released = true;
+    }
+    cond.notify_all();
+  }
+
+ private:
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool started = false;
+  bool released = false;
+};
+
+}  // namespace
+
+TEST(EntityWorkerPool, InteractiveTasksRunFirstWithABulkOneByWeight) {
+  using ::entities::Priority;
+  std::vector<char> order;
+  {
+    ::entities::WorkerPool pool(1, 8, 2);
+    BusyWorker busy(pool);
+    for (int i = 0; i < 2; ++i) {
+      EXPECT_TRUE(pool.submit([&order]() { order.push_back('b'); },
+                              Priority::BULK));
+    }
+    for (int i = 0; i < 5; ++i) {
+      EXPECT_TRUE(pool.submit([&order]() { order.push_back('i'); },
+                              Priority::INTERACTIVE));
+    }
+    EXPECT_EQ(pool.pending(Priority::BULK), 2);
+    EXPECT_EQ(pool.pending(Priority::INTERACTIVE), 5);
+    EXPECT_EQ(pool.pending(), 7);
+    busy.release();
+    pool.stop();
+  }
+  // The busy task was the first interactive one of the worker
+  EXPECT_EQ(std::string(order.begin(), order.end()), "ibiibii");
+}
+
+TEST(EntityWorkerPool, EachPriorityHasItsOwnQueue) {
+  using ::entities::Priority;
+  ::entities::WorkerPool pool(1, 2);
+  BusyWorker busy(pool);
+  EXPECT_TRUE(pool.submit([]() {}, Priority::BULK));
+  EXPECT_TRUE(pool.submit([]() {}, Priority::BULK));
+  EXPECT_FALSE(pool.submit([]() {}, Priority::BULK));
+  EXPECT_TRUE(pool.submit([]() {}, Priority::INTERACTIVE));
+  busy.release();
+  pool.stop();
+}
+
+TEST(EntityWorkerPool, BulkWorkIsPreemptedBetweenItsChanges) {
+  using ::entities::Priority;
+  std::vector<std::string> order;
+  std::promise<void> finished;
+  {
+    ::entities::WorkerPool pool(1, 8);
+    BusyWorker busy(pool);
+    EXPECT_TRUE(pool.submit(
+        [&pool, &order, &finished]() {
+          pool.parallelFor(3, [&pool, &order](std::size_t i) {
+            order.push_back("change" + std::to_string(i));
+            if (i == 0) {
+              // Queued while bulk work runs, it does not wait for its end
+              pool.submit([&order]() { order.push_back("interactive"); },
+                          Priority::INTERACTIVE);
+            }
+          });
+          finished.set_value();
+        },
+        Priority::BULK));
+    busy.release();
+    finished.get_future().wait();
+    pool.stop();
+  }
+  ASSERT_EQ(order.size(), 4);
+  EXPECT_EQ(order[0], "change0");
+  EXPECT_EQ(order[1], "interactive");
+}
+
+TEST(EntityWorkerPool, InteractiveWorkIsNotPreempted) {
+  std::vector<int> order;
+  std::promise<void> finished;
+  {
+    ::entities::WorkerPool pool(1, 8);
+    BusyWorker busy(pool);
+    EXPECT_TRUE(pool.submit([&]() {
+      pool.parallelFor(2, [&](std::size_t i) {
+        order.push_back(static_cast<int>(i));
+        if (i == 0) {
+          pool.submit([&]() {
+            order.push_back(-1);
+            finished.set_value();
+          });
+        }
+      });
+    }));
+    busy.release();
+    finished.get_future().wait();
+    pool.stop();
+  }
+  ASSERT_EQ(order.size(), 3);
+  EXPECT_EQ(order.back(), -1);
+}
@@ -17,3 +17,137 @@ TEST(validatorEnvHandler, cpuRequest) {
 TEST(validatorEnvHandler, overloadProtectionEnabledCorrectlyReturned) {
   EXPECT_EQ(envHandler::isOverloadProtected(), true);
 }
+
+TEST(validatorEnvHandler, workerThreadsAndQueueSize) {
+  EXPECT_EQ(envHandler::getWorkerThreads(), envHandler::DEFAULT_WORKER_THREADS);
+  EXPECT_EQ(envHandler::getWorkerQueueSize(),
+            envHandler::DEFAULT_WORKER_QUEUE_SIZE);
+
+  setenv(envHandler::ENV_WORKER_THREADS, "8", 1);
+  setenv(envHandler::ENV_WORKER_QUEUE_SIZE, "64", 1);
+  EXPECT_EQ(envHandler::getWorkerThreads(), 8);
+  EXPECT_EQ(envHandler::getWorkerQueueSize(), 64);
+
+  setenv(envHandler::ENV_WORKER_THREADS, "0", 1);
+  setenv(envHandler::ENV_WORKER_QUEUE_SIZE, "-1", 1);
+  EXPECT_EQ(envHandler::getWorkerThreads(), envHandler::DEFAULT_WORKER_THREADS);
+  EXPECT_EQ(envHandler::getWorkerQueueSize(),
+            envHandler::DEFAULT_WORKER_QUEUE_SIZE);
+
+  setenv(envHandler::ENV_WORKER_THREADS, "4x", 1);
+  EXPECT_EQ(envHandler::getWorkerThreads(), envHandler::DEFAULT_WORKER_THREADS);
+
+  unsetenv(envHandler::ENV_WORKER_THREADS);
+  unsetenv(envHandler::ENV_WORKER_QUEUE_SIZE);
+}
+
+TEST(validatorEnvHandler, parallelChanges) {
+  EXPECT_EQ(envHandler::getParallelChanges(),
+            envHandler::DEFAULT_PARALLEL_CHANGES);
+
+  setenv(envHandler::ENV_PARALLEL_CHANGES, "8", 1);
+  EXPECT_EQ(envHandler::getParallelChanges(), 8);
+
+  setenv(envHandler::ENV_PARALLEL_CHANGES, "0", 1);
+  EXPECT_EQ(envHandler::getParallelChanges(),
+            envHandler::DEFAULT_PARALLEL_CHANGES);
+
+  unsetenv(envHandler::ENV_PARALLEL_CHANGES);
+}
+
+TEST(validatorEnvHandler, interactiveWeight) {
+  EXPECT_EQ(envHandler::getInteractiveWeight(),
+            envHandler::DEFAULT_INTERACTIVE_WEIGHT);
+
+  setenv(envHandler::ENV_INTERACTIVE_WEIGHT, "4", 1);
+  EXPECT_EQ(envHandler::getInteractiveWeight(), 4);
+
+  unsetenv(envHandler::ENV_INTERACTIVE_WEIGHT);
+}
+
+TEST(validatorEnvHandler, maxBatchItems) {
+  EXPECT_EQ(envHandler::getMaxBatchItems(),
+            envHandler::DEFAULT_MAX_BATCH_ITEMS);
+
+  setenv(envHandler::ENV_MAX_BATCH_ITEMS, "50", 1);
+  EXPECT_EQ(envHandler::getMaxBatchItems(), 50);
+
+  setenv(envHandler::ENV_MAX_BATCH_ITEMS, "0", 1);
+  EXPECT_EQ(envHandler::getMaxBatchItems(),
+            envHandler::DEFAULT_MAX_BATCH_ITEMS);
+
+  unsetenv(envHandler::ENV_MAX_BATCH_ITEMS);
+}
+
+TEST(validatorEnvHandler, responseValidation) {
+  EXPECT_EQ(envHandler::getResponseValidation(),
+            envHandler::DEFAULT_RESPONSE_VALIDATION);
+  EXPECT_EQ(envHandler::getResponseValidationSample(),
+            envHandler::DEFAULT_RESPONSE_VALIDATION_SAMPLE);
+
+  setenv(envHandler::ENV_RESPONSE_VALIDATION, "sampled", 1);
+  setenv(envHandler::ENV_RESPONSE_VALIDATION_SAMPLE, "10", 1);
+  EXPECT_EQ(envHandler::getResponseValidation(), "sampled");
+  EXPECT_EQ(envHandler::getResponseValidationSample(), 10);
+
+  unsetenv(envHandler::ENV_RESPONSE_VALIDATION);
+  unsetenv(envHandler::ENV_RESPONSE_VALIDATION_SAMPLE);
+}
+
+TEST(validatorEnvHandler, jsonParser) {
+  EXPECT_EQ(envHandler::getJsonParser(), envHandler::DEFAULT_JSON_PARSER);
+
+  setenv(envHandler::ENV_JSON_PARSER, "sax", 1);
+  EXPECT_EQ(envHandler::getJsonParser(), "sax");
+
+  unsetenv(envHandler::ENV_JSON_PARSER);
+}
+
+TEST(validatorEnvHandler, tracing) {
+  EXPECT_EQ(envHandler::getTraceFile(), "");
+  EXPECT_EQ(envHandler::getTraceRingSize(),
+            envHandler::DEFAULT_TRACE_RING_SIZE);
+  EXPECT_EQ(envHandler::getTraceExportInterval(),
+            envHandler::DEFAULT_TRACE_EXPORT_INTERVAL_MS);
+  EXPECT_EQ(envHandler::getTraceFileSize(),
+            envHandler::DEFAULT_TRACE_FILE_SIZE_MB);
+
+  setenv(envHandler::ENV_TRACE_FILE, "/tmp/spans.json", 1);
+  setenv(envHandler::ENV_TRACE_RING_SIZE, "1024", 1);
+  setenv(envHandler::ENV_TRACE_EXPORT_INTERVAL, "250", 1);
+  setenv(envHandler::ENV_TRACE_FILE_SIZE, "8", 1);
+  EXPECT_EQ(envHandler::getTraceFile(), "/tmp/spans.json");
+  EXPECT_EQ(envHandler::getTraceRingSize(), 1024);
+  EXPECT_EQ(envHandler::getTraceExportInterval(), 250);
+  EXPECT_EQ(envHandler::getTraceFileSize(), 8);
+
+  unsetenv(envHandler::ENV_TRACE_FILE);
+  unsetenv(envHandler::ENV_TRACE_RING_SIZE);
+  unsetenv(envHandler::ENV_TRACE_EXPORT_INTERVAL);
+  unsetenv(envHandler::ENV_TRACE_FILE_SIZE);
+}
+
+TEST(validatorEnvHandler, overloadControl) {
+  EXPECT_EQ(envHandler::getOverloadControl(),
+            envHandler::DEFAULT_OVERLOAD_CONTROL);
+  EXPECT_EQ(envHandler::getOverloadTarget(),
+            envHandler::DEFAULT_OVERLOAD_TARGET_MS);
+  EXPECT_EQ(envHandler::getOverloadInterval(),
+            envHandler::DEFAULT_OVERLOAD_INTERVAL_MS);
+  EXPECT_EQ(envHandler::getOverloadLatencyObjective(),
+            envHandler::DEFAULT_OVERLOAD_LATENCY_OBJECTIVE_MS);
+
+  setenv(envHandler::ENV_OVERLOAD_CONTROL, "cpu", 1);
+  setenv(envHandler::ENV_OVERLOAD_TARGET, "10", 1);
+  setenv(envHandler::ENV_OVERLOAD_INTERVAL, "200", 1);
+  setenv(envHandler::ENV_OVERLOAD_LATENCY_OBJECTIVE, "500", 1);
+  EXPECT_EQ(envHandler::getOverloadControl(), "cpu");
+  EXPECT_EQ(envHandler::getOverloadTarget(), 10);
+  EXPECT_EQ(envHandler::getOverloadInterval(), 200);
+  EXPECT_EQ(envHandler::getOverloadLatencyObjective(), 500);
+
+  unsetenv(envHandler::ENV_OVERLOAD_CONTROL);
+  unsetenv(envHandler::ENV_OVERLOAD_TARGET);
+  unsetenv(envHandler::ENV_OVERLOAD_INTERVAL);
+  unsetenv(envHandler::ENV_OVERLOAD_LATENCY_OBJECTIVE);
+}
@@ -0,0 +1,61 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ports/json/JsonBatch.hpp"
+
+using ::port::secondary::json::BatchFormat;
+using ::port::secondary::json::splitBatch;
+
+TEST(JsonBatchTest, ArrayIsSplitAtTopLevelCommas) {
+  std::string body =
+      R"( [ {"changes":[{"a":1},{"b":"],\"{"}]} ,{"x":[1,2]}, {} ] )";
+  BatchFormat format;
+  std::vector<std::string_view> items;
+  ASSERT_TRUE(splitBatch(body, format, items));
+  EXPECT_EQ(format, BatchFormat::ARRAY);
+  ASSERT_EQ(items.size(), 3);
+  EXPECT_EQ(items[0], R"({"changes":[{"a":1},{"b":"],\"{"}]})");
+  EXPECT_EQ(items[1], R"({"x":[1,2]})");
+  EXPECT_EQ(items[2], "{}");
+}
+
+TEST(JsonBatchTest, EmptyItemsAreKept) {
+  BatchFormat format;
+  std::vector<std::string_view> items;
+  ASSERT_TRUE(splitBatch("[]", format, items));
+  EXPECT_TRUE(items.empty());
+  ASSERT_TRUE(splitBatch("[{},,{},]", format, items));
+  ASSERT_EQ(items.size(), 4);
+  EXPECT_EQ(items[1], "");
+  EXPECT_EQ(items[3], "");
+}
+
+TEST(JsonBatchTest, UnclosedOrFollowedArrayIsRejected) {
+  BatchFormat format;
+  std::vector<std::string_view> items;
+  EXPECT_FALSE(splitBatch("[{}", format, items));
+  items.clear();
+  EXPECT_FALSE(splitBatch(R"([{"a":"]"})", format, items));
+  items.clear();
+  EXPECT_FALSE(splitBatch("[{}] {}", format, items));
+  items.clear();
+  EXPECT_TRUE(splitBatch("[{}]\n", format, items));
+}
+
+TEST(JsonBatchTest, NdjsonIsSplitAtLines) {
+  std::string body = "{\"a\":1}\r\n\n  \n {\"b\":[1,\n";
+  BatchFormat format;
+  std::vector<std::string_view> items;
+  ASSERT_TRUE(splitBatch(body, format, items));
+  EXPECT_EQ(format, BatchFormat::NDJSON);
+  ASSERT_EQ(items.size(), 2);
+  EXPECT_EQ(items[0], "{\"a\":1}");
+  EXPECT_EQ(items[1], "{\"b\":[1,");
+
+  items.clear();
+  ASSERT_TRUE(splitBatch("", format, items));
+  EXPECT_EQ(format, BatchFormat::NDJSON);
+  EXPECT_TRUE(items.empty());
+}
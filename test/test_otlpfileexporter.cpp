@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "entities/Tracing.hpp"
+#include "gtest/gtest.h"
+#include "ports/tracing/OtlpFileExporter.hpp"
+
+using ::entities::Span;
+using ::entities::SpanRing;
+using ::entities::Stage;
+using ::port::secondary::tracing::OtlpFileExporter;
+
+namespace {
+
+Span spanOf(Stage stage, std::uint64_t parentSpanId = 0) {
+  Span span;
+  span.context = {0x463ac35c9f6413adull, 0x48485a3953bb6124ull, parentSpanId};
+  span.spanId = 0xa2fb4a1d1a96d312ull;
+  span.startUnixNanos = 1700000000000000000ull;
+  span.durationNanos = 1500;
+  span.stage = stage;
+  return span;
+}
+
+}  // namespace
+
+TEST(OtlpFileExporter, SpansAreEncodedAsOtlpJson) {
+  std::string out;
+  ::port::secondary::tracing::spansToOtlpJson(
+      {spanOf(Stage::PARSE, 0x00f067aa0ba902b7ull), spanOf(Stage::RULES)},
+      "validator", out);
+  EXPECT_EQ(
+      out,
+      R"({"resourceSpans":[{"resource":{"attributes":[{"key":"service.name",)"
+      R"("value":{"stringValue":"validator"}}]},"scopeSpans":[{"scope":)"
+      R"({"name":"authprovvalidator"},"spans":[)"
+      R"({"traceId":"463ac35c9f6413ad48485a3953bb6124",)"
+      R"("spanId":"a2fb4a1d1a96d312","parentSpanId":"00f067aa0ba902b7",)"
+      R"("name":"parse","kind":1,"startTimeUnixNano":"1700000000000000000",)"
+      R"("endTimeUnixNano":"1700000000000001500"},)"
+      R"({"traceId":"463ac35c9f6413ad48485a3953bb6124",)"
+      R"("spanId":"a2fb4a1d1a96d312","name":"rules","kind":1,)"
+      R"("startTimeUnixNano":"1700000000000000000",)"
+      R"("endTimeUnixNano":"1700000000000001500"}]}]}]})");
+}
+
+TEST(OtlpFileExporter, SpansLeftAreWrittenOnStop) {
+  std::string path = ::testing::TempDir() + "otlp_exporter_test.json";
+  std::remove(path.c_str());
+  SpanRing spans(16);
+  {
+    OtlpFileExporter exporter(spans, path, "validator",
+                              std::chrono::hours{1});
+    ASSERT_TRUE(exporter.isOpen());
+    spans.record(spanOf(Stage::OAI_REQUEST));
+    spans.record(spanOf(Stage::ENCODE));
+    exporter.stop();
+    EXPECT_EQ(exporter.exported(), 2);
+  }
+  std::ifstream file(path);
+  std::string line;
+  ASSERT_TRUE(std::getline(file, line));
+  EXPECT_NE(line.find(R"("name":"oai_request")"), std::string::npos);
+  EXPECT_NE(line.find(R"("name":"encode")"), std::string::npos);
+  EXPECT_FALSE(std::getline(file, line));
+  std::remove(path.c_str());
+}
+
+TEST(OtlpFileExporter, SpansAreExportedEveryInterval) {
+  std::string path = ::testing::TempDir() + "otlp_exporter_interval.json";
+  std::remove(path.c_str());
+  SpanRing spans(16);
+  OtlpFileExporter exporter(spans, path, "validator",
+                            std::chrono::milliseconds{1});
+  spans.record(spanOf(Stage::OAI_RESPONSE));
+  for (int i = 0; i < 1000 and exporter.exported() == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  EXPECT_EQ(exporter.exported(), 1);
+  exporter.stop();
+  std::remove(path.c_str());
+}
+
+TEST(OtlpFileExporter, FileOverItsSizeIsRotated) {
+  std::string path = ::testing::TempDir() + "otlp_exporter_rotated.json";
+  std::string rotated =
+      path + ::port::secondary::tracing::ROTATED_TRACE_FILE_SUFFIX;
+  std::remove(path.c_str());
+  std::remove(rotated.c_str());
+  SpanRing spans(16);
+  // Room for one line of a span, not for two
+  for (auto stage : {Stage::PARSE, Stage::RULES}) {
+    OtlpFileExporter exporter(spans, path, "validator", std::chrono::hours{1},
+                              600);
+    spans.record(spanOf(stage));
+    exporter.stop();
+  }
+  std::ifstream older(rotated);
+  std::ifstream newer(path);
+  std::string line;
+  ASSERT_TRUE(std::getline(older, line));
+  EXPECT_NE(line.find(R"("name":"parse")"), std::string::npos);
+  ASSERT_TRUE(std::getline(newer, line));
+  EXPECT_NE(line.find(R"("name":"rules")"), std::string::npos);
+  EXPECT_FALSE(std::getline(newer, line));
+  std::remove(path.c_str());
+  std::remove(rotated.c_str());
+}
+
+TEST(OtlpFileExporter, UnwritableFileExportsNothing) {
+  SpanRing spans(16);
+  OtlpFileExporter exporter(spans, "/nonexistent/dir/spans.json", "validator",
+                            std::chrono::milliseconds{1});
+  EXPECT_FALSE(exporter.isOpen());
+  exporter.stop();
+}
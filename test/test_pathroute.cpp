@@ -0,0 +1,149 @@
+#include <boost/regex.hpp>
+#include <string>
+#include <vector>
+
+#include "entities/PathRoute.hpp"
+#include "entities/ValidationData.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Resource paths used along test_validationdata.cpp and
+// test_rapidjsonparser.cpp plus corner cases of the URI patterns
+const std::vector<std::string> RESOURCE_PATHS = {
+    "/subscribers/123abc/authSubscription/imsi-123456789012345/"
+    "authSubscriptionStaticData",
+    "/subscribers/000aaa/authSubscription/imsi-123456789012345/"
+    "authSubscriptionStaticData",
+    "/subscribers/000aaa/authSubscription/imsi-123456789012345/"
+    "authSubscriptionDynamicData",
+    "/subscribers/123abc/authSubscription/imsi-123456789012377/"
+    "authSubscriptionStaticData",
+    "/subscribers/0a23/authSubscription/imsi-123456789012345/"
+    "authSubscriptionStaticData",
+    "/subscribers/123abc/authSubscription/imsi-123456789012345",
+    "/subscribers/123abc/authSubscription/imsi-123456789012377",
+    "/subscribers/0a23/authSubscription/imsi-123456789012345",
+    "/subscribers/0a23/authSubscription/imsi-1234567890123456789",
+    "/subscribers/0a23/authSubscription/imsi-1234567890123456789/"
+    "authSubscriptionStaticData",
+    "/subscribers/0a23/authSubscription",
+    "/subscribers/123abc/journal/provJournal",
+    "/subscribers/3319b/journal/",
+    "/subscribers/",
+    "/legacy/serv=Auth/IMSI=123456789012345",
+    "/legacy/serv=Auth/IMSI=123456789012345/hello",
+    "/legacy/serv=Auth/",
+    "/legacy/",
+    "",
+    "/",
+    "/subscribers//authSubscription",
+    "/subscribers/authSubscription",
+    "/subscribers//authSubscription/",
+    "/subscribers//authSubscription/imsi-12345",
+    "/subscribers//authSubscription/imsi-1234",
+    "/subscribers//authSubscription/imsi-12345/",
+    "/subscribers//authSubscription//authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/b/authSubscription",
+    "/subscribers/a/authSubscription/authSubscription",
+    "/subscribers/a/b/authSubscription/imsi-12345/authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/x/authSubscription/"
+    "authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/imsi-12345/authSubscription/imsi-67890/"
+    "authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/imsi-123456789012345/b/"
+    "authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/imsi-12a45/authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/imsi--12345/authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/IMSI-12345/authSubscriptionStaticData",
+    "/subscribers/a/authsubscription/imsi-12345/authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/imsi-12345/authSubscriptionStaticData/",
+    "/subscribers/a/authSubscription/imsi-12345/authSubscriptionStaticDatax",
+    "/subscribers/a\n/authSubscription/imsi-12345/authSubscriptionStaticData",
+    "/subscribers/a/authSubscription/imsi-12345/x\ny",
+    "/Subscribers/a/authSubscription/imsi-12345/authSubscriptionStaticData",
+    "subscribers/a/authSubscription/imsi-12345/authSubscriptionStaticData",
+    "x/subscribers/a/authSubscription/imsi-12345/authSubscriptionStaticData",
+};
+
+bool regexMatch(const char *pattern, const std::string &path) {
+  boost::cmatch cm;
+  return boost::regex_match(path.c_str(), cm, boost::regex{pattern});
+}
+
+std::string regexCapture(const char *pattern, const std::string &path,
+                         int pos) {
+  boost::cmatch cm;
+  if (not boost::regex_match(path.c_str(), cm, boost::regex{pattern})) {
+    return {};
+  }
+  return cm[pos].str();
+}
+
+}  // namespace
+
+TEST(PathRouteTest, KindsAreEquivalentToUriPatterns) {
+  for (const auto &path : RESOURCE_PATHS) {
+    entities::PathRoute route{path};
+    EXPECT_EQ(route.isAuthSubscription(),
+              regexMatch(entities::AUTH_SUBSCRIPTION_URI_PATTERN, path))
+        << path;
+    EXPECT_EQ(route.isAuthSubscriptionPrivId(),
+              regexMatch(entities::AUTH_SUBSCRIPTION_PRIV_ID_URI_PATTERN, path))
+        << path;
+    EXPECT_EQ(
+        route.isAuthSubscriptionStaticData(),
+        regexMatch(entities::AUTH_SUBSCRIPTION_STATIC_DATA_URI_PATTERN, path))
+        << path;
+    EXPECT_EQ(route.hasImsi(), regexMatch(entities::IMSI_PATTERN, path))
+        << path;
+    EXPECT_EQ(route.isLegacy(), regexMatch(entities::LEGACY_PATTERN, path))
+        << path;
+  }
+}
+
+TEST(PathRouteTest, CapturesAreEquivalentToUriPatterns) {
+  for (const auto &path : RESOURCE_PATHS) {
+    entities::PathRoute route{path};
+    EXPECT_EQ(std::string{route.mscId()},
+              regexCapture(entities::AUTH_SUBSCRIPTION_STATIC_DATA_URI_PATTERN,
+                           path, entities::POS_MSCID))
+        << path;
+    EXPECT_EQ(std::string{route.imsi()},
+              regexCapture(entities::IMSI_PATTERN, path, entities::POS_IMSI))
+        << path;
+  }
+}
+
+TEST(PathRouteTest, StaticDataRouteOk) {
+  std::string path{
+      "/subscribers/123abc/authSubscription/imsi-123456789012345/"
+      "authSubscriptionStaticData"};
+  entities::PathRoute route{path};
+  EXPECT_TRUE(route.isAuthSubscriptionStaticData());
+  EXPECT_TRUE(route.hasImsi());
+  EXPECT_FALSE(route.isAuthSubscription());
+  EXPECT_FALSE(route.isAuthSubscriptionPrivId());
+  EXPECT_EQ(route.mscId(), "123abc");
+  EXPECT_EQ(route.imsi(), "123456789012345");
+}
+
+TEST(PathRouteTest, PrivIdRouteOk) {
+  std::string path{"/subscribers/123abc/authSubscription/imsi-123456789012345"};
+  entities::PathRoute route{path};
+  EXPECT_TRUE(route.isAuthSubscriptionPrivId());
+  EXPECT_TRUE(route.hasImsi());
+  EXPECT_EQ(route.privId(), "imsi-123456789012345");
+  EXPECT_EQ(route.imsi(), "");
+  EXPECT_EQ(route.mscId(), "");
+}
+
+TEST(PathRouteTest, LegacyRouteOk) {
+  entities::PathRoute route{"/legacy/serv=Auth/IMSI=123456789012345"};
+  EXPECT_TRUE(route.isLegacy());
+  EXPECT_FALSE(route.hasImsi());
+  EXPECT_FALSE(
+      entities::PathRoute{"/legacy/serv=Auth/IMSI=123456789012345/hello"}
+          .isLegacy());
+}
@@ -0,0 +1,138 @@
+#include <chrono>
+#include <string>
+
+#include "entities/ErrorText.hpp"
+#include "entities/Metrics.hpp"
+#include "gtest/gtest.h"
+#include "ports/server/PrometheusMetrics.hpp"
+
+using ::port::primary::metricsToPrometheus;
+using ::port::primary::ResponseValidationPolicy;
+
+namespace {
+
+std::string render(const ::entities::Metrics &metrics,
+                   const ResponseValidationPolicy &policy) {
+  std::string out;
+  metricsToPrometheus(metrics.snapshot(), policy, out);
+  return out;
+}
+
+bool contains(const std::string &text, const std::string &line) {
+  return text.find(line + "\n") != std::string::npos;
+}
+
+}  // namespace
+
+TEST(PrometheusMetrics, LabelValuesAreEscaped) {
+  std::string out;
+  ::port::primary::appendLabelValue("a\"b\\c\nd", out);
+  EXPECT_EQ(out, "a\\\"b\\\\c\\nd");
+}
+
+TEST(PrometheusMetrics, StageHistogramsAreCumulative) {
+  ::entities::Metrics metrics;
+  ResponseValidationPolicy policy;
+  metrics.recordStage(::entities::Stage::RULES, std::chrono::nanoseconds{500});
+  metrics.recordStage(::entities::Stage::RULES,
+                      std::chrono::microseconds{1500});
+  metrics.recordStage(::entities::Stage::RULES, std::chrono::seconds{60});
+
+  auto out = render(metrics, policy);
+  EXPECT_TRUE(contains(out,
+                       "# TYPE authprovvalidator_stage_duration_seconds "
+                       "histogram"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_stage_duration_seconds_bucket{"
+                       "stage=\"rules\",le=\"0.000001024\"} 1"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_stage_duration_seconds_bucket{"
+                       "stage=\"rules\",le=\"0.002097152\"} 2"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_stage_duration_seconds_bucket{"
+                       "stage=\"rules\",le=\"17.179869184\"} 2"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_stage_duration_seconds_bucket{"
+                       "stage=\"rules\",le=\"+Inf\"} 3"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_stage_duration_seconds_sum{"
+                       "stage=\"rules\"} 60.001500500"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_stage_duration_seconds_count{"
+                       "stage=\"rules\"} 3"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_stage_duration_seconds_count{"
+                       "stage=\"parse\"} 0"));
+}
+
+TEST(PrometheusMetrics, OutcomesViolationsAndCountersAreRendered) {
+  ::entities::Metrics metrics;
+  ResponseValidationPolicy policy("sampled", 2);
+  policy.shouldValidate();
+  policy.shouldValidate();
+  policy.recordFailure();
+  metrics.recordOutcome(409);
+  metrics.recordOutcome(302);
+  metrics.recordViolations({::entities::constraintViolation(
+      "/a", ::entities::ErrorKind::NOT_EQUAL_TO_LEGACY, "akaType", "A4")});
+
+  auto out = render(metrics, policy);
+  EXPECT_TRUE(
+      contains(out, "authprovvalidator_responses_total{code=\"409\"} 1"));
+  EXPECT_TRUE(
+      contains(out, "authprovvalidator_responses_total{code=\"200\"} 0"));
+  EXPECT_TRUE(
+      contains(out, "authprovvalidator_responses_total{code=\"other\"} 1"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_rule_violations_total{error=\""
+                       "Constraint Violation\",description=\"\\\"akaType\\\" "
+                       "is not equal to \\\"A4\\\" attribute of 4G legacy "
+                       "subscription\"} 1"));
+  EXPECT_TRUE(contains(
+      out,
+      "authprovvalidator_response_validations_total{result=\"validated\"} 1"));
+  EXPECT_TRUE(contains(
+      out,
+      "authprovvalidator_response_validations_total{result=\"skipped\"} 1"));
+  EXPECT_TRUE(
+      contains(out, "authprovvalidator_response_validation_failures_total 1"));
+  EXPECT_TRUE(contains(
+      out, "authprovvalidator_sampled_response_validation_failures_total 1"));
+}
+
+TEST(PrometheusMetrics, AdmissionStateIsRenderedByPriority) {
+  ::port::primary::AdmissionStates states;
+  auto &bulk = states[static_cast<std::size_t>(::entities::Priority::BULK)];
+  bulk.dropping = true;
+  bulk.admitted = 5;
+  bulk.rejected = 2;
+  bulk.shed = 1;
+  bulk.queueDelay = std::chrono::milliseconds{12};
+  bulk.serviceTime = std::chrono::microseconds{1500};
+
+  std::string out;
+  ::port::primary::admissionToPrometheus(states, out);
+  EXPECT_TRUE(contains(
+      out, "authprovvalidator_admission_shedding{priority=\"bulk\"} 1"));
+  EXPECT_TRUE(contains(
+      out,
+      "authprovvalidator_admission_shedding{priority=\"interactive\"} 0"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_admission_requests_total{priority=\""
+                       "bulk\",result=\"admitted\"} 5"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_admission_requests_total{priority=\""
+                       "bulk\",result=\"rejected\"} 2"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_admission_requests_total{priority=\""
+                       "bulk\",result=\"shed\"} 1"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_admission_requests_total{priority=\""
+                       "interactive\",result=\"shed\"} 0"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_admission_queue_delay_seconds{"
+                       "priority=\"bulk\"} 0.012000000"));
+  EXPECT_TRUE(contains(out,
+                       "authprovvalidator_admission_service_time_seconds{"
+                       "priority=\"bulk\"} 0.001500000"));
+}
@@ -1,14 +1,33 @@
+#include "entities/ErrorText.hpp"
 #include "gtest/gtest.h"
 #include "ports/json/JsonConstants.hpp"
 #include "ports/json/ValidatorRapidJsonEncoder.hpp"
 #include "ports/ports.hpp"
 
+// The direct Writer encoding must give the same bytes as the DOM one
+std::string directJson(
+    ::port::secondary::json::ValidatorRapidJsonEncoder& encoder,
+    const entities::ValidationData& data) {
+  std::string out;
+  encoder.validatorResponseToJson(data, out);
+  return out;
+}
+
+std::string directJson(
+    ::port::secondary::json::ValidatorRapidJsonEncoder& encoder,
+    const entities::Error& err) {
+  std::string out;
+  encoder.errorResponseToJson(err, out);
+  return out;
+}
+
 TEST(ValidatorRapidJsonEncoderTest,
      GivenEmptyDataThenJsonIsGeneratedCorrectly) {
   std::string jsonString{"{}"};
   entities::ValidationData data;
   ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
   EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
 }
 
 TEST(ValidatorRapidJsonEncoderTest,
@@ -48,6 +67,7 @@ TEST(ValidatorRapidJsonEncoderTest,
   data.response.changes.push_back(change);
   ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
   EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
 }
 
 TEST(ValidatorRapidJsonEncoderTest,
@@ -115,6 +135,7 @@ TEST(ValidatorRapidJsonEncoderTest,
   data.response.changes.push_back(change2);
   ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
   EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
 }
 
 TEST(ValidatorRapidJsonEncoderTest,
@@ -141,39 +162,81 @@ TEST(ValidatorRapidJsonEncoderTest,
   data.response.changes.push_back(change);
   ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
   EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
 }
 
 TEST(ValidatorRapidJsonEncoderTest, EncodeOneError) {
   std::string jsonString{
       "{\"errorMessage\":\"Error message "
       "1\",\"errorDetails\":{\"description\":\"Error description 1\"}}"};
-  entities::Error err;
-  err.errorMessage = "Error message 1";
-  err.errorDetails.insert({{"description", "Error description 1"}});
+  auto err = entities::requestError("Error message 1", "Error description 1");
   ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
   EXPECT_EQ(encoder.errorResponseToJson(err).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, err), jsonString);
+}
+
+TEST(ValidatorRapidJsonEncoderTest, EncodeErrorDescribedByItsKind) {
+  std::string jsonString{
+      "{\"errors\":[{\"errorMessage\":\"Constraint "
+      "Violation\",\"errorDetails\":{\"description\":\"Mandatory "
+      "field:[authSubscriptionStaticData] not found\",\"resource_path\":\"/"
+      "subscribers/123abc/authSubscription\"}},{\"errorMessage\":\"Constraint "
+      "Violation\",\"errorDetails\":{\"description\":\"Field:[sqn] is not "
+      "string\",\"resource_path\":\"/subscribers/123abc/"
+      "authSubscription\"}}]}"};
+  entities::ValidationData data;
+  std::string path{"/subscribers/123abc/authSubscription"};
+  data.addError(entities::constraintViolation(
+      path, entities::ErrorKind::MANDATORY_FIELD_NOT_FOUND,
+      JSON_AUTH_SUBSCRIPTION_STATIC_DATA));
+  data.addError(entities::constraintViolation(
+      path, entities::ErrorKind::NOT_STRING_FIELD, JSON_SQN));
+  ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
+  EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
 }
 
 TEST(ValidatorRapidJsonEncoderTest, EncodeSeveralErrors) {
   std::string jsonString{
       "{\"errors\":[{\"errorMessage\":\"Error message "
       "1\",\"errorDetails\":{\"description\":\"Error description "
-      "1\",\"path\":\"resource1\"}},{\"errorMessage\":\"Error message "
-      "2\",\"errorDetails\":{\"description\":\"Error description "
-      "2\",\"info\":\"Additional info\",\"path\":\"resource2\"}}]}"};
+      "1\",\"resource_path\":\"resource1\"}},{\"errorMessage\":\"Error "
+      "message 2\",\"errorDetails\":{\"description\":\"Error description "
+      "2\"}}]}"};
   entities::ValidationData data;
-  entities::Error err1, err2;
-  err1.errorMessage = "Error message 1";
-  err1.errorDetails.insert(
-      {{"path", "resource1"}, {"description", "Error description 1"}});
-  err2.errorMessage = "Error message 2";
-  err2.errorDetails.insert({{"path", "resource2"},
-                            {"description", "Error description 2"},
-                            {"info", "Additional info"}});
+  entities::Error err1{"Error message 1", entities::ErrorKind::TEXT,
+                       "Error description 1", {}, "resource1", {}};
+  auto err2 = entities::requestError("Error message 2", "Error description 2");
   data.response.errors.push_back(err1);
   data.response.errors.push_back(err2);
   ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
   EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
+}
+
+TEST(ValidatorRapidJsonEncoderTest, EncodeSeveralErrorsWithRequestArena) {
+  std::string jsonString{
+      "{\"errors\":[{\"errorMessage\":\"Error message "
+      "1\",\"errorDetails\":{\"description\":\"Error description "
+      "1\",\"resource_path\":\"resource1\"}},{\"errorMessage\":\"Error "
+      "message 2\",\"errorDetails\":{\"description\":\"Error description "
+      "2\",\"resource_path\":\"resource2\"}}]}"};
+  entities::ValidationData data;
+  entities::Error err1{"Error message 1", entities::ErrorKind::TEXT,
+                       "Error description 1", {}, "resource1", {}};
+  entities::Error err2{"Error message 2", entities::ErrorKind::TEXT,
+                       "Error description 2", {}, "resource2", {}};
+  data.response.errors.push_back(err1);
+  data.response.errors.push_back(err2);
+  entities::RequestArena arena;
+  ::port::secondary::json::ValidatorRapidJsonEncoder encoder(arena);
+  EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
+  EXPECT_EQ(encoder.errorResponseToJson(err1).str(),
+            "{\"errorMessage\":\"Error message 1\",\"errorDetails\":{"
+            "\"description\":\"Error description 1\",\"resource_path\":"
+            "\"resource1\"}}");
+  EXPECT_EQ(directJson(encoder, err1), encoder.errorResponseToJson(err1).str());
 }
 
 TEST(ValidatorRapidJsonEncoderTest,
@@ -205,6 +268,7 @@ TEST(ValidatorRapidJsonEncoderTest,
   data.response.changes.push_back(change);
   ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
   EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
 }
 
 TEST(ValidatorRapidJsonEncoderTest, EncodeAuthSubscriptionDeleteOperation) {
@@ -234,6 +298,7 @@ TEST(ValidatorRapidJsonEncoderTest, EncodeAuthSubscriptionDeleteOperation) {
   data.response.changes.push_back(change);
   ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
   EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
 }
 
 rapidjson::Document strToDocument(const std::string& val) {
@@ -282,3 +347,116 @@ TEST(ValidatorRapidJsonEncoderTest,
   ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
   EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
 }
+
+TEST(ValidatorRapidJsonEncoderTest,
+     EncodeAuthSubscriptionCreateOperationWithDynamicData) {
+  const std::string path{
+      "/subscribers/123abc/authSubscription/imsi-123456789012345/"
+      "authSubscriptionStaticData"};
+  std::string jsonString(
+      "{\"changes\":[{\"operation\":\"CREATE\",\"resource_path\":\"" + path +
+      "\",\"data\":{\"authenticationMethod\":\"5G_AKA\",\"encPermanentKey\":"
+      "\"AAAA\"}},{\"operation\":\"CREATE\",\"resource_path\":\"" +
+      entities::ValidationData::createPathFromBasePath(
+          path, JSON_AUTH_SUBSCRIPTION_DYNAMIC_DATA) +
+      "\",\"data\":{\"sqnScheme\":\"NON_TIME_BASED\",\"sqn\":\"000000000001\","
+      "\"lastIndexes\":{\"ausf\":3,\"udm\":-1}}}]}");
+
+  entities::ValidationData data;
+  entities::Change change;
+  change.operation = JSON_OPERATION_CREATE;
+  change.resourcePath = path;
+
+  entities::auth_subscription_static_data_t authSubscriptionStaticData;
+  authSubscriptionStaticData.authenticationMethod = JSON_5G_AKA;
+  authSubscriptionStaticData.encPermanentKey.emplace("AAAA");
+  authSubscriptionStaticData.algorithmId.emplace("");
+
+  entities::auth_subscription_dynamic_data_t authSubscriptionDynamicData;
+  authSubscriptionDynamicData.sqnScheme.emplace("NON_TIME_BASED");
+  authSubscriptionDynamicData.sqn.emplace("000000000001");
+  authSubscriptionDynamicData.lastIndexesList.emplace(
+      entities::last_indexes_list_t{{"udm", -1}, {"ausf", 3}});
+
+  change.authSubscription.authSubscriptionStaticData.emplace(
+      authSubscriptionStaticData);
+  change.authSubscription.authSubscriptionDynamicData.emplace(
+      authSubscriptionDynamicData);
+  data.response.changes.push_back(change);
+  ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
+  EXPECT_EQ(encoder.validatorResponseToJson(data).str(), jsonString);
+  EXPECT_EQ(directJson(encoder, data), jsonString);
+}
+
+TEST(ValidatorRapidJsonEncoderTest, DirectEncodingMatchesDomEncoding) {
+  rapidjson::Document vendorSpecific;
+  vendorSpecific.Parse("{\"id\":[1,2.5,true,null,\"a\\\"b\"],\"e\":{}}");
+
+  entities::ValidationData data;
+  entities::Change change;
+  change.operation = "UPDATE";
+  change.resourcePath =
+      "/subscribers/123abc/authSubscription/imsi-123456789012345/"
+      "authSubscriptionStaticData";
+  entities::auth_subscription_static_data_t authSubscriptionStaticData;
+  authSubscriptionStaticData.vendorSpecific.emplace("vendorSpecific-001",
+                                                    vendorSpecific);
+  authSubscriptionStaticData.encOpcKey.emplace("\t\x01\xc3\xa9");
+  change.authSubscription.authSubscriptionStaticData.emplace(
+      authSubscriptionStaticData);
+  data.response.changes.push_back(change);
+
+  entities::Change changeOther;
+  changeOther.operation = JSON_OPERATION_CREATE;
+  changeOther.resourcePath = "/subscribers/123abc/other";
+  data.response.changes.push_back(changeOther);
+
+  ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
+  EXPECT_EQ(directJson(encoder, data),
+            encoder.validatorResponseToJson(data).str());
+
+  ::port::secondary::json::ValidatorRapidJsonEncoder prettyEncoder;
+  prettyEncoder.enablePrettyFormat();
+  EXPECT_EQ(directJson(prettyEncoder, data),
+            prettyEncoder.validatorResponseToJson(data).str());
+  EXPECT_NE(directJson(prettyEncoder, data), directJson(encoder, data));
+}
+
+TEST(ValidatorRapidJsonEncoderTest, DirectEncodingReusesOutputBuffer) {
+  auto err = entities::requestError("Error message 1", "Error description 1");
+  entities::ValidationData data;
+
+  entities::RequestArena arena;
+  ::port::secondary::json::ValidatorRapidJsonEncoder encoder(arena);
+  std::string out;
+  encoder.errorResponseToJson(err, out);
+  EXPECT_EQ(out, encoder.errorResponseToJson(err).str());
+  auto capacity = out.capacity();
+
+  encoder.validatorResponseToJson(data, out);
+  EXPECT_EQ(out, "{}");
+  EXPECT_EQ(out.capacity(), capacity);
+}
+
+TEST(ValidatorRapidJsonEncoderTest, BatchResponsesKeepTheirOrder) {
+  std::vector<::port::secondary::json::batch_result_t> results = {
+      {200, "{}"}, {400, R"({"errorMessage":"Malformed request"})"}};
+  ::port::secondary::json::ValidatorRapidJsonEncoder encoder;
+  std::string out;
+
+  encoder.batchResponseToJson(results, false, out);
+  EXPECT_EQ(out,
+            R"([{"status":200,"response":{}},)"
+            R"({"status":400,"response":{"errorMessage":"Malformed request"}}])");
+
+  encoder.batchResponseToJson(results, true, out);
+  EXPECT_EQ(out,
+            "{\"status\":200,\"response\":{}}\n"
+            "{\"status\":400,\"response\":"
+            "{\"errorMessage\":\"Malformed request\"}}\n");
+
+  encoder.batchResponseToJson({}, false, out);
+  EXPECT_EQ(out, "[]");
+  encoder.batchResponseToJson({}, true, out);
+  EXPECT_EQ(out, "");
+}
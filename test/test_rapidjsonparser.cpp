@@ -1,6 +1,7 @@
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 
+#include "entities/ErrorText.hpp"
 #include "gtest/gtest.h"
 #include "ports/json/JsonConstants.hpp"
 #include "ports/json/ValidatorRapidJsonParser.hpp"
@@ -238,8 +239,8 @@ TEST(ValidatorRapidJsonParserTest,
             false);
 
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "Field:[authenticationMethod] is not string");
 }
 
@@ -310,30 +311,30 @@ TEST(ValidatorRapidJsonParserTest,
             false);
 
   EXPECT_EQ(record.response.errors.size(), 8);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "Mandatory field:[authenticationMethod] not found as child "
             "of:[authSubscriptionStaticData]");
-  EXPECT_EQ(record.response.errors[1].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("description"),
+  EXPECT_EQ(record.response.errors[1].message, "Constraint Violation");
+  EXPECT_EQ(entities::errorDescription(record.response.errors[1]),
             "Field:[algorithmId] is not string");
-  EXPECT_EQ(record.response.errors[2].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[2].errorDetails.at("description"),
+  EXPECT_EQ(record.response.errors[2].message, "Constraint Violation");
+  EXPECT_EQ(entities::errorDescription(record.response.errors[2]),
             "Field:[a4KeyInd] is not string");
-  EXPECT_EQ(record.response.errors[3].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("description"),
+  EXPECT_EQ(record.response.errors[3].message, "Constraint Violation");
+  EXPECT_EQ(entities::errorDescription(record.response.errors[3]),
             "Field:[a4Ind] is not string");
-  EXPECT_EQ(record.response.errors[4].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("description"),
+  EXPECT_EQ(record.response.errors[4].message, "Constraint Violation");
+  EXPECT_EQ(entities::errorDescription(record.response.errors[4]),
             "Field:[encOpcKey] is not string");
-  EXPECT_EQ(record.response.errors[5].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[5].errorDetails.at("description"),
+  EXPECT_EQ(record.response.errors[5].message, "Constraint Violation");
+  EXPECT_EQ(entities::errorDescription(record.response.errors[5]),
             "Field:[encTopcKey] is not string");
-  EXPECT_EQ(record.response.errors[6].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[6].errorDetails.at("description"),
+  EXPECT_EQ(record.response.errors[6].message, "Constraint Violation");
+  EXPECT_EQ(entities::errorDescription(record.response.errors[6]),
             "Field:[a4KeyV] is not string");
-  EXPECT_EQ(record.response.errors[7].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[7].errorDetails.at("description"),
+  EXPECT_EQ(record.response.errors[7].message, "Constraint Violation");
+  EXPECT_EQ(entities::errorDescription(record.response.errors[7]),
             "Field:[akaAlgorithmInd] is not string");
 }
 
@@ -361,8 +362,8 @@ TEST(ValidatorRapidJsonParserTest, ParseAuthSubscriptionAsRelatedResource) {
   EXPECT_EQ(record.changes.size(), 0);
   EXPECT_EQ(record.relatedResources.size(), 1);
 
-  entities::auth_subscription_t& authSubscription =
-      boost::get<entities::auth_subscription_t>(record.relatedResources.at(
+  const entities::auth_subscription_t& authSubscription =
+      std::get<entities::auth_subscription_t>(record.relatedResources.at(
           "/subscribers/123abc/authSubscription/imsi-123456789012345"));
 
   EXPECT_EQ(authSubscription.authSubscriptionStaticData.has_value(), true);
@@ -477,7 +478,7 @@ TEST(ValidatorRapidJsonParserTest, ParseProvJournalRelatedResources) {
   EXPECT_EQ(record.changes.size(), 0);
   EXPECT_EQ(record.relatedResources.size(), 2);
 
-  entities::ProvJournal& journal1 = boost::get<entities::ProvJournal>(
+  const entities::ProvJournal& journal1 = std::get<entities::ProvJournal>(
       record.relatedResources.at("/subscribers/2208a/journal/provJournal"));
   EXPECT_EQ(journal1.notifRef, "notifRef1");
   EXPECT_EQ(journal1.imsi, "IMSI1");
@@ -498,7 +499,7 @@ TEST(ValidatorRapidJsonParserTest, ParseProvJournalRelatedResources) {
   EXPECT_EQ(journal1.usernameMask, "usernameMask1");
   EXPECT_EQ(journal1.usernameExtMask, "usernameExtMask1");
 
-  entities::ProvJournal& journal2 = boost::get<entities::ProvJournal>(
+  const entities::ProvJournal& journal2 = std::get<entities::ProvJournal>(
       record.relatedResources.at("/subscribers/3319b/journal/provJournal"));
   EXPECT_EQ(journal2.notifRef, "");
   EXPECT_EQ(journal2.imsiChoStatus, 2);
@@ -523,6 +524,38 @@ TEST(ValidatorRapidJsonParserTest, ParseProvJournalRelatedResources) {
   EXPECT_EQ(journal2.subsIdList[1].prefix, "");
 }
 
+TEST(ValidatorRapidJsonParserTest, ParseProvJournalInsituBorrowsFromBody) {
+  std::string jsonString(
+      "{\"relatedResources\":{\"/subscribers/3319b/journal/"
+      "provJournal\":{\"imsi\":\"IMSI1\",\"imsiMask\":\"imsiMask1\","
+      "\"imsiChoStatus\":2,\"impuChoIds\":[\"impuchoid1\"],"
+      "\"subsIdList\":[{\"id\":\"i3\",\"prefix\":\"p3\"}]}}}");
+
+  ::port::secondary::json::ValidatorRapidJsonParser parser(
+      std::move(jsonString));
+  EXPECT_EQ(parser.error(), false);
+  entities::ValidationData record;
+  EXPECT_EQ(parser.getValidationData(record), true);
+
+  EXPECT_EQ(record.relatedResources.size(), 1);
+  const auto& journal = std::get<entities::prov_journal_view_t>(
+      record.relatedResources.at("/subscribers/3319b/journal/provJournal"));
+  EXPECT_EQ(journal.notifRef, "");
+  EXPECT_EQ(journal.imsi, "IMSI1");
+  EXPECT_EQ(journal.imsiMask, "imsiMask1");
+  EXPECT_EQ(journal.imsiChoStatus, 2);
+  EXPECT_EQ(journal.impuChoIds.size(), 1);
+  EXPECT_EQ(journal.impuChoIds[0], "impuchoid1");
+  EXPECT_EQ(journal.subsIdList.size(), 1);
+  EXPECT_EQ(journal.subsIdList[0].id, "i3");
+  EXPECT_EQ(journal.subsIdList[0].prefix, "p3");
+
+  auto owned = entities::toProvJournal(journal);
+  EXPECT_EQ(owned.imsiMask, "imsiMask1");
+  EXPECT_EQ(owned.impuChoIds[0], "impuchoid1");
+  EXPECT_EQ(owned.subsIdList[0].prefix, "p3");
+}
+
 TEST(ValidatorRapidJsonParserTest,
      ParseAuthSubscriptionLegacyAsRelatedResource) {
   std::string jsonString(
@@ -546,8 +579,8 @@ TEST(ValidatorRapidJsonParserTest,
   EXPECT_EQ(record.changes.size(), 0);
   EXPECT_EQ(record.relatedResources.size(), 1);
 
-  entities::auth_subscription_legacy_t& authSubscriptionLegacy =
-      boost::get<entities::auth_subscription_legacy_t>(
+  const entities::auth_subscription_legacy_t& authSubscriptionLegacy =
+      std::get<entities::auth_subscription_legacy_t>(
           record.relatedResources.at("/legacy/serv=Auth/IMSI=123456789012345"));
 
   EXPECT_EQ(authSubscriptionLegacy.fSetInd.value(), 0);
@@ -590,8 +623,8 @@ TEST(ValidatorRapidJsonParserTest,
   EXPECT_EQ(record.changes.size(), 0);
   EXPECT_EQ(record.relatedResources.size(), 1);
 
-  entities::auth_subscription_legacy_t& authSubscriptionLegacy =
-      boost::get<entities::auth_subscription_legacy_t>(
+  const entities::auth_subscription_legacy_t& authSubscriptionLegacy =
+      std::get<entities::auth_subscription_legacy_t>(
           record.relatedResources.at("/legacy/serv=Auth/IMSI=123456789012345"));
 
   EXPECT_EQ(authSubscriptionLegacy.fSetInd.value(), 0);
@@ -0,0 +1,328 @@
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "entities/ErrorText.hpp"
+#include "gtest/gtest.h"
+#include "ports/json/JsonConstants.hpp"
+#include "ports/json/ValidatorRapidJsonParser.hpp"
+#include "ports/json/ValidatorRapidJsonSaxParser.hpp"
+
+namespace {
+
+using ::port::secondary::json::ValidatorRapidJsonParser;
+using ::port::secondary::json::ValidatorRapidJsonSaxParser;
+
+// Bodies the SAX parser must extract exactly as the DOM one does. The first
+// ones are those of test_rapidjsonparser.cpp, then members out of the order
+// the DOM walk reads them, duplicated members and bodies stopping the walk
+const std::vector<std::string> CORPUS = {
+    "{\"changes\":[{\"operation\":\"CREATE\",\"resource_path\":\"/subscribers/"
+    "123abc/authSubscription/imsi-123456789012345/authSubscriptionStaticData\""
+    ",\"data\":{\"authenticationMethod\":\"5G_AKA\",\"encPermanentKey\":"
+    "\"2200AA34D40C090D6D4C3B7763854AFB\",\"authenticationManagementField\":"
+    "\"B9B9\",\"algorithmId\":\"11\",\"a4KeyInd\":\"1\",\"a4Ind\":\"2\","
+    "\"encOpcKey\":\"7AF98A06EA86AB8B3377D27AE089A3A4\",\"encTopcKey\":"
+    "\"ABCDEF\",\"a4KeyV\":\"15\",\"akaAlgorithmInd\":\"1\"}}]}",
+
+    "{\"changes\":[{\"operation\":\"CREATE\",\"resource_path\":\"/subscribers/"
+    "123abc/authSubscription/imsi-123456789012345/authSubscriptionStaticData\""
+    ",\"data\":{\"authenticationMethod\":1234}}]}",
+
+    "{\"changes\":[{\"operation\":\"CREATE\",\"resource_path\":\"/subscribers/"
+    "123abc/authSubscription/imsi-123456789012345/authSubscriptionStaticData\""
+    ",\"data\":{\"algorithmId\":1234,\"a4KeyInd\":1234,\"a4Ind\":1234,"
+    "\"encOpcKey\":1234,\"encTopcKey\":1234,\"a4KeyV\":15,"
+    "\"akaAlgorithmInd\":1}}]}",
+
+    "{\"relatedResources\":{\"/subscribers/123abc/authSubscription\":{"
+    "\"imsi-123456789012345\":{\"authSubscriptionStaticData\":{"
+    "\"authenticationMethod\":\"5G_AKA\",\"encPermanentKey\":"
+    "\"2200AA34D40C090D6D4C3B7763854AFB\",\"authenticationManagementField\":"
+    "\"B9B9\",\"algorithmId\":\"11\",\"a4KeyInd\":\"1\",\"a4Ind\":\"2\","
+    "\"encOpcKey\":\"7AF98A06EA86AB8B3377D27AE089A3A4\",\"encTopcKey\":"
+    "\"ABCDEF\",\"a4KeyV\":\"10\",\"akaAlgorithmInd\":\"1\"},"
+    "\"authSubscriptionDynamicData\":{\"sqnScheme\":\"GENERAL\",\"sqn\":"
+    "\"000000000020\",\"lastIndexes\":{\"ind5gAusf\":25,\"indMme\":26}}}}}}",
+
+    "{\"relatedResources\":{\"/subscribers/2208a/journal/provJournal\":{"
+    "\"notifRef\":\"notifRef1\",\"imsi\":\"IMSI1\",\"imsiMask\":\"imsiMask1\","
+    "\"imsiExtMask\":\"imsiExtMask1\",\"msisdn\":\"MSISDN1\",\"msisdnMask\":"
+    "\"msisdnMask1\",\"msisdnExtMask\":\"msisdnExtMask1\",\"imsiAux\":"
+    "\"IMSIAux1\",\"imsiAuxMask\":\"imsiAuxMask1\",\"imsiAuxExtMask\":"
+    "\"imsiAuxExtMask1\",\"impi\":\"IMPI1\",\"impiMask\":\"impiMask1\","
+    "\"impiExtMask\":\"impiExtMask1\",\"secImpi\":\"secImpi1\",\"impiAux\":"
+    "\"IMPIAux1\",\"username\":\"username1\",\"usernameMask\":"
+    "\"usernameMask1\",\"usernameExtMask\":\"usernameExtMask1\"},"
+    "\"/subscribers/3319b/journal/provJournal\":{\"imsiChoStatus\":2,"
+    "\"imsiExpiryDate\":\"expiryDate2\",\"imsiChoExec\":\"exec2\","
+    "\"impuChoIds\":[\"impuchoid1\",\"impuchoid2\"],\"mscIdAux\":"
+    "\"mscIdAux2\",\"notifInfo\":\"notifInfo2\",\"ueFunctionMask\":"
+    "\"ueFunctionMask2\",\"extIdList\":[\"extId1\",\"extId2\"],\"nai\":"
+    "\"NAI2\",\"naiMask\":\"naiMask2\",\"naiExtMask\":\"naiExtMask2\","
+    "\"subsIdList\":[{\"id\":\"i3\",\"prefix\":\"p3\"},{\"id\":\"i4\"}]}}}",
+
+    "{\"relatedResources\":{\"/legacy/serv=Auth/IMSI=123456789012345\":{"
+    "\"FSETIND\":0,\"EKI\":\"1032547698BADCFE\",\"KIND\":11,\"A4IND\":2,"
+    "\"AMFVALUE\":1,\"EOPC\":\"32\",\"SEQHE\":\"20\",\"VNUMBER\":16,"
+    "\"AKAALGIND\":0}}}",
+
+    "{\"relatedResources\":{\"/legacy/serv=Auth/IMSI=123456789012345\":{"
+    "\"FSETIND\":0,\"EKI:\":\"MTAzMjU0NzY5OEJBRENGRQ==\",\"KIND\":11,"
+    "\"A4IND\":2,\"AMFVALUE\":1,\"EOPC:\":\"MzI=\",\"SEQHE:\":\"MjA=\"}}}",
+
+    "{\"changes\":[{\"operation\":\"CREATE\",\"resource_path\":\"/subscribers/"
+    "123abc/authSubscription/imsi-123456789012345/authSubscriptionStaticData\""
+    ",\"data\":{\"authenticationMethod\":\"5G_AKA\",\"vendorSpecific-001\":{"
+    "\"key1\":\"A\",\"key2\":true,\"key3\":[2,3]},\"encPermanentKey\":"
+    "\"2200AA34D40C090D6D4C3B7763854AFB\",\"vendorSpecific-002\":\"hello\","
+    "\"vendorSpecific-003\":[{\"a\":null},-1.5,[]],\"vendorSpecific-001\":7}}"
+    "]}",
+
+    // Related resources first, static data after dynamic data
+    "{\"relatedResources\":{\"/subscribers/123abc/authSubscription\":{"
+    "\"imsi-1\":{\"authSubscriptionDynamicData\":{\"lastIndexes\":{\"a\":"
+    "\"x\",\"b\":3,\"c\":4.5},\"sqn\":12,\"sqnScheme\":\"GENERAL\"},"
+    "\"authSubscriptionStaticData\":{\"a4Ind\":2,\"authenticationMethod\":"
+    "false}}}},\"changes\":[{\"data\":{\"authSubscriptionStaticData\":{"
+    "\"authenticationMethod\":\"5G_AKA\"}},\"resource_path\":\"/subscribers/"
+    "123abc/authSubscription/imsi-1\",\"operation\":\"UPDATE\"}]}",
+
+    // Direct form picked by a static data member coming last
+    "{\"relatedResources\":{\"/subscribers/123abc/authSubscription/imsi-2\":{"
+    "\"authSubscriptionDynamicData\":{\"sqn\":\"000000000001\"},"
+    "\"authSubscriptionStaticData\":{\"authenticationMethod\":\"5G_AKA\"}}}}",
+
+    // Suffixed form, with dynamic data read as an authSubscription
+    "{\"relatedResources\":{\"/subscribers/123abc/authSubscription\":{"
+    "\"imsi-3\":{\"authSubscriptionStaticData\":{}},"
+    "\"authSubscriptionDynamicData\":{\"sqn\":\"1\"},\"imsi-4\":{"
+    "\"authSubscriptionStaticData\":1,\"authSubscriptionDynamicData\":2},"
+    "\"imsi-5\":{\"authSubscriptionStaticData\":{\"authenticationMethod\":"
+    "\"EAP_AKA_PRIME\"},\"authSubscriptionDynamicData\":[]}}}}",
+
+    // Duplicated members: the DOM walk reads the first one
+    "{\"changes\":[],\"changes\":7,\"relatedResources\":{\"/legacy/serv=Auth/"
+    "IMSI=1\":{\"KIND\":\"1\",\"KIND\":2,\"VNUMBER\":1,\"AKAALGIND\":3,"
+    "\"EKI\":\"\",\"EKI:\":\"QUJD\"},\"/subscribers/9/journal/provJournal\":{"
+    "\"imsi\":1,\"imsi\":\"IMSI\",\"imsiChoStatus\":\"2\",\"subsIdList\":[1,"
+    "{\"prefix\":\"p\",\"id\":\"i\",\"id\":\"j\"}]}}}",
+
+    // Changes not to extract from and rejected changes
+    "{\"changes\":[{\"operation\":\"DELETE\",\"resource_path\":\"/other\","
+    "\"data\":{\"authSubscriptionStaticData\":{}}},{\"operation\":\"CREATE\""
+    ",\"resource_path\":\"/subscribers/1/authSubscription/imsi-1\",\"data\":{"
+    "\"authSubscriptionStaticData\":{\"authenticationMethod\":\"5G_AKA\"}}},"
+    "{\"operation\":\"PATCH\",\"data\":{\"deep\":[[{}]]}},{\"operation\":"
+    "\"CREATE\"}],\"relatedResources\":{\"/legacy/serv=Auth/IMSI=1\":{"
+    "\"KIND\":1}}}",
+    "{\"changes\":{}}",
+    "{\"changes\":[1]}",
+    "{\"changes\":[{\"operation\":1}]}",
+    "{\"changes\":[{\"operation\":\"\"}]}",
+    "{\"changes\":[{\"operation\":\"CREATE\",\"resource_path\":[]}]}",
+    "{\"changes\":[{\"resource_path\":\"\",\"data\":{}}]}",
+    "{\"changes\":[{\"resource_path\":\"/subscribers/1/authSubscription/"
+    "imsi-1\",\"data\":{\"authSubscriptionStaticData\":{\"authenticationMethod"
+    "\":1}}},{\"data\":[{\"a\":[1,{}]}],\"operation\":\"CREATE\"}]}",
+    "{\"changes\":[{\"operation\":\"CREATE\"}",
+    "{}",
+    "{\"relatedResources\":{}}",
+};
+
+// Flattened view of what a parser extracted, the same whether provJournals
+// are owning or borrowed
+class Extraction final {
+ public:
+  Extraction& operator<<(const std::string& field) {
+    os << field << '|';
+    return *this;
+  }
+  Extraction& operator<<(std::string_view field) {
+    return *this << std::string{field};
+  }
+  Extraction& operator<<(const char* field) {
+    return *this << std::string{field};
+  }
+  Extraction& operator<<(int field) { return *this << std::to_string(field); }
+  template <typename T>
+  Extraction& operator<<(const std::optional<T>& field) {
+    if (not field) {
+      return *this << "-";
+    }
+    return *this << *field;
+  }
+  template <typename T>
+  Extraction& operator<<(const std::vector<T>& field) {
+    for (const auto& value : field) {
+      *this << value;
+    }
+    return *this << "]";
+  }
+  Extraction& operator<<(const entities::genericValue_t& value) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    value.Accept(writer);
+    return *this << std::string{buffer.GetString()};
+  }
+  Extraction& operator<<(const entities::auth_subscription_t& authSub) {
+    if (authSub.authSubscriptionStaticData) {
+      const auto& data = *authSub.authSubscriptionStaticData;
+      *this << data.authenticationMethod << data.encPermanentKey
+            << data.authenticationManagementField << data.algorithmId
+            << data.a4KeyInd << data.a4Ind << data.encOpcKey
+            << data.encTopcKey << data.a4KeyV << data.akaAlgorithmInd;
+      for (const auto& [name, value] : data.vendorSpecific) {
+        *this << name << value;
+      }
+    }
+    *this << "/";
+    if (authSub.authSubscriptionDynamicData) {
+      const auto& data = *authSub.authSubscriptionDynamicData;
+      *this << data.sqnScheme << data.sqn;
+      if (data.lastIndexesList) {
+        for (const auto& [name, value] : *data.lastIndexesList) {
+          *this << name << value;
+        }
+      }
+    }
+    return *this;
+  }
+  Extraction& operator<<(const entities::auth_subscription_legacy_t& legacy) {
+    return *this << legacy.fSetInd << legacy.eki << legacy.kind
+                 << legacy.a4Ind << legacy.amfValue << legacy.eopc
+                 << legacy.seqHe << legacy.akaType << legacy.vNumber
+                 << legacy.akaAlgInd;
+  }
+  template <typename Journal>
+  Extraction& journal(const Journal& journal) {
+    *this << journal.notifRef << journal.imsi << journal.imsiMask
+          << journal.imsiExtMask << journal.msisdn << journal.msisdnMask
+          << journal.msisdnExtMask << journal.imsiAux << journal.imsiAuxMask
+          << journal.imsiAuxExtMask << journal.impi << journal.impiMask
+          << journal.impiExtMask << journal.secImpi << journal.impiAux
+          << journal.username << journal.usernameMask
+          << journal.usernameExtMask << journal.imsiExpiryDate
+          << journal.imsiChoExec << journal.impuChoIds << journal.mscIdAux
+          << journal.notifInfo << journal.ueFunctionMask << journal.extIdList
+          << journal.nai << journal.naiMask << journal.naiExtMask;
+    if (journal.imsiChoStatus) {
+      *this << journal.imsiChoStatus;
+    }
+    for (const auto& subsId : journal.subsIdList) {
+      *this << subsId.id << subsId.prefix;
+    }
+    return *this;
+  }
+  Extraction& operator<<(const entities::prov_journal_t& journal) {
+    return this->journal(journal);
+  }
+  Extraction& operator<<(const entities::prov_journal_view_t& journal) {
+    return this->journal(journal);
+  }
+  Extraction& operator<<(const entities::ValidationData& data) {
+    for (const auto& change : data.changes) {
+      *this << change.operation << change.resourcePath
+            << change.authSubscription << "\n";
+    }
+    for (const auto& [path, resource] : data.relatedResources) {
+      *this << path;
+      std::visit([this](const auto& value) { *this << value; }, resource);
+      *this << "\n";
+    }
+    for (const auto& error : data.response.errors) {
+      *this << error.message << entities::errorDescription(error)
+            << error.resourcePath;
+      *this << "\n";
+    }
+    return *this;
+  }
+  std::string str() const { return os.str(); }
+
+ private:
+  std::ostringstream os;
+};
+
+template <typename Parser, typename Body>
+std::string extract(Body&& body) {
+  Parser parser(std::forward<Body>(body));
+  entities::ValidationData data;
+  Extraction extraction;
+  extraction << (parser.getValidationData(data) ? "ok" : "ko")
+             << parser.errorString() << data;
+  return extraction.str();
+}
+
+}  // namespace
+
+TEST(ValidatorRapidJsonSaxParserTest, ExtractsAsTheDomParser) {
+  for (const auto& body : CORPUS) {
+    EXPECT_EQ(extract<ValidatorRapidJsonSaxParser>(body),
+              extract<ValidatorRapidJsonParser>(body))
+        << body;
+    EXPECT_EQ(extract<ValidatorRapidJsonSaxParser>(std::string{body}),
+              extract<ValidatorRapidJsonParser>(std::string{body}))
+        << body;
+  }
+}
+
+// Errors are raised while the parser reads each change into the same
+// scratch one, so they must keep the path of their own change
+TEST(ValidatorRapidJsonSaxParserTest, ParseErrorsKeepThePathOfTheirChange) {
+  const std::string first{
+      "/subscribers/123abc/authSubscription/imsi-123456789012345/"
+      "authSubscriptionStaticData"};
+  const std::string second{
+      "/subscribers/123abc/authSubscription/imsi-543210987654321/"
+      "authSubscriptionStaticData"};
+  auto change = [](const std::string& path) {
+    return "{\"operation\":\"CREATE\",\"resource_path\":\"" + path +
+           "\",\"data\":{\"authenticationMethod\":1234}}";
+  };
+  const auto body =
+      "{\"changes\":[" + change(first) + "," + change(second) + "]}";
+
+  ValidatorRapidJsonSaxParser sax(body);
+  ValidatorRapidJsonParser dom(body);
+  entities::ValidationData saxRecord;
+  entities::ValidationData domRecord;
+  sax.getValidationData(saxRecord);
+  dom.getValidationData(domRecord);
+  for (const auto* record : {&saxRecord, &domRecord}) {
+    const auto& errors = record->response.errors;
+    ASSERT_EQ(errors.size(), 2);
+    EXPECT_EQ(errors[0].resourcePath, first);
+    EXPECT_EQ(errors[1].resourcePath, second);
+  }
+}
+
+TEST(ValidatorRapidJsonSaxParserTest, ParseInArenaBorrowsFromBody) {
+  std::string jsonString(
+      "{\"relatedResources\":{\"/subscribers/3319b/journal/"
+      "provJournal\":{\"imsi\":\"IMSI1\",\"impuChoIds\":[\"impuchoid1\"]}}}");
+  entities::RequestArena arena;
+
+  ValidatorRapidJsonSaxParser parser(std::move(jsonString), arena);
+  EXPECT_EQ(parser.error(), false);
+  entities::ValidationData record;
+  EXPECT_EQ(parser.getValidationData(record), true);
+
+  const auto& journal = std::get<entities::prov_journal_view_t>(
+      record.relatedResources.at("/subscribers/3319b/journal/provJournal"));
+  EXPECT_EQ(journal.imsi, "IMSI1");
+  EXPECT_EQ(journal.impuChoIds.size(), 1);
+}
+
+TEST(ValidatorRapidJsonSaxParserTest, WrongJsonFormat) {
+  ValidatorRapidJsonSaxParser parser(std::string{"{\"changes\":[}"});
+
+  entities::ValidationData record;
+  EXPECT_EQ(parser.error(), true);
+  EXPECT_EQ(parser.getValidationData(record), false);
+  EXPECT_EQ(parser.errorString(), "wrong json format");
+  EXPECT_EQ(record.changes.size(), 0);
+}
@@ -0,0 +1,84 @@
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ports/server/ResponseValidationPolicy.hpp"
+
+using ::port::primary::ResponseValidationPolicy;
+
+TEST(ResponseValidationPolicyTest, ModesAreParsed) {
+  EXPECT_EQ(ResponseValidationPolicy::toMode("always"),
+            ResponseValidationPolicy::Mode::ALWAYS);
+  EXPECT_EQ(ResponseValidationPolicy::toMode("sampled"),
+            ResponseValidationPolicy::Mode::SAMPLED);
+  EXPECT_EQ(ResponseValidationPolicy::toMode("off"),
+            ResponseValidationPolicy::Mode::OFF);
+  EXPECT_EQ(ResponseValidationPolicy::toMode("Sampled"),
+            ResponseValidationPolicy::Mode::ALWAYS);
+  EXPECT_EQ(ResponseValidationPolicy::toMode(""),
+            ResponseValidationPolicy::Mode::ALWAYS);
+}
+
+TEST(ResponseValidationPolicyTest, AlwaysValidatesAndEnforces) {
+  ResponseValidationPolicy policy;
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(policy.shouldValidate());
+  }
+  EXPECT_TRUE(policy.isEnforced());
+  EXPECT_EQ(policy.validated(), 10);
+  EXPECT_EQ(policy.skipped(), 0);
+
+  policy.recordFailure();
+  EXPECT_EQ(policy.failures(), 1);
+  EXPECT_EQ(policy.sampledFailures(), 0);
+}
+
+TEST(ResponseValidationPolicyTest, OffNeverValidates) {
+  ResponseValidationPolicy policy("off", 1);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(policy.shouldValidate());
+  }
+  EXPECT_EQ(policy.validated(), 0);
+  EXPECT_EQ(policy.skipped(), 10);
+}
+
+TEST(ResponseValidationPolicyTest, SampledValidatesOneEveryN) {
+  ResponseValidationPolicy policy("sampled", 4);
+  EXPECT_FALSE(policy.isEnforced());
+  std::vector<bool> decisions;
+  for (int i = 0; i < 8; ++i) {
+    decisions.push_back(policy.shouldValidate());
+  }
+  EXPECT_EQ(decisions, (std::vector<bool>{true, false, false, false, true,
+                                          false, false, false}));
+  EXPECT_EQ(policy.validated(), 2);
+  EXPECT_EQ(policy.skipped(), 6);
+
+  policy.recordFailure();
+  EXPECT_EQ(policy.failures(), 1);
+  EXPECT_EQ(policy.sampledFailures(), 1);
+}
+
+TEST(ResponseValidationPolicyTest, SampledRateIsKeptAcrossThreads) {
+  ResponseValidationPolicy policy(ResponseValidationPolicy::Mode::SAMPLED, 10);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&policy]() {
+      for (int i = 0; i < 1000; ++i) {
+        policy.shouldValidate();
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(policy.validated(), 400);
+  EXPECT_EQ(policy.skipped(), 3600);
+}
+
+TEST(ResponseValidationPolicyTest, ZeroSampleRateValidatesEveryResponse) {
+  ResponseValidationPolicy policy("sampled", 0);
+  EXPECT_EQ(policy.getSampleRate(), 1);
+  EXPECT_TRUE(policy.shouldValidate());
+  EXPECT_TRUE(policy.shouldValidate());
+}
@@ -1,3 +1,6 @@
+#include <future>
+
+#include "entities/ErrorText.hpp"
 #include "entities/ValidationData.hpp"
 #include "gtest/gtest.h"
 #include "ports/HTTPcodes.hpp"
@@ -213,7 +216,7 @@ TEST(ValidationDataTest,
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
   EXPECT_EQ(
-      record.response.errors[0].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[0]),
       "\"authenticationMethod\" in \"authSubscriptionStaticData\" has not the "
       "valid format");
 }
@@ -241,47 +244,47 @@ TEST(ValidationDataTest,
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 5);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"encPermanentKey\" in \"authSubscriptionStaticData\" has not "
             "been defined "
             "with an AKA authentication method");
 
-  EXPECT_EQ(record.response.errors[1].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[1].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[1].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[1]),
             "\"authenticationManagementField\" in "
             "\"authSubscriptionStaticData\" has not "
             "been defined with an AKA authentication method");
 
-  EXPECT_EQ(record.response.errors[2].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[2].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[2].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[2].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[2].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[2]),
             "\"algorithmId\" in \"authSubscriptionStaticData\" has not been "
             "defined with "
             "an AKA authentication method");
 
-  EXPECT_EQ(record.response.errors[3].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[3].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[3].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[3]),
             "\"a4KeyInd\" in \"authSubscriptionStaticData\" has not been "
             "defined with an "
             "AKA authentication method");
 
-  EXPECT_EQ(record.response.errors[4].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[4].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[4].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[4]),
             "\"a4Ind\" in \"authSubscriptionStaticData\" has not been defined "
             "with an "
             "AKA authentication method");
@@ -321,12 +324,12 @@ TEST(ValidationDataTest,
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[0].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[0]),
       "\"authenticationManagementField\" in \"authSubscriptionStaticData\" has "
       "invalid value");
 }
@@ -378,65 +381,65 @@ TEST(ValidationDataTest,
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 8);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"encPermanentKey\" in \"authSubscriptionStaticData\" has "
             "invalid value");
 
-  EXPECT_EQ(record.response.errors[1].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[1].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[1].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[1].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[1]),
       "\"authenticationManagementField\" in \"authSubscriptionStaticData\" has "
       "invalid value");
 
-  EXPECT_EQ(record.response.errors[2].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[2].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[2].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[2].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[2].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[2]),
       "\"algorithmId\" in \"authSubscriptionStaticData\" has invalid value");
 
-  EXPECT_EQ(record.response.errors[3].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[3].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[3].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[3]),
             "\"a4KeyInd\" in \"authSubscriptionStaticData\" has invalid value");
 
-  EXPECT_EQ(record.response.errors[4].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[4].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[4].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[4]),
             "\"a4Ind\" in \"authSubscriptionStaticData\" has invalid value");
 
-  EXPECT_EQ(record.response.errors[5].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[5].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[5].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[5].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[5].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[5]),
       "\"encOpcKey\" in \"authSubscriptionStaticData\" has invalid value");
 
-  EXPECT_EQ(record.response.errors[6].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[6].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[6].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[6].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[6].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[6]),
             "\"a4KeyV\" in \"authSubscriptionStaticData\" has invalid value");
 
-  EXPECT_EQ(record.response.errors[7].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[7].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[7].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[7].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[7].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[7]),
             "\"akaAlgorithmInd\" in \"authSubscriptionStaticData\" has invalid "
             "value");
 }
@@ -508,11 +511,11 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionWithA4IndNotAnInteger) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"a4Ind\" in \"authSubscriptionStaticData\" has invalid value");
 }
 
@@ -548,11 +551,11 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionWithA4KeyIndNotAnInteger) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"a4KeyInd\" in \"authSubscriptionStaticData\" has invalid value");
 }
 
@@ -588,12 +591,12 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionWithAlgorithmIdBelowRange) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[0].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[0]),
       "\"algorithmId\" in \"authSubscriptionStaticData\" has invalid value");
 }
 
@@ -629,19 +632,19 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionWithAlgorithmIdAboveRange) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 2);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[0].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[0]),
       "\"algorithmId\" in \"authSubscriptionStaticData\" has invalid value");
 
-  EXPECT_EQ(record.response.errors[1].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[1].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[1].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[1]),
             "\"encOpcKey\" in \"authSubscriptionStaticData\" must not be "
             "present as \"algorithmId\" is not MILLENAGE (0,2-15)");
 }
@@ -678,12 +681,12 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionWithAlgorithmIdNotAnInteger) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[0].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[0]),
       "\"algorithmId\" in \"authSubscriptionStaticData\" has invalid value");
 }
 
@@ -720,12 +723,12 @@ TEST(ValidationDataTest,
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[0].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[0]),
       "\"encPermanentKey\" in \"authSubscriptionStaticData\" has invalid size");
 }
 
@@ -762,11 +765,11 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionWithA4KeyVBelowRange) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"a4KeyV\" in \"authSubscriptionStaticData\" has invalid value");
 }
 
@@ -803,11 +806,11 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionWithA4KeyVAboveRange) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"a4KeyV\" in \"authSubscriptionStaticData\" has invalid value");
 }
 
@@ -851,11 +854,11 @@ TEST(ValidationDataTest,
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"akaAlgorithmInd\" in \"authSubscriptionStaticData\" has invalid "
             "value");
 }
@@ -900,11 +903,11 @@ TEST(ValidationDataTest,
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"akaAlgorithmInd\" in \"authSubscriptionStaticData\" has invalid "
             "value");
 }
@@ -945,11 +948,11 @@ TEST(ValidationDataTest,
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Unprocessable entity");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Unprocessable entity");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "provJournal for subscriber mscId=123abc not included. Needed to "
             "check if user is defined in AuC when attribute "
             "\"akaAlgorithmInd\" is present");
@@ -996,11 +999,52 @@ TEST(ValidationDataTest,
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
+            "It is not allowed to create or update a subscriber with "
+            "\"akaAlgorithmInd\" "
+            "in \"authSubscriptionStaticData\" if not defined in AuC");
+}
+
+TEST(ValidationDataTest, ValidateAuthSubscriptionWithBorrowedProvJournal) {
+  entities::ValidationData record;
+
+  entities::Change change;
+  change.operation = "CREATE";
+  change.resourcePath =
+      "/subscribers/123abc/authSubscription/imsi-123456789012345/"
+      "authSubscriptionStaticData";
+
+  entities::auth_subscription_static_data_t authSubscriptionStaticData;
+
+  authSubscriptionStaticData.authenticationMethod = JSON_5G_AKA;
+  authSubscriptionStaticData.encPermanentKey.emplace(
+      "2200AA34D40C090D6D4C3B7763854AFB");
+  authSubscriptionStaticData.authenticationManagementField.emplace("B9B9");
+  authSubscriptionStaticData.algorithmId.emplace("15");
+  authSubscriptionStaticData.a4KeyInd.emplace("1");
+  authSubscriptionStaticData.a4Ind.emplace("2");
+  authSubscriptionStaticData.akaAlgorithmInd.emplace("0");
+
+  change.authSubscription.authSubscriptionStaticData.emplace(
+      authSubscriptionStaticData);
+  record.changes.push_back(change);
+
+  std::string body{"0b0000000000101000"};
+  entities::prov_journal_view_t journal;
+  journal.imsiMask = body;
+  record.relatedResources.insert(
+      {"/subscribers/123abc/journal/provJournal", journal});
+
+  entities::validation_response_t resp = record.applyValidationRules();
+
+  EXPECT_EQ(std::get<entities::VALIDATION>(resp), false);
+  EXPECT_EQ(std::get<entities::CODE>(resp), ::port::HTTP_CONFLICT);
+  EXPECT_EQ(record.response.errors.size(), 1);
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "It is not allowed to create or update a subscriber with "
             "\"akaAlgorithmInd\" "
             "in \"authSubscriptionStaticData\" if not defined in AuC");
@@ -1038,11 +1082,11 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionUpdateNoRelatedResource) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Unprocessable entity");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Unprocessable entity");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "There is no associated relatedResource: "
             "/subscribers/123abc/authSubscription/imsi-123456789012345");
 }
@@ -1095,50 +1139,50 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionCheckNoModifiableAttributes) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 6);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"encPermanentKey\" in \"authSubscriptionStaticData\" cannot be "
             "modified");
 
-  EXPECT_EQ(record.response.errors[1].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[1].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[1].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[1].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[1]),
       "\"algorithmId\" in \"authSubscriptionStaticData\" cannot be modified");
 
-  EXPECT_EQ(record.response.errors[2].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[2].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[2].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[2].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[2].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[2]),
       "\"a4KeyInd\" in \"authSubscriptionStaticData\" cannot be modified");
 
-  EXPECT_EQ(record.response.errors[3].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[3].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[3].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[3]),
             "\"a4Ind\" in \"authSubscriptionStaticData\" cannot be modified");
 
-  EXPECT_EQ(record.response.errors[4].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[4].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[4].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[4].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[4]),
       "\"encOpcKey\" in \"authSubscriptionStaticData\" cannot be modified");
 
-  EXPECT_EQ(record.response.errors[5].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[5].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[5].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[5].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[5].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[5]),
             "\"a4KeyV\" in \"authSubscriptionStaticData\" cannot be modified");
 }
 
@@ -1201,11 +1245,11 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionCheckDynamicDataNotCreated) {
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionDynamicData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"authSubscriptionDynamicData\" can not be created or updated");
 }
 
@@ -1268,11 +1312,11 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionCheckDynamicDataNotUpdated) {
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionDynamicData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"authSubscriptionDynamicData\" can not be created or updated");
 }
 
@@ -1522,60 +1566,60 @@ TEST(ValidationDataTest, ValidateLegacyAuthSubscriptionWrong) {
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 7);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"encPermanentKey\" is not equal to \"EKI\" attribute of 4G "
             "legacy subscription");
 
-  EXPECT_EQ(record.response.errors[1].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[1].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[1].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[1]),
             "\"a4KeyInd\" is not equal to \"KIND\" attribute of 4G legacy "
             "subscription");
 
-  EXPECT_EQ(record.response.errors[2].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[2].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[2].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[2].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[2].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[2]),
             "\"a4Ind\" is not equal to \"A4IND\" attribute of 4G legacy "
             "subscription");
 
-  EXPECT_EQ(record.response.errors[3].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[3].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[3].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
   EXPECT_EQ(
-      record.response.errors[3].errorDetails.at("description"),
+      entities::errorDescription(record.response.errors[3]),
       "\"algorithmId\" is not equal to \"FSETIND\" attribute of 4G legacy "
       "subscription");
 
-  EXPECT_EQ(record.response.errors[4].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[4].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[4].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[4]),
             "\"authenticationManagementField\" is not equal to \"AMFVALUE\" "
             "attribute of 4G legacy subscription");
 
-  EXPECT_EQ(record.response.errors[5].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[5].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[5].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[5].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[5].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[5]),
             "\"encOpcKey\" is not equal to \"EOPC\" attribute of 4G legacy "
             "subscription");
 
-  EXPECT_EQ(record.response.errors[6].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[6].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[6].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[6].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[6].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[6]),
             "\"akaAlgorithmInd\" is not equal to \"AKAALGIND\" attribute of 4G "
             "legacy "
             "subscription");
@@ -1619,11 +1663,11 @@ TEST(ValidationDataTest, ValidateLegacyAuthSubscriptionAkaTypeNotDefined) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"AKATYPE\" for 4G legacy subscription is not defined");
 }
 
@@ -1657,11 +1701,11 @@ TEST(ValidationDataTest, ValidateLegacyAuthSubscriptionAkaTypeInvalidValue) {
 
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "\"AKATYPE\" for 4G legacy subscription has an invalid value");
 }
 
@@ -1799,11 +1843,11 @@ TEST(ValidationDataTest, ValidateAuthSubscriptionFirstChangeIsWrongSecondIsOk) {
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 1);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Unprocessable entity");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Unprocessable entity");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012377/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "There is no associated relatedResource: "
             "/subscribers/123abc/authSubscription/imsi-123456789012377");
 }
@@ -1850,19 +1894,19 @@ TEST(ValidationDataTest,
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 2);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Unprocessable entity");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Unprocessable entity");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012377/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "There is no associated relatedResource: "
             "/subscribers/123abc/authSubscription/imsi-123456789012377");
 
-  EXPECT_EQ(record.response.errors[1].errorMessage, "Unprocessable entity");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[1].message, "Unprocessable entity");
+  EXPECT_EQ(record.response.errors[1].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[1]),
             "There is no associated relatedResource: "
             "/subscribers/123abc/authSubscription/imsi-123456789012345");
 }
@@ -1901,56 +1945,225 @@ TEST(ValidationDataTest,
   EXPECT_EQ(record.response.changes.size(), 0);
   EXPECT_EQ(record.response.errors.size(), 6);
 
-  EXPECT_EQ(record.response.errors[0].errorMessage, "Unprocessable entity");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[0].message, "Unprocessable entity");
+  EXPECT_EQ(record.response.errors[0].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012377/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[0].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[0]),
             "There is no associated relatedResource: "
             "/subscribers/123abc/authSubscription/imsi-123456789012377");
 
-  EXPECT_EQ(record.response.errors[1].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[1].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[1].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[1].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[1]),
             "\"encPermanentKey\" in \"authSubscriptionStaticData\" has not "
             "been defined "
             "with an AKA authentication method");
 
-  EXPECT_EQ(record.response.errors[2].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[2].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[2].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[2].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[2].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[2]),
             "\"authenticationManagementField\" in "
             "\"authSubscriptionStaticData\" has not "
             "been defined with an AKA authentication method");
 
-  EXPECT_EQ(record.response.errors[3].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[3].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[3].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[3].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[3]),
             "\"algorithmId\" in \"authSubscriptionStaticData\" has not been "
             "defined with "
             "an AKA authentication method");
 
-  EXPECT_EQ(record.response.errors[4].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[4].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[4].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[4].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[4]),
             "\"a4KeyInd\" in \"authSubscriptionStaticData\" has not been "
             "defined with an "
             "AKA authentication method");
 
-  EXPECT_EQ(record.response.errors[5].errorMessage, "Constraint Violation");
-  EXPECT_EQ(record.response.errors[5].errorDetails.at("resource_path"),
+  EXPECT_EQ(record.response.errors[5].message, "Constraint Violation");
+  EXPECT_EQ(record.response.errors[5].resourcePath,
             "/subscribers/123abc/authSubscription/imsi-123456789012345/"
             "authSubscriptionStaticData");
-  EXPECT_EQ(record.response.errors[5].errorDetails.at("description"),
+  EXPECT_EQ(entities::errorDescription(record.response.errors[5]),
             "\"a4Ind\" in \"authSubscriptionStaticData\" has not been defined "
             "with an "
             "AKA authentication method");
 }
+
+namespace {
+
+constexpr auto STATIC_DATA_PATH_PREFIX = "/subscribers/123abc/authSubscription/";
+
+entities::Change staticDataChange(const std::string &operation,
+                                  const std::string &imsi,
+                                  const std::string &encPermanentKey) {
+  entities::Change change;
+  change.operation = operation;
+  change.resourcePath = std::string{STATIC_DATA_PATH_PREFIX} + "imsi-" + imsi +
+                        "/authSubscriptionStaticData";
+  entities::auth_subscription_static_data_t staticData;
+  staticData.authenticationMethod = JSON_5G_AKA;
+  if (not encPermanentKey.empty()) {
+    staticData.encPermanentKey.emplace(encPermanentKey);
+  }
+  staticData.authenticationManagementField.emplace("B9B9");
+  staticData.algorithmId.emplace("15");
+  staticData.a4KeyInd.emplace("1");
+  staticData.a4Ind.emplace("2");
+  change.authSubscription.authSubscriptionStaticData.emplace(staticData);
+  return change;
+}
+
+entities::Change pathChange(const std::string &operation,
+                            const std::string &path) {
+  entities::Change change;
+  change.operation = operation;
+  change.resourcePath = path;
+  return change;
+}
+
+// One change of every branch of the rules. The legacy subscription of
+// 100000000000002 has no AKATYPE: its legacy rules fail, but only when no
+// change before it had errors
+std::vector<entities::Change> changeKinds() {
+  return {
+      staticDataChange("CREATE", "100000000000001",
+                       "2200AA34D40C090D6D4C3B7763854AFB"),
+      staticDataChange("CREATE", "100000000000001", "XX"),
+      staticDataChange("CREATE", "100000000000002", ""),
+      staticDataChange("CREATE", "100000000000003", ""),
+      staticDataChange("UPDATE", "100000000000004",
+                       "2200AA34D40C090D6D4C3B7763854AFB"),
+      pathChange("DELETE", std::string{STATIC_DATA_PATH_PREFIX} +
+                               "imsi-100000000000001/authSubscriptionStaticData"),
+      pathChange("DELETE", "/subscribers/123abc/authSubscription"),
+      pathChange("CREATE", "/subscribers/123abc/authSubscription/imsi-12/"
+                           "authSubscriptionStaticData"),
+      pathChange("CREATE", std::string{STATIC_DATA_PATH_PREFIX} +
+                               "imsi-100000000000001/"
+                               "authSubscriptionDynamicData"),
+      pathChange("CREATE", "/subscribers/123abc/other"),
+      pathChange("DELETE", "/subscribers/123abc/other"),
+  };
+}
+
+entities::related_resources_t relatedResources() {
+  entities::ProvJournal journal;
+  journal.imsiMask = "0b0000000000010000";
+  entities::auth_subscription_legacy_t noAkaType;
+  entities::auth_subscription_legacy_t legacy;
+  legacy.akaType.emplace(1);
+  legacy.eki.emplace("2200AA34D40C090D6D4C3B7763854AFB");
+  legacy.seqHe.emplace("0123456789AB");
+  return {{"/subscribers/123abc/journal/provJournal", journal},
+          {"/legacy/serv=Auth/IMSI=100000000000002", noAkaType},
+          {"/legacy/serv=Auth/IMSI=100000000000003", legacy}};
+}
+
+std::string describe(const entities::ValidationData &record,
+                     const entities::validation_response_t &resp) {
+  std::string text = std::to_string(std::get<entities::VALIDATION>(resp)) +
+                     " " + std::to_string(std::get<entities::CODE>(resp));
+  for (const auto &error : record.response.errors) {
+    text += "\nerror " + std::string{error.message} +
+            " description=" + entities::errorDescription(error);
+    if (not error.resourcePath.empty()) {
+      text += " resource_path=" + error.resourcePath;
+    }
+  }
+  for (const auto &change : record.response.changes) {
+    text += "\nchange " + change.operation + " " + change.resourcePath;
+    const auto &auth = change.authSubscription;
+    if (auth.authSubscriptionStaticData and
+        auth.authSubscriptionStaticData->encPermanentKey) {
+      text += " " + *auth.authSubscriptionStaticData->encPermanentKey;
+    }
+    if (auth.authSubscriptionDynamicData) {
+      text += " " + auth.authSubscriptionDynamicData->sqnScheme.value_or("") +
+              " " + auth.authSubscriptionDynamicData->sqn.value_or("");
+    }
+  }
+  return text;
+}
+
+}  // namespace
+
+TEST(ValidationDataTest, ParallelRulesGiveTheSequentialResult) {
+  auto kinds = changeKinds();
+  entities::WorkerPool workers{3, 64};
+  unsigned int seed = 7;
+  for (int request = 0; request < 300; ++request) {
+    entities::ValidationData sequential;
+    sequential.relatedResources = relatedResources();
+    seed = seed * 1103515245 + 12345;
+    auto size = (seed >> 16) % 24;
+    for (unsigned int i = 0; i < size; ++i) {
+      seed = seed * 1103515245 + 12345;
+      sequential.changes.push_back(kinds[(seed >> 16) % kinds.size()]);
+    }
+    entities::ValidationData parallel = sequential;
+
+    auto sequentialResp = sequential.applyValidationRules();
+    auto parallelResp = parallel.applyValidationRules(workers, 1);
+    EXPECT_EQ(describe(parallel, parallelResp),
+              describe(sequential, sequentialResp))
+        << "request " << request;
+  }
+}
+
+TEST(ValidationDataTest, ParallelRulesKeepCodePrecedence) {
+  auto kinds = changeKinds();
+  entities::WorkerPool workers{2, 16};
+  entities::ValidationData record;
+  record.relatedResources = relatedResources();
+  // 200, 409 (invalid IMSI), 200, 422 (unknown path), 409 (dynamic data)
+  record.changes = {kinds[0], kinds[7], kinds[0], kinds[9], kinds[8]};
+
+  auto resp = record.applyValidationRules(workers, 2);
+
+  EXPECT_FALSE(std::get<entities::VALIDATION>(resp));
+  EXPECT_EQ(std::get<entities::CODE>(resp), ::port::HTTP_UNPROCESSABLE_ENTITY);
+  ASSERT_EQ(record.response.errors.size(), 3);
+  EXPECT_EQ(record.response.errors[1].message, "Unprocessable entity");
+  ASSERT_EQ(record.response.changes.size(), 1);
+  EXPECT_EQ(record.response.changes[0].authSubscription
+                .authSubscriptionDynamicData->sqn,
+            entities::SQN_MUTATION_VALUE);
+}
+
+TEST(ValidationDataTest, SequentialRulesOfBulkWorkArePreempted) {
+  auto kinds = changeKinds();
+  entities::ValidationData record;
+  record.relatedResources = relatedResources();
+  record.changes = {kinds[0], kinds[4]};
+  bool validating = false;
+  bool preempted = false;
+  std::promise<void> finished;
+  {
+    entities::WorkerPool workers{1, 8};
+    EXPECT_TRUE(workers.submit(
+        [&]() {
+          // The only worker runs this task, so the interactive one waits for
+          // it unless it is preempted
+          workers.submit([&]() { preempted = validating; });
+          validating = true;
+          // Too few changes to be spread over the workers
+          record.applyValidationRules(workers, record.changes.size() + 1);
+          validating = false;
+          finished.set_value();
+        },
+        entities::Priority::BULK));
+    finished.get_future().wait();
+    workers.stop();
+  }
+  EXPECT_TRUE(preempted);
+}
@@ -1,8 +1,30 @@
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ports/json/JsonBatch.hpp"
+#include "ports/oaivalidator/OaiValidator.hpp"
 #include "ports/ports.hpp"
 #include "ports/server/ValidatorHttp2AsyncServer.hpp"
 
+namespace {
+
+std::string sourcePath(const std::string &path) {
+  return std::string{AUTHPROVVALIDATOR_SOURCE_DIR} + "/" + path;
+}
+
+std::string readFile(const std::string &path) {
+  std::ifstream file{path};
+  std::ostringstream text;
+  text << file.rdbuf();
+  return text.str();
+}
+
+}  // namespace
+
 class ValidatorHttp2ServerTest : public ::testing::Test {
  protected:
   virtual void SetUp() {}
@@ -23,3 +45,59 @@ TEST_F(
   EXPECT_EQ(server.get()->start("-1"), 1);
   server.get()->stop();
 }
+
+TEST_F(ValidatorHttp2ServerTest,
+       GivenAValidatorHttp2AsyncServerWithWorkersWhenStoppedThenNoErrorOccurs) {
+  port::primary::ServerSettings settings;
+  settings.workerThreads = 4;
+  settings.workerQueueSize = 16;
+  auto server =
+      std::make_unique<port::primary::ValidatorHttp2AsyncServer>(settings);
+  EXPECT_NE(nullptr, server);
+  server.get()->stop();
+  server.get()->stop();
+}
+
+TEST_F(ValidatorHttp2ServerTest,
+       GivenAPriorityHeaderValueWhenReadThenUnknownOnesFallBackToTheDefault) {
+  using ::entities::Priority;
+  using ::port::primary::toPriority;
+  EXPECT_EQ(toPriority("bulk", Priority::INTERACTIVE), Priority::BULK);
+  EXPECT_EQ(toPriority("interactive", Priority::BULK), Priority::INTERACTIVE);
+  EXPECT_EQ(toPriority("urgent", Priority::BULK), Priority::BULK);
+  EXPECT_EQ(toPriority("", Priority::INTERACTIVE), Priority::INTERACTIVE);
+}
+
+TEST_F(ValidatorHttp2ServerTest,
+       GivenAnNdjsonBatchWhenSplitThenItsItemsPassTheOpenApiValidation) {
+  namespace json = ::port::secondary::json;
+  // One document per line, as the file holds it
+  auto document = readFile(sourcePath("scripts/perf/authprovdata.json"));
+  ASSERT_FALSE(document.empty());
+  httpinfo::Info batch;
+  batch.json = document + document;
+  batch.uri = "/validation/v1/validate/validate/batch";
+  batch.method = "POST";
+  batch.headers.emplace("content-type", port::primary::CONTENT_TYPE_NDJSON);
+  batch.headers.emplace("content-length", std::to_string(batch.json.size()));
+  batch.headers.emplace(port::primary::PRIORITY_HEADER, "bulk");
+
+  json::BatchFormat format;
+  std::vector<std::string_view> items;
+  ASSERT_TRUE(json::splitBatch(batch.json, format, items));
+  EXPECT_EQ(format, json::BatchFormat::NDJSON);
+  ASSERT_EQ(items.size(), 2);
+
+  port::secondary::OaiValidator validator{
+      sourcePath("schema/authprovvalidator.yaml")};
+  for (auto item : items) {
+    auto info = port::primary::batchItemInfo(batch, item);
+    EXPECT_EQ(info.uri, "/validation/v1/validate/validate");
+    EXPECT_EQ(info.headers.count("content-length"), 0);
+    ASSERT_EQ(info.headers.count("content-type"), 1);
+    EXPECT_EQ(info.headers.find("content-type")->second,
+              port::primary::CONTENT_TYPE_JSON);
+    EXPECT_EQ(info.headers.count(port::primary::PRIORITY_HEADER), 1);
+    EXPECT_FALSE(validator.validateRequest(info).has_value());
+  }
+}